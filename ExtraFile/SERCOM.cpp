@@ -127,7 +127,9 @@ void SERCOM::clearStatusUART()
 bool SERCOM::availableDataUART()
 {
   //RXC : Receive Complete
-  return sercom->USART.INTFLAG.bit.RXC;
+  //With RXC interrupt disabled the receiver is owned by a DMA channel (MK4duo SERIAL_ESP_RX_DMA):
+  //the Uart interrupt, still running for TX and errors, must not steal DATA
+  return sercom->USART.INTFLAG.bit.RXC && sercom->USART.INTENSET.bit.RXC;
 }
 
 bool SERCOM::isUARTError()
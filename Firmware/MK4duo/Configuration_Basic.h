@@ -119,11 +119,17 @@
 
 /**
  * Spend 28 bytes of SRAM to optimize the GCode parser
+ *
+ * FASTER_GCODE_PARAMS sets how many parameters per line get an offset
+ * (1 byte each, 26 by default for all of A-Z). Lines with more
+ * parameters fall back to scanning the text.
  */
 //#define FASTER_GCODE_PARSER
+//#define FASTER_GCODE_PARAMS 26
 
 /**
- * Spend more bytes of SRAM to optimize the GCode execute
+ * G and M codes are always dispatched through a table indexed by code.
+ * This adds M44 to report the codes available and the table size.
  */
 //#define FASTER_GCODE_EXECUTE
 
@@ -166,6 +172,7 @@
  * DELTA          - Rostock, Kossel, RostockMax, Cerberus, etc         *
  * MORGAN_SCARA   - SCARA classic                                      *
  * MAKERARM_SCARA - SCARA Makerfarm                                    *
+ * POLARGRAPH     - Hanging plotter, two cords from two nails          *
  *                                                                     *
  ***********************************************************************/
 #define MECHANISM MECH_CARTESIAN
@@ -178,6 +185,7 @@
 //#define MECHANISM MECH_DELTA
 //#define MECHANISM MECH_MORGAN_SCARA
 //#define MECHANISM MECH_MAKERARM_SCARA
+//#define MECHANISM MECH_POLARGRAPH
 //#define MECHANISM MECH_MUVE3D
 /***********************************************************************/
 
@@ -884,6 +884,99 @@
 /*****************************************************************************************/
 
 
+/*****************************************************************************************
+ ********************************* Cable tension limits **********************************
+ *****************************************************************************************
+ *                                                                                       *
+ * For robots hanging from two cords (Scribit, POLARGRAPH), with A and B the             *
+ * left and right cord lengths and the nail distance set by M665 D (saved in EEPROM,     *
+ * POLARGRAPH_NAIL_DISTANCE by default).                                                 *
+ *                                                                                       *
+ * The tension of the weaker cord, in robot weights, is computed at the start            *
+ * and end of each block. Below CABLE_TENSION_LOW the robot swings easily and            *
+ * the acceleration (M204) and max feedrate (M203) apply as set. Above                   *
+ * CABLE_TENSION_HIGH they are raised by CABLE_ACCELERATION_GAIN and                     *
+ * CABLE_FEEDRATE_GAIN, with a linear ramp in between. So M204 and M203 can be           *
+ * set for the low tension corners without slowing down the whole wall.                  *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define CABLE_TENSION_LIMITS
+#define CABLE_TENSION_LOW         0.25  // Weaker cord tension (robot weights) for the M204/M203 values
+#define CABLE_TENSION_HIGH        0.5   // Weaker cord tension (robot weights) for the full gain
+#define CABLE_ACCELERATION_GAIN   4     // Acceleration factor in the well tensioned region
+#define CABLE_FEEDRATE_GAIN       1.5   // Max feedrate factor in the well tensioned region
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ ************************************* Input shaping *************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Cancel the swing of a hanging or flexible machine at one frequency. The X and Y       *
+ * motors follow the planned motion through a few delayed impulses, so the swing         *
+ * excited by the first one is stopped by the next ones:                                 *
+ *  1 ZV:  2 impulses over half a swing period                                           *
+ *  2 ZVD: 3 impulses over one period, tolerates a wrong frequency                       *
+ *  3 EI:  3 impulses over one period, most tolerant                                     *
+ * Moves take up to one period longer and corners are rounded by about the corner        *
+ * speed times that delay. Z moves wait for X and Y to settle.                           *
+ *                                                                                       *
+ * X and Y are stepped at INPUT_SHAPING_STEP_RATE at most. The last period of            *
+ * motion is kept in 4 * INPUT_SHAPING_STEP_RATE / 32 / INPUT_SHAPING_MIN_FREQ bytes.    *
+ *                                                                                       *
+ * Set with M593 T<type> F<frequency> D<damping>, saved with M500.                       *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define INPUT_SHAPING
+#define INPUT_SHAPING_TYPE        1     // 0 off, 1 ZV, 2 ZVD, 3 EI
+#define INPUT_SHAPING_FREQ        0.5   // (Hz) Swing frequency
+#define INPUT_SHAPING_DAMPING     0.1   // Damping ratio (0 - 0.3)
+#define INPUT_SHAPING_MIN_FREQ    0.4   // (Hz) Lowest frequency for M593
+#define INPUT_SHAPING_STEP_RATE   4000  // (Hz) Shaping tick rate, max X and Y step rate
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ ****************************** Swing resonance measurement ******************************
+ *****************************************************************************************
+ *                                                                                       *
+ * M779 swings the robot with a sideways move and fits the swing recorded by the IMU,    *
+ * reporting the frequency and damping to set with M593.                                 *
+ * The samples take 3.8 KB of RAM, enable it for a calibration build only.               *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define SWING_RESONANCE_MEASUREMENT
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ ********************************** Z motion channel *************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * G0/G1 moves of Z alone (the Scribit pen carousel) and G101 run on their own small     *
+ * queue, stepped on their own time base, instead of between the X/Y blocks.             *
+ *                                                                                       *
+ * A Z move up while the pen is already up (pen selection) starts at once and turns      *
+ * the carousel during the X/Y travel. Pen lift (the first Z move up) and pen down       *
+ * (any Z move down) keep the strict order: they wait for the X/Y moves queued before    *
+ * them and hold the X/Y moves queued after them until they are done.                    *
+ *                                                                                       *
+ * M400 and G4 wait for every queued move, the Z channel included, so the host           *
+ * converter must not put them between the travel and a pen selection move, or the       *
+ * carousel turns only once the travel is over. The shipped jobs wrap every pen move     *
+ * in M400/G4 P50: the converter has to drop them around pen moves. The channel orders   *
+ * pen lift and pen down by itself, a G4 is only needed for a settle time.               *
+ *                                                                                       *
+ * Z is stepped at Z_MOTION_STEP_RATE at most, set it well above the Z step rate         *
+ * of the fastest pen move.                                                              *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define Z_MOTION_CHANNEL
+#define Z_MOTION_BUFFER_SIZE  4     // Z moves queued, power of 2
+#define Z_MOTION_STEP_RATE    5000  // (Hz) Z channel tick rate, max Z step rate
+/*****************************************************************************************/
+
+
 /*****************************************************************************************
  ********************************** Skeinforge arc fix ***********************************
  *****************************************************************************************
@@ -2088,8 +2181,18 @@
  * The algorithm adapts to provide the best possible step smoothing    *
  * at the lowest stepping frequencies.                                 *
  *                                                                     *
+ * Each block is oversampled by the highest power of 2 (128 at most)   *
+ * keeping the Step ISR rate at its nominal speed below                *
+ * ADAPTIVE_STEP_SMOOTHING_FREQ and what the CPU can do: slow blocks   *
+ * get more ISRs, fast blocks none. Lower it if the CPU is short of    *
+ * time.                                                               *
+ *                                                                     *
+ * M781 F<Hz> sets the frequency (F0 for off) and reports the ISR rate,*
+ * the CPU cycles per ISR and the CPU share of the Step ISR.           *
+ *                                                                     *
  ***********************************************************************/
 //#define ADAPTIVE_STEP_SMOOTHING
+#define ADAPTIVE_STEP_SMOOTHING_FREQ 10000  // (Hz)
 /***********************************************************************/
 
 
@@ -2182,11 +2285,62 @@
 // For Arduino DUE setting BLOCK BUFFER SIZE to 32
 #define BLOCK_BUFFER_SIZE 16
 
+// Lean planner block for machines with no laser and a single extruder
+// (no LIN_ADVANCE, BEZIER_JERK_CONTROL, COLOR_MIXING_EXTRUDER, BARICUDA
+// or HYSTERESIS_FEATURE). Step counts and step rates are 16 bit: moves
+// over 65535 steps are queued in parts and step rates are limited to
+// 65535 steps/s. A block takes 48 bytes instead of 80, so the
+// BLOCK_BUFFER_SIZE can be doubled for a deeper lookahead.
+//#define COMPACT_BLOCK_BUFFER
+
+// Integer math for the planner passes and the trapezoid generator, for
+// CPUs without FPU (AVR, SAMD21). Squared speeds are kept in fixed point
+// (1/256 (mm/s)^2) and step rates come from an integer square root.
+// Moves are still planned in float once, when they are queued.
+// Requires COMPACT_BLOCK_BUFFER.
+//#define FIXED_POINT_PLANNER
+
+// Merge runs of short, nearly collinear A/B segments into one block
+// before the planner. A segment is held back until the next one shows
+// whether it continues in line. Z (pen) and E moves, speed changes and
+// segments deviating more than SEGMENT_MERGE_TOLERANCE end the run.
+// The held segment is queued as soon as fewer than
+// SEGMENT_MERGE_MIN_BLOCKS blocks are planned, so the planner never
+// waits for it.
+//#define SEGMENT_MERGE
+#define SEGMENT_MERGE_TOLERANCE 0.02      // (mm) Max distance of a merged joint from the new segment
+#define SEGMENT_MERGE_MAX 8               // Max segments merged into one
+#define SEGMENT_MERGE_MIN_BLOCKS 4        // Queue the held segment when fewer blocks are planned
+
+// Blend the corners between A/B segments with an arc passing within a
+// path tolerance of the corner, set by G64 P<mm>. G64 without P uses
+// PATH_BLENDING_TOLERANCE, G64 P0 goes back to the exact path (default).
+// The arc is split in chords, enough for each junction to be taken near
+// the nominal speed with the current jerk (or junction deviation), up to
+// PATH_BLENDING_SEGMENTS. Gentle turns are left as they are.
+// A segment is held back until the next one shows the corner at its end,
+// and queued as soon as fewer than PATH_BLENDING_MIN_BLOCKS blocks are
+// planned. Not for kinematic machines.
+//#define PATH_BLENDING
+#define PATH_BLENDING_TOLERANCE 0.1       // (mm) Max distance of the blend from the corner, for G64 without P
+#define PATH_BLENDING_SEGMENTS 4          // Max chords of a blend
+#define PATH_BLENDING_MIN_BLOCKS 4        // Queue the held segment when fewer blocks are planned
+
 // The ASCII buffer for receiving from the serial:
 #define MAX_CMD_SIZE 96
 // For Arduino DUE setting to 8
 #define BUFSIZE 4
 
+// Parse commands once when they are queued, into a compact struct
+// (letter, code, parameter bitmask, integer or fixed point values).
+// Commands with string arguments or not fitting the struct are kept
+// as text in a shared ring of COMMAND_TEXT_SIZE bytes.
+// Each queued command takes 12 + 4 * COMMAND_VALUES bytes instead of
+// MAX_CMD_SIZE, so BUFSIZE can be raised in the same RAM.
+//#define COMPACT_COMMAND_QUEUE
+#define COMMAND_VALUES 5          // 1 to 6
+#define COMMAND_TEXT_SIZE 256     // MAX_CMD_SIZE or more
+
 // Transmission to Host Buffer Size
 // To save 386 bytes of PROGMEM (and TX_BUFFER_SIZE+3 bytes of RAM) set to 0.
 // To buffer a simple "ok" you need 4 bytes.
@@ -2226,11 +2380,27 @@
 //
 // Disable this feature to save ~3226 bytes
 #define ARC_SUPPORT
-#define MM_PER_ARC_SEGMENT 1    // Length of each arc segment
+#define MM_PER_ARC_SEGMENT 1    // Length of each arc segment (longest segment with ARC_CHORD_TOLERANCE)
 #define N_ARC_CORRECTION  25    // Number of intertpolated segments between corrections
+// Size the segments from the distance between chord and arc instead,
+// so small radii get short segments and large radii long ones.
+// Fast arcs are limited to ARC_SEGMENTS_PER_SEC, and segments are
+// never shorter than MIN_ARC_SEGMENT_MM.
+// The radius vector is rotated in fixed point between corrections.
+//#define ARC_CHORD_TOLERANCE 0.01  // (mm)
+#define ARC_SEGMENTS_PER_SEC 50
+#define MIN_ARC_SEGMENT_MM 0.1      // (mm)
 //#define ARC_P_CIRCLES         // Enable the 'P' parameter to specify complete circles
 //#define CNC_WORKSPACE_PLANES  // Allow G2/G3 to operate in XY, ZX, or YZ planes
 
+//
+// G5 Cubic Bezier curves
+//
+// Segments are as long as the distance between chord and curve
+// allows, so SVG paths can be sent without flattening them.
+//#define G5_BEZIER
+#define G5_BEZIER_TOLERANCE 0.02  // (mm)
+
 // Moves with fewer segments than this will be ignored and joined with the next movement
 #define MIN_STEPS_PER_SEGMENT 6
 
@@ -2451,6 +2621,18 @@
 /*****************************************************************************************/
 
 
+/*****************************************************************************************
+ ********************************* M778 parser benchmark *********************************
+ *****************************************************************************************
+ *                                                                                       *
+ * M778 prints the CPU cycles per line to parse a set of job lines and read the motion   *
+ * values with strtof, with the fixed point scan and packed (COMPACT_COMMAND_QUEUE).     *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define PARSER_BENCHMARK
+/*****************************************************************************************/
+
+
 /*****************************************************************************************
  *********************************** Debug Feature ***************************************
  *****************************************************************************************
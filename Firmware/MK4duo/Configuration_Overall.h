@@ -49,7 +49,8 @@
 #define NO_TIMEOUTS 1000
 //#define ADVANCED_OK
 //#define EMERGENCY_PARSER
-//#define FASTER_GCODE_PARSER
+#define FASTER_GCODE_PARSER
+#define FASTER_GCODE_PARAMS 8     // Parameter offsets kept per line (1 to 26), longer lines are scanned
 //#define FASTER_GCODE_EXECUTE
 #define HOST_KEEPALIVE_FEATURE
 #define DEFAULT_KEEPALIVE_INTERVAL 2
@@ -64,6 +65,7 @@
 //#define MECHANISM MECH_DELTA
 //#define MECHANISM MECH_MORGAN_SCARA
 //#define MECHANISM MECH_MAKERARM_SCARA
+//#define MECHANISM MECH_POLARGRAPH
 //#define MECHANISM MECH_MUVE3D
 #define POWER_SUPPLY 0
 #define PS_DEFAULT_OFF false
@@ -190,6 +192,10 @@
 #define _CONFIGURATION_CARTESIAN_H_
 #define KNOWN_MECH
 #define CUSTOM_MACHINE_NAME "Scribit"
+#define POLARGRAPH_NAIL_DISTANCE 1860
+#define POLARGRAPH_SEGMENT_TOLERANCE 0.05
+#define POLARGRAPH_MIN_SEGMENT_MM 0.5
+#define POLARGRAPH_MAX_SEGMENT_MM 50
 #define ENDSTOPPULLUP_XMIN true
 #define ENDSTOPPULLUP_YMIN true
 #define ENDSTOPPULLUP_ZMIN true
@@ -501,6 +507,21 @@
 #define INVERT_Z3_VS_Z_DIR false
 //#define Z_THREE_ENDSTOPS
 //#define XY_FREQUENCY_LIMIT  15
+#define CABLE_TENSION_LIMITS
+#define CABLE_TENSION_LOW         0.25
+#define CABLE_TENSION_HIGH        0.5
+#define CABLE_ACCELERATION_GAIN   4
+#define CABLE_FEEDRATE_GAIN       1.5
+#define INPUT_SHAPING
+#define INPUT_SHAPING_TYPE        0     // Off until M779 measures the swing, set it with M593
+#define INPUT_SHAPING_FREQ        0.5
+#define INPUT_SHAPING_DAMPING     0.1
+#define INPUT_SHAPING_MIN_FREQ    0.4
+#define INPUT_SHAPING_STEP_RATE   4000
+//#define SWING_RESONANCE_MEASUREMENT
+#define Z_MOTION_CHANNEL
+#define Z_MOTION_BUFFER_SIZE  4
+#define Z_MOTION_STEP_RATE    5000
 //#define SF_ARC_FIX
 //#define EXTRUDER_ENCODER_CONTROL
 #define ENC_ERROR_STEPS 500
@@ -722,7 +743,8 @@
 #define MINIMUM_STEPPER_PULSE 1
 #define MAXIMUM_STEPPER_RATE 500000
 #define DIRECTION_STEPPER_DELAY 200
-//#define ADAPTIVE_STEP_SMOOTHING
+#define ADAPTIVE_STEP_SMOOTHING
+#define ADAPTIVE_STEP_SMOOTHING_FREQ 8000
 #define X_MICROSTEPS 2
 #define X2_MICROSTEPS 1
 #define Y_MICROSTEPS 2
@@ -754,21 +776,43 @@
 //#define DIGIPOT_I2C
 #define DIGIPOT_I2C_NUM_CHANNELS 8
 #define DIGIPOT_I2C_MOTOR_CURRENTS {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0}
-#define BLOCK_BUFFER_SIZE 32
+#define BLOCK_BUFFER_SIZE 64
+#define COMPACT_BLOCK_BUFFER              // 48 byte planner blocks, 16 bit step counts and rates
+#define FIXED_POINT_PLANNER               // Integer planner passes and trapezoids (SAMD21 has no FPU)
+#define SEGMENT_MERGE                     // Merge collinear segments before the planner
+#define SEGMENT_MERGE_TOLERANCE 0.02      // (mm) Max distance of a merged joint from the new segment
+#define SEGMENT_MERGE_MAX 8               // Max segments merged into one
+#define SEGMENT_MERGE_MIN_BLOCKS 4        // Queue the held segment when fewer blocks are planned
+#define PATH_BLENDING                     // G64 P<mm> corner blending
+#define PATH_BLENDING_TOLERANCE 0.1       // (mm) Max distance of the blend from the corner, for G64 without P
+#define PATH_BLENDING_SEGMENTS 4          // Max chords of a blend
+#define PATH_BLENDING_MIN_BLOCKS 4        // Queue the held segment when fewer blocks are planned
 #define MAX_CMD_SIZE 96
-#define BUFSIZE 16
+#define BUFSIZE 32
+#define COMPACT_COMMAND_QUEUE     // Parse commands when queued, keep as text only the ones needing it
+#define COMMAND_VALUES 5          // Parameter values of a parsed command (1 to 6)
+#define COMMAND_TEXT_SIZE 256     // Bytes for commands kept as text, MAX_CMD_SIZE or more
 #define TX_BUFFER_SIZE 0
 #define RX_BUFFER_SIZE 128
+#define SERIAL_ESP_RX_DMA           // Receive SerialEsp through a DMA circular ring (SAMD21)
+#define SERIAL_ESP_RX_DMA_SIZE 256  // Power of 2, must hold the bytes received between two HAL ticks
+#define SERIAL_ESP_TX_DMA           // Send replies to SerialEsp through a DMA ring, waits only when full (SAMD21)
+#define SERIAL_ESP_TX_DMA_SIZE 256  // Power of 2
 //#define SERIAL_XON_XOFF
 //#define SERIAL_STATS_MAX_RX_QUEUED
 //#define SERIAL_STATS_DROPPED_RX
 #define NUM_POSITON_SLOTS 2
 #define DEFAULT_MIN_SEGMENT_TIME 20000
 #define ARC_SUPPORT
-#define MM_PER_ARC_SEGMENT 1    // Length of each arc segment
+#define MM_PER_ARC_SEGMENT 10   // Length of each arc segment (longest segment with ARC_CHORD_TOLERANCE)
 #define N_ARC_CORRECTION  25    // Number of intertpolated segments between corrections
+#define ARC_CHORD_TOLERANCE 0.02  // (mm)
+#define ARC_SEGMENTS_PER_SEC 50
+#define MIN_ARC_SEGMENT_MM 0.1      // (mm)
 //#define ARC_P_CIRCLES         // Enable the 'P' parameter to specify complete circles
 //#define CNC_WORKSPACE_PLANES  // Allow G2/G3 to operate in XY, ZX, or YZ planes
+#define G5_BEZIER
+#define G5_BEZIER_TOLERANCE 0.02  // (mm)
 #define MIN_STEPS_PER_SEGMENT 6
 //#define M100_FREE_MEMORY_WATCHER
 #define M100_FREE_MEMORY_DUMPER
@@ -812,6 +856,7 @@
 #define JSON_OUTPUT
 //#define SCAD_MESH_OUTPUT
 //#define PINS_DEBUGGING
+//#define PARSER_BENCHMARK                   // M778 prints parser cycles per job line
 //#define DEBUG_FEATURE
 //#define EXTENDED_CAPABILITIES_REPORT
 //#define USE_WATCHDOG
@@ -82,6 +82,8 @@
     #include "Configuration_Delta.h"
   #elif IS_SCARA
     #include "Configuration_Scara.h"
+  #elif MECH(POLARGRAPH)
+    #include "Configuration_Polargraph.h"
   #elif IS_MUVE3D
     #include "Configuration_Muve3D.h"
   #endif
@@ -202,3 +204,4 @@
 
 //Scribit IMU
 #include "SIIMU.h"
+#include "SIDrift.h"
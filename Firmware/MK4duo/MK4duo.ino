@@ -358,6 +358,13 @@ void setup()
   SerialEsp.println();
   //Sync with ESP
   syncWithEsp();
+  //Handshake done, move link to DMA (Keeps Uart interrupt if not available)
+#if ENABLED(SERIAL_ESP_RX_DMA)
+  serialDmaRx.begin(BAUDRATE_1);
+#endif
+#if ENABLED(SERIAL_ESP_TX_DMA)
+  serialDmaTx.begin(BAUDRATE_1);
+#endif
   Serial.begin(9600, SERIAL_8N1);
   SIIMU.init();
   SIIMU.evaluateError();
@@ -0,0 +1,178 @@
+/**
+ * SIDrift.cpp
+ *
+ * Scribit position drift correction from the IMU pitch
+ */
+#include "MK4duo.h"
+
+/**
+ * @brief Pitch of the robot (degrees) hanging from cords of length p_a and p_b
+ *
+ * @return false if the position is not below the nails
+ */
+bool SIDriftClass::predictedPitch(const float p_a, const float p_b, float &p_pitch)
+{
+    const float l_nails = getNailDistance();
+    const float l_x = (sq(p_a) - sq(p_b) + sq(l_nails)) / (2 * l_nails);
+    const float l_y2 = sq(p_a) - sq(l_x);
+
+    if (l_y2 < 1.0f)
+        return false;
+
+    p_pitch = DEGREES(ATAN2(l_nails - 2 * l_x, 2 * SQRT(l_y2)));
+    return true;
+}
+
+void SIDriftClass::update()
+{
+    if (m_mode == DRIFT_OFF || !m_penUp || SIIMU.getStatus() != IMU_SUCCESS)
+        return;
+
+    //Only while travelling
+    if (!planner.has_blocks_queued() || millis() - m_lastSample < SI_DRIFT_SAMPLE_MS)
+        return;
+    m_lastSample = millis();
+
+    //Where the steppers are now
+    const float l_a = planner.get_axis_position_mm(A_AXIS);
+    const float l_b = planner.get_axis_position_mm(B_AXIS);
+    float l_predicted;
+
+    if (!predictedPitch(l_a, l_b, l_predicted))
+        return;
+
+    m_sumA += l_a;
+    m_sumB += l_b;
+    m_sumError += SIIMU.getPitch() - l_predicted;
+    m_samples++;
+}
+
+void SIDriftClass::zMove(const float p_from, const float p_to)
+{
+    if (p_to > p_from)
+    {
+        //Pen up, a new travel starts (Reference of other nails is useless)
+        if (getNailDistance() != m_referenceNails)
+            reset();
+        m_penUp = true;
+        m_samples = 0;
+        m_sumA = m_sumB = m_sumError = 0;
+    }
+    else if (p_to < p_from)
+    {
+        //Pen down, the travel is over with the samples taken so far
+        if (m_penUp && m_mode != DRIFT_OFF)
+            endTravel();
+        m_penUp = false;
+    }
+}
+
+void SIDriftClass::endTravel()
+{
+    if (m_mode == DRIFT_OFF || m_samples < SI_DRIFT_MIN_SAMPLES)
+        return;
+
+    const float l_a = m_sumA / m_samples;
+    const float l_b = m_sumB / m_samples;
+    const float l_error = m_sumError / m_samples;
+
+    //The first travels set the reference
+    if (m_referenceTravels < SI_DRIFT_REFERENCE_TRAVELS)
+    {
+        m_reference = (m_reference * m_referenceTravels + l_error) / (m_referenceTravels + 1);
+        m_referenceTravels++;
+        return;
+    }
+
+    m_lastError = l_error - m_reference;
+    m_lastA = m_lastB = 0;
+
+    //Pitch gradient (degrees per cord mm) where the travel went
+    float l_pitch, l_pitchA, l_pitchB;
+    if (ABS(m_lastError) > SI_DRIFT_DEADBAND_DEG &&
+        predictedPitch(l_a, l_b, l_pitch) && predictedPitch(l_a + 1, l_b, l_pitchA) && predictedPitch(l_a, l_b + 1, l_pitchB))
+    {
+        const float l_gradA = l_pitchA - l_pitch;
+        const float l_gradB = l_pitchB - l_pitch;
+        const float l_grad2 = sq(l_gradA) + sq(l_gradB);
+
+        if (l_grad2 > 0)
+        {
+            //Smallest cord error giving the pitch error, a part of it each travel
+            float l_scale = SI_DRIFT_GAIN * m_lastError / l_grad2;
+            const float l_length = ABS(l_scale) * SQRT(l_grad2);
+            if (l_length > SI_DRIFT_MAX_STEP_MM)
+                l_scale *= SI_DRIFT_MAX_STEP_MM / l_length;
+
+            m_lastA = constrain(m_totalA + l_scale * l_gradA, -SI_DRIFT_MAX_TOTAL_MM, SI_DRIFT_MAX_TOTAL_MM) - m_totalA;
+            m_lastB = constrain(m_totalB + l_scale * l_gradB, -SI_DRIFT_MAX_TOTAL_MM, SI_DRIFT_MAX_TOTAL_MM) - m_totalB;
+        }
+    }
+
+    if (m_mode == DRIFT_CORRECT && (m_lastA || m_lastB))
+    {
+        //The cords are longer by the error: once the travel is done tell the planner, then go back where it should be
+        planner.synchronize();
+        #if MECH(POLARGRAPH)
+            mechanics.Transform(mechanics.current_position);
+            planner.set_machine_position_mm(mechanics.delta[A_AXIS] + m_lastA, mechanics.delta[B_AXIS] + m_lastB, mechanics.delta[C_AXIS], mechanics.current_position[E_AXIS]);
+        #else
+            planner.set_machine_position_mm(mechanics.current_position[X_AXIS] + m_lastA, mechanics.current_position[Y_AXIS] + m_lastB, mechanics.current_position[Z_AXIS], mechanics.current_position[E_AXIS]);
+        #endif
+        planner.buffer_line(mechanics.current_position, SI_DRIFT_FEEDRATE_MM_S, tools.active_extruder);
+
+        m_totalA += m_lastA;
+        m_totalB += m_lastB;
+        m_corrections++;
+    }
+
+    SERIAL_SMV(ECHO, "IMU drift E", m_lastError, 3);
+    SERIAL_MV(" A", m_lastA, 3);
+    SERIAL_MV(" B", m_lastB, 3);
+    if (m_mode == DRIFT_CORRECT)
+    {
+        SERIAL_MV(" Total A", m_totalA, 3);
+        SERIAL_MV(" B", m_totalB, 3);
+    }
+    SERIAL_EOL();
+}
+
+void SIDriftClass::reset()
+{
+    m_samples = 0;
+    m_sumA = m_sumB = m_sumError = 0;
+    m_referenceTravels = 0;
+    m_reference = 0;
+    m_lastError = m_lastA = m_lastB = 0;
+    m_totalA = m_totalB = 0;
+    m_corrections = 0;
+    m_referenceNails = getNailDistance();
+}
+
+void SIDriftClass::setMode(const driftMode_t p_mode)
+{
+    if (p_mode != m_mode && m_mode == DRIFT_OFF)
+        reset();
+    m_mode = p_mode;
+}
+
+void SIDriftClass::report()
+{
+    SERIAL_SMV(ECHO, "IMU drift S", (int)m_mode);
+    SERIAL_MV(" D", getNailDistance(), 1);
+    if (m_referenceTravels < SI_DRIFT_REFERENCE_TRAVELS)
+    {
+        SERIAL_MV(" reference travels:", (int)m_referenceTravels);
+        SERIAL_MV("/", (int)SI_DRIFT_REFERENCE_TRAVELS);
+    }
+    else
+    {
+        SERIAL_MV(" Reference", m_reference, 3);
+        SERIAL_MV(" E", m_lastError, 3);
+    }
+    SERIAL_MV(" Total A", m_totalA, 3);
+    SERIAL_MV(" B", m_totalB, 3);
+    SERIAL_EMV(" Corrections:", m_corrections);
+}
+
+SIDriftClass SIDrift;
@@ -0,0 +1,89 @@
+#pragma once
+/**
+ * SIDrift.h
+ *
+ * Scribit position drift correction from the IMU pitch
+ *
+ * Hanging from the nails the robot tilts by
+ *   pitch = atan2(D - 2x, 2y)
+ * with x, y its position from the left nail and D the nail distance.
+ * While the pen is up and the robot travels, the measured pitch is
+ * compared with the pitch of the position the steppers are at. The
+ * first travels give the reference difference (sensor mounting, model),
+ * then a change of the difference is a position error: along the
+ * pitch gradient, the error is corrected by small cord moves right
+ * before the pen goes down.
+ */
+#include "SIIMU.h"
+
+#define SI_DRIFT_SAMPLE_MS 20          //Pitch sampling period during pen-up travel
+#define SI_DRIFT_MIN_SAMPLES 25        //Samples needed to use a travel
+#define SI_DRIFT_REFERENCE_TRAVELS 4   //Travels averaged for the reference difference
+#define SI_DRIFT_DEADBAND_DEG 0.05f    //Pitch errors below this are ignored
+#define SI_DRIFT_GAIN 0.5f             //Fraction of the estimated error corrected each travel
+#define SI_DRIFT_MAX_STEP_MM 0.5f      //Largest cord correction for one travel
+#define SI_DRIFT_MAX_TOTAL_MM 20.0f    //Largest cord correction in total
+#define SI_DRIFT_FEEDRATE_MM_S 10.0f   //Correction moves speed
+
+enum driftMode_t : uint8_t
+{
+    DRIFT_OFF,      //Nothing
+    DRIFT_MONITOR,  //Measure and report the pitch error
+    DRIFT_CORRECT   //Measure, report and correct
+};
+
+class SIDriftClass
+{
+    driftMode_t m_mode = DRIFT_OFF;
+    bool m_penUp = false;
+    float m_referenceNails = 0; //Nail distance the reference was taken with
+
+    //Current travel
+    uint32_t m_lastSample = 0;
+    uint16_t m_samples = 0;
+    float m_sumA = 0, m_sumB = 0, m_sumError = 0;
+
+    //Reference pitch difference
+    uint8_t m_referenceTravels = 0;
+    float m_reference = 0;
+
+    //Last travel and corrections
+    float m_lastError = 0;
+    float m_lastA = 0, m_lastB = 0;
+    float m_totalA = 0, m_totalB = 0;
+    uint16_t m_corrections = 0;
+
+    bool predictedPitch(const float p_a, const float p_b, float &p_pitch);
+    void endTravel();
+
+public:
+    /**
+     * @brief Sample the pitch during pen-up travel, call it often
+     *
+     */
+    void update();
+    /**
+     * @brief Call before a Z move, pen up raises Z and pen down lowers it
+     *
+     * @param p_from Z before the move
+     * @param p_to Z after the move
+     */
+    void zMove(const float p_from, const float p_to);
+    /**
+     * @brief Restart from a new reference, forget the corrections
+     *
+     */
+    void reset();
+    void report();
+
+    void setMode(const driftMode_t p_mode);
+    driftMode_t getMode() { return m_mode; }
+
+    /**
+     * @brief Nail distance of the wall, the mechanics one (M665 D, saved in EEPROM)
+     *
+     */
+    float getNailDistance() { return mechanics.data.nail_distance; }
+};
+
+extern SIDriftClass SIDrift;
@@ -0,0 +1,97 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * command_queue.cpp
+ */
+
+#include "../../../MK4duo.h"
+
+#if ENABLED(COMPACT_COMMAND_QUEUE)
+
+bool Command_Queue::enqueue(const char * cmd, const int8_t port) {
+
+  if (isFull()) return false;
+
+  gcode_t &item = queue[index_w];
+  item.s_port = port;
+
+  bool packed = parser.pack(cmd, item);
+
+  // Lines written to SD must be kept as they are
+  #if HAS_SD_SUPPORT
+    if (card.isSaving()) packed = false;
+  #endif
+
+  if (!packed) {
+    // Raw text, isFull() leaves room for a whole line
+    item.letter = 0;
+    item.text = text_w;
+    for (uint8_t i = 0; ; i++) {
+      const char c = i < MAX_CMD_SIZE - 1 ? cmd[i] : '\0';
+      text_ring[text_w] = c;
+      if (++text_w == COMMAND_TEXT_SIZE) text_w = 0;
+      text_used++;
+      if (!c) break;
+    }
+  }
+
+  if (++index_w == BUFSIZE) index_w = 0;
+  length++;
+  return true;
+}
+
+void Command_Queue::dequeue() {
+
+  if (isEmpty()) return;
+
+  const gcode_t &item = queue[index_r];
+
+  // Text is released in order, just count the bytes
+  if (!item.letter) {
+    uint16_t i = item.text;
+    char c;
+    do {
+      c = text_ring[i];
+      if (++i == COMMAND_TEXT_SIZE) i = 0;
+      text_used--;
+    } while (c);
+  }
+
+  if (++index_r == BUFSIZE) index_r = 0;
+  length--;
+}
+
+void Command_Queue::get_text(const gcode_t &cmd, char * buffer) {
+
+  if (cmd.letter) {
+    parser.unpack(cmd, buffer);
+    return;
+  }
+
+  uint16_t i = cmd.text;
+  while ((*buffer++ = text_ring[i])) {
+    if (++i == COMMAND_TEXT_SIZE) i = 0;
+  }
+}
+
+#endif // COMPACT_COMMAND_QUEUE
@@ -0,0 +1,120 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * command_queue.h
+ *
+ * COMPACT_COMMAND_QUEUE:
+ *  - Commands are parsed once, when queued, into a gcode_t holding
+ *    letter, code, a parameter bitmask and integer or fixed point values
+ *  - Lines the packed form can't represent exactly (string arguments,
+ *    parameters without value, too many values...) are kept as raw text
+ *    in a byte ring shared by the whole queue, and parsed when dequeued
+ */
+
+#if ENABLED(COMPACT_COMMAND_QUEUE)
+
+  #ifndef COMMAND_VALUES
+    #define COMMAND_VALUES 5
+  #endif
+  #ifndef COMMAND_TEXT_SIZE
+    #define COMMAND_TEXT_SIZE (2 * MAX_CMD_SIZE)
+  #endif
+
+  struct gcode_t {
+    uint32_t  codebits;                 // Parameters seen, 1 bit each for A-Z
+    int32_t   value[COMMAND_VALUES];    // Parameter values, in letter order
+    #if ENABLED(ADVANCED_OK)
+      int32_t line;                     // N<int>, if has_line
+      bool    has_line;
+    #endif
+    uint16_t  codenum,                  // 123
+              text;                     // Offset of the raw text in the text ring
+    char      letter;                   // G, M, or T. 0 for a raw text command
+    uint8_t   subcode,                  // .1
+              fixbits;                  // Values in fixed point, 1 bit each in value order
+    int8_t    s_port = -1;              // Serial port for print information:
+                                        //    -1 for all port
+                                        //    -2 for SD or null port
+  };
+
+  class Command_Queue {
+
+    public: /** Constructor */
+
+      Command_Queue() { clear(); }
+
+    private: /** Private Parameters */
+
+      gcode_t   queue[BUFSIZE];
+      char      text_ring[COMMAND_TEXT_SIZE];
+
+      uint8_t   index_r,    // Read position
+                index_w,    // Write position
+                length;     // Number of commands
+
+      uint16_t  text_w,     // Text ring write position
+                text_used;  // Text ring bytes in use
+
+    public: /** Public Function */
+
+      void clear() { index_r = index_w = length = 0; text_w = text_used = 0; }
+
+      /**
+       * Parse and add a command line.
+       * Return false if the queue is full.
+       */
+      bool enqueue(const char * cmd, const int8_t port);
+
+      // Remove the command at head, releasing its raw text if any
+      void dequeue();
+
+      // Copy the command, as text, in a MAX_CMD_SIZE buffer
+      void get_text(const gcode_t &cmd, char * buffer);
+
+      /**
+       * Full when out of commands or when a line of MAX_CMD_SIZE
+       * could not be stored as raw text, so a line read is never lost.
+       */
+      FORCE_INLINE bool isFull()  { return length >= BUFSIZE || text_used > COMMAND_TEXT_SIZE - MAX_CMD_SIZE; }
+      FORCE_INLINE bool isEmpty() { return length == 0; }
+
+      FORCE_INLINE gcode_t& peek() { return queue[index_r]; }
+      FORCE_INLINE gcode_t& peek(const uint8_t index) { return queue[index]; }
+
+      FORCE_INLINE uint8_t count()  { return length; }
+      FORCE_INLINE uint8_t head()   { return index_r; }
+      FORCE_INLINE uint8_t tail()   { return index_w; }
+
+  };
+
+#else // !COMPACT_COMMAND_QUEUE
+
+  struct gcode_t {
+    char    gcode[MAX_CMD_SIZE];  // Char for gcode
+    int8_t  s_port = -1;          // Serial port for print information:
+                                  //    -1 for all port
+                                  //    -2 for SD or null port
+  };
+
+#endif // !COMPACT_COMMAND_QUEUE
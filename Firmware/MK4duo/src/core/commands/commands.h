@@ -27,15 +27,9 @@
  * Copyright (C) 2017 Alberto Cotronei @MagoKimbra
  */
 
+#include "command_queue.h"
 #include "parser.h"
 
-struct gcode_t {
-  char    gcode[MAX_CMD_SIZE];  // Char for gcode
-  int8_t  s_port = -1;          // Serial port for print information:
-                                //    -1 for all port
-                                //    -2 for SD or null port
-};
-
 class Commands {
 
   public: /** Constructor */
@@ -44,7 +38,11 @@ class Commands {
 
   public: /** Public Parameters */
 
-    static Circular_Queue<gcode_t, BUFSIZE> buffer_ring;
+    #if ENABLED(COMPACT_COMMAND_QUEUE)
+      static Command_Queue buffer_ring;
+    #else
+      static Circular_Queue<gcode_t, BUFSIZE> buffer_ring;
+    #endif
 
     static long gcode_LastN;
 
@@ -0,0 +1,75 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ * mcode
+ */
+
+#if ENABLED(INPUT_SHAPING)
+
+  #define CODE_M593
+
+  /**
+   * M593: Set Input Shaping for the X and Y motors
+   *
+   *  T<type>     Shaper: 0 off, 1 ZV, 2 ZVD, 3 EI
+   *  F<hz>       Swing frequency, INPUT_SHAPING_MIN_FREQ or more
+   *  D<ratio>    Damping ratio (0 - 0.3)
+   *
+   *  Without parameters report the current settings
+   */
+  inline void gcode_M593(void) {
+
+    if (parser.seen("TFD")) {
+      if (parser.seenval('T')) {
+        const uint8_t type = parser.value_byte();
+        if (type <= SHAPER_EI)
+          stepper.shaping_type = (ShaperTypeEnum)type;
+        else
+          SERIAL_EM("?T value out of range (0-3).");
+      }
+      if (parser.seenval('F')) {
+        const float freq = parser.value_float();
+        if (freq >= INPUT_SHAPING_MIN_FREQ)
+          stepper.shaping_frequency = freq;
+        else
+          SERIAL_EMV("?F value too low, min ", INPUT_SHAPING_MIN_FREQ);
+      }
+      if (parser.seenval('D')) {
+        const float damping = parser.value_float();
+        if (WITHIN(damping, 0, 0.3))
+          stepper.shaping_damping = damping;
+        else
+          SERIAL_EM("?D value out of range (0-0.3).");
+      }
+      stepper.set_input_shaping();
+    }
+    else {
+      static const char * const shaper_names[] = { "off", "ZV", "ZVD", "EI" };
+      SERIAL_SMT(ECHO, "Input Shaping ", shaper_names[stepper.shaping_type]);
+      SERIAL_MV(" F", stepper.shaping_frequency, 2);
+      SERIAL_EMV(" D", stepper.shaping_damping, 2);
+    }
+  }
+
+#endif // ENABLED(INPUT_SHAPING)
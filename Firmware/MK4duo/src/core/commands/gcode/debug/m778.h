@@ -0,0 +1,213 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ */
+
+#if ENABLED(PARSER_BENCHMARK)
+
+  #define CODE_M778
+
+  // Job lines from data/mariM.GCODE (Header, drawing, more than 4 decimals)
+  const char bench_lines[] PROGMEM =
+    "M92 X30.5 Y-30.5 Z22.2222\n"
+    "G92 X910.7521 Y1900.1866 Z30\n"
+    "G1 Z30\n"
+    "G4 P50\n"
+    "G1 X1210.1128 Y1734.4249\n"
+    "G1 X1212.5868 Y1734.147\n"
+    "G1 X1214.5574 Y1733.887\n"
+    "G1 X1216.5195 Y1733.5936\n"
+    "G1 X1218.473 Y1733.2673\n"
+    "G1 X1220.4176 Y1732.9084\n"
+    "G1 X1222.3524 Y1732.5172\n"
+    "G1 X1224.2775 Y1732.094\n"
+    "G1 X1226.1921 Y1731.6389\n"
+    "G1 X1228.096 Y1731.1526\n"
+    "G1 X1229.9884 Y1730.6349\n"
+    "G1 X1231.8693 Y1730.0863\n"
+    "G1 X966.28815 Y1717.3927\n"
+    "G1 X973.62726 Y1718.3839\n"
+    "G1 X910.7521 Y1900.1866\n"
+    "G1 Z0";
+
+  #if ENABLED(FASTER_GCODE_PARSER)
+
+    // More parameters than FASTER_GCODE_PARAMS, flags and signs
+    const char check_lines[] PROGMEM =
+      "G1 A1 B-2 C3 D4 E5.5 F600 H7 I8 J9 K10 L11 P12 Q13 R14 S15 U16 V17 W18 X19 Y20 Z21\n"
+      "G28 X Y\n"
+      "M104 S T0\n"
+      "G1 X+.5 Y-.25 E-0.0001 F1200\n"
+      "M92 Z22.2222";
+
+    /**
+     * Compare the FASTER_GCODE_PARSER lookup with the text scan
+     * for all of A-Z. Return the number of differences.
+     */
+    inline uint8_t check_line(const char * const line) {
+      char buffer[MAX_CMD_SIZE];
+      uint8_t errors = 0;
+      strcpy(buffer, line);
+      parser.parse(buffer);
+      for (char c = 'A'; c <= 'Z'; c++) {
+        const bool fast = parser.seen(c), fast_val = fast && parser.has_value();
+        const float fast_float = fast_val ? parser.value_float() : 0;
+        const bool scan = parser.seen_scan(c), scan_val = scan && parser.has_value();
+        const float scan_float = scan_val ? parser.value_float() : 0;
+        if (fast != scan || fast_val != scan_val || fast_float != scan_float) {
+          SERIAL_MV("Parser mismatch ", c);
+          SERIAL_EMT(" in ", line);
+          errors++;
+        }
+      }
+      return errors;
+    }
+
+  #endif
+
+  #if ENABLED(ARDUINO_ARCH_SAMD)
+    // SysTick counts CPU cycles down, reloading every millisecond
+    FORCE_INLINE uint32_t bench_start() { return SysTick->VAL; }
+    FORCE_INLINE uint32_t bench_cycles(const uint32_t start) {
+      const uint32_t now = SysTick->VAL;
+      return start >= now ? start - now : start + SysTick->LOAD + 1 - now;
+    }
+  #else
+    FORCE_INLINE uint32_t bench_start() { return micros(); }
+    FORCE_INLINE uint32_t bench_cycles(const uint32_t start) { return (micros() - start) * (F_CPU / 1000000UL); }
+  #endif
+
+  enum BenchStage : uint8_t { BENCH_STRTOF, BENCH_FIXED, BENCH_PACKED, BENCH_STAGES };
+
+  // Parse a line and fetch the motion values, as G0/G1 do
+  inline uint32_t bench_line(const char * const line, const BenchStage stage) {
+    char buffer[MAX_CMD_SIZE];
+    volatile float sink = 0;
+    strcpy(buffer, line);
+
+    const uint32_t start = bench_start();
+    #if ENABLED(COMPACT_COMMAND_QUEUE)
+      gcode_t cmd;
+      if (stage == BENCH_PACKED && parser.pack(buffer, cmd))
+        parser.parse(cmd);
+      else
+    #endif
+        parser.parse(buffer);
+    LOOP_XYZE(i) {
+      if (parser.seenval(axis_codes[i]))
+        sink = stage == BENCH_STRTOF ? parser.value_float_strtof() : parser.value_float();
+    }
+    if (parser.seenval('F'))
+      sink = stage == BENCH_STRTOF ? parser.value_float_strtof() : parser.value_float();
+    UNUSED(sink);
+    return bench_cycles(start);
+  }
+
+  /**
+   * M778: Parser benchmark
+   *
+   *  S<count> Runs of each line, the fastest one is kept (default 3)
+   *
+   * Prints the CPU cycles per line to parse and read the motion
+   * values with strtof, with the fixed point scan and, with
+   * COMPACT_COMMAND_QUEUE, packing included.
+   *
+   * With FASTER_GCODE_PARSER every line is also checked against
+   * the text scan, and the differences are printed.
+   */
+  inline void gcode_M778(void) {
+
+    const uint8_t runs = MAX(parser.byteval('S', 3), 1);
+
+    char * const saved_cmd = parser.command_ptr;
+    #if ENABLED(COMPACT_COMMAND_QUEUE)
+      const gcode_t * const saved_packed = parser.packed;
+    #endif
+
+    planner.synchronize();
+
+    uint32_t total[BENCH_STAGES] = { 0 };
+    uint8_t lines = 0;
+    #if ENABLED(FASTER_GCODE_PARSER)
+      uint16_t errors = 0;
+    #endif
+    PGM_P p = bench_lines;
+    for (;;) {
+      char line[MAX_CMD_SIZE];
+      PGM_P const delim = strchr_P(p, '\n');
+      const size_t len = delim ? delim - p : strlen_P(p);
+      strncpy_P(line, p, len);
+      line[len] = '\0';
+
+      for (uint8_t s = 0; s < BENCH_STAGES; s++) {
+        #if DISABLED(COMPACT_COMMAND_QUEUE)
+          if (s == BENCH_PACKED) continue;
+        #endif
+        uint32_t best = UINT32_MAX;
+        for (uint8_t r = 0; r < runs; r++) {
+          const uint32_t cycles = bench_line(line, (BenchStage)s);
+          NOMORE(best, cycles);
+        }
+        total[s] += best;
+      }
+      #if ENABLED(FASTER_GCODE_PARSER)
+        errors += check_line(line);
+      #endif
+      lines++;
+      watchdog.reset();
+
+      if (!delim) break;
+      p = delim + 1;
+    }
+
+    #if ENABLED(FASTER_GCODE_PARSER)
+      for (p = check_lines; p; ) {
+        char line[MAX_CMD_SIZE];
+        PGM_P const delim = strchr_P(p, '\n');
+        const size_t len = delim ? delim - p : strlen_P(p);
+        strncpy_P(line, p, len);
+        line[len] = '\0';
+        errors += check_line(line);
+        p = delim ? delim + 1 : NULL;
+      }
+    #endif
+
+    #if ENABLED(COMPACT_COMMAND_QUEUE)
+      if (saved_packed) parser.parse(*saved_packed);
+      else
+    #endif
+        parser.parse(saved_cmd);
+
+    SERIAL_EMV("Parser benchmark lines:", lines);
+    SERIAL_EMV(" strtof cycles/line:", total[BENCH_STRTOF] / lines);
+    SERIAL_EMV(" fixed cycles/line:", total[BENCH_FIXED] / lines);
+    #if ENABLED(COMPACT_COMMAND_QUEUE)
+      SERIAL_EMV(" packed cycles/line:", total[BENCH_PACKED] / lines);
+    #endif
+    #if ENABLED(FASTER_GCODE_PARSER)
+      SERIAL_EMV(" parser mismatches:", errors);
+    #endif
+  }
+
+#endif // ENABLED(PARSER_BENCHMARK)
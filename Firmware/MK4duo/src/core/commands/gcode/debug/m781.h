@@ -0,0 +1,71 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ */
+
+#if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+
+  #define CODE_M781
+
+  /**
+   * M781: Adaptive step smoothing
+   *
+   *  F<Hz> Oversample the slower blocks up to this Step ISR rate, 0 for off
+   *  R     Restart the counters
+   *
+   * Prints the Step ISRs run since the last restart, their mean and
+   * longest CPU cycles, the share of the CPU they took and the highest
+   * oversampling used. Then restarts the counters.
+   */
+  inline void gcode_M781(void) {
+
+    if (parser.seenval('F')) stepper.smoothing_frequency = parser.value_ulong();
+
+    if (parser.seen('R')) {
+      stepper.reset_isr_stats();
+      return;
+    }
+
+    // Copy the counters at once
+    const bool isr_enabled = STEPPER_ISR_ENABLED();
+    if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+    const uint32_t  count = stepper.isr_count,
+                    cycles_max = stepper.isr_cycles_max,
+                    ms = millis() - stepper.isr_stats_ms;
+    const uint64_t  cycles = stepper.isr_cycles;
+    const uint8_t   factor = stepper.oversampling_max;
+    if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+
+    stepper.reset_isr_stats();
+
+    SERIAL_MV("Step smoothing F", stepper.smoothing_frequency);
+    SERIAL_EMV(" limit", MIN(stepper.smoothing_frequency, HAL_min_isr_frequency));
+    SERIAL_MV(" ISR/s:", ms ? uint32_t(uint64_t(count) * 1000UL / ms) : 0UL);
+    SERIAL_MV(" cycles/ISR:", count ? uint32_t(cycles / count) : 0UL);
+    SERIAL_MV(" max:", cycles_max);
+    SERIAL_MV(" CPU%:", ms ? float(cycles) * 100.0f / (float(ms) * float((F_CPU) / 1000UL)) : 0.0f, 1);
+    SERIAL_EMV(" max oversampling:", (1 << factor));
+  }
+
+#endif // ENABLED(ADAPTIVE_STEP_SMOOTHING)
@@ -64,6 +64,7 @@
 #include "config/m306.h"                  // Set Heaters
 #include "config/m595.h"                  // Set AD595 offset & Gain
 #include "config/m569.h"                  // Set Stepper Direction
+#include "config/m593.h"                  // Set and/or Get input shaping
 #include "config/m900.h"                  // Set and/or Get advance K factor
 #include "config/m906.h"                  // Set Alligator motor currents or Set motor current in milliamps with have a TMC2130 driver
 #include "config/m907.h"                  // Set digital trimpot motor current
@@ -92,6 +93,8 @@
 
 // Debug Commands
 #include "debug/m43.h"
+#include "debug/m778.h"                   // Parser benchmark
+#include "debug/m781.h"                   // Adaptive step smoothing
 #include "debug/m44_pre_table.h"          // Debug Code Info
 
 // Delta Commands
@@ -158,6 +161,7 @@
 #include "motion/g2_g3.h"
 #include "motion/g4.h"
 #include "motion/g5.h"
+#include "motion/g64.h"
 #include "motion/g10_g11.h"
 #include "motion/g90.h"
 #include "motion/g91.h"
@@ -178,6 +182,9 @@
 #include "nextion/m35.h"                  // Upload firmware to Nextion from SD
 #include "nextion/m995_m996.h"            // Setting GFX for Nextion
 
+// Polargraph Commands
+#include "polargraph/m665.h"              // Set nail distance and segment tolerance
+
 // Power Commands
 #include "power/m80.h"
 #include "power/m81.h"
@@ -239,16 +246,20 @@
 #include "units/m83.h"
 #include "units/m149.h"
 
-#if ENABLED(FASTER_GCODE_EXECUTE) || ENABLED(ARDUINO_ARCH_SAM)
-  // Table for G and M code
-  #include "table_gcode.h"
-  #include "table_mcode.h"
-
-  // Include m44 post define table for debugging
-  #include "debug/m44_post_table.h"
-#endif
-
 //Scribit commands
 #include "scribit/m777.h"
+#include "scribit/m779.h"
+#include "scribit/m780.h"
+#include "scribit/m575.h"
 #include "scribit/g77.h"
 #include "scribit/g100.h"
+
+// Table for G and M code, after all the commands
+#include "table_gcode.h"
+#include "table_mcode.h"
+#include "table_index.h"
+
+#if ENABLED(FASTER_GCODE_EXECUTE) || ENABLED(ARDUINO_ARCH_SAM)
+  // Include m44 post define table for debugging
+  #include "debug/m44_post_table.h"
+#endif
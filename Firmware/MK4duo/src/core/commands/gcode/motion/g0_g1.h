@@ -73,7 +73,11 @@ inline void gcode_G0_G1(
     #if IS_SCARA
       fast_move ? mechanics.prepare_uninterpolated_move_to_destination() : mechanics.prepare_move_to_destination();
     #else
-      mechanics.prepare_move_to_destination();
+      #if ENABLED(Z_MOTION_CHANNEL)
+        // Pen moves run on their own channel
+        if (!mechanics.prepare_z_move_to_destination())
+      #endif
+          mechanics.prepare_move_to_destination();
     #endif
 
     #if ENABLED(LASER) && ENABLED(LASER_FIRE_G1)
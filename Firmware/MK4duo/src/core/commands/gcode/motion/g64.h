@@ -0,0 +1,47 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * gcode.h
+ *
+ * Copyright (C) 2017 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(PATH_BLENDING)
+
+  #define CODE_G64
+
+  /**
+   * G64: Path blending
+   *
+   *  P<mm> Max distance of the blended path from the corners, 0 for the exact path.
+   *        Without P, PATH_BLENDING_TOLERANCE
+   */
+  inline void gcode_G64(void) {
+    const float tolerance = parser.seenval('P') ? parser.value_linear_units() : PATH_BLENDING_TOLERANCE;
+    if (tolerance >= 0.0)
+      planner.blend_tolerance = tolerance;
+    else
+      SERIAL_LM(ER, "?P value must be 0 or more.");
+  }
+
+#endif // ENABLED(PATH_BLENDING)
@@ -0,0 +1,101 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ */
+
+#if MECH(POLARGRAPH)
+
+  #define CODE_M665
+
+  /**
+   * M665: Set Polargraph settings
+   *
+   * Parameters:
+   *
+   *   D[mm] - Distance between the nails
+   *   S[mm] - Segment tolerance, max distance of the pen from the straight line
+   *
+   * Without parameters report the current settings.
+   * The position is kept on the wall, the cords are recalculated.
+   */
+  inline void gcode_M665() {
+
+    if (!parser.seen("DS")) {
+      SERIAL_SMV(ECHO, "Polargraph D", mechanics.data.nail_distance, 3);
+      SERIAL_EMV(" S", mechanics.data.segment_tolerance, 3);
+      return;
+    }
+
+    if (parser.seenval('D')) {
+      const float nail_distance = parser.value_linear_units();
+      if (nail_distance <= 0) {
+        SERIAL_LM(ER, "Nail distance must be positive");
+        return;
+      }
+      planner.synchronize();
+      mechanics.data.nail_distance = nail_distance;
+      mechanics.sync_plan_position();
+    }
+
+    if (parser.seenval('S')) {
+      const float segment_tolerance = parser.value_linear_units();
+      if (segment_tolerance > 0)
+        mechanics.data.segment_tolerance = segment_tolerance;
+      else
+        SERIAL_LM(ER, "Segment tolerance must be positive");
+    }
+
+  }
+
+#elif MECH(CARTESIAN) && ENABLED(POLARGRAPH_NAIL_DISTANCE)
+
+  #define CODE_M665
+
+  /**
+   * M665: Set hanging robot settings (Cords moved as X and Y)
+   *
+   * Parameters:
+   *
+   *   D[mm] - Distance between the nails, for the cable tension limits
+   *
+   * Without parameters report the current settings.
+   */
+  inline void gcode_M665() {
+
+    if (!parser.seenval('D')) {
+      SERIAL_LMV(ECHO, "Hanging robot D", mechanics.data.nail_distance, 3);
+      return;
+    }
+
+    const float nail_distance = parser.value_linear_units();
+    if (nail_distance <= 0) {
+      SERIAL_LM(ER, "Nail distance must be positive");
+      return;
+    }
+    // Queued blocks keep the limits they were planned with
+    mechanics.data.nail_distance = nail_distance;
+
+  }
+
+#endif // MECH(POLARGRAPH) || MECH(CARTESIAN)
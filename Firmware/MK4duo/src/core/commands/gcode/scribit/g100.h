@@ -26,7 +26,6 @@ inline void evaluate(float *p_computedArray)
     Serial.println(g_maxValue);
     Serial.print("Threshold: ");
     Serial.println(l_threshold);
-    Serial.flush();
 
     while((l_index < g_samplesNumber - MOBILE_AVG_WINDOW && l_current < l_threshold) || l_index < g_samplesNumber * 0.50f)
     {
@@ -40,7 +39,6 @@ inline void evaluate(float *p_computedArray)
     Serial.print(l_current);
     Serial.print(" at index: ");
     Serial.println(l_index);
-    Serial.flush();
 
     setMovingTime((float)((MOVEMENT_ANGLE * l_index-1)/(g_samplesNumber - MOBILE_AVG_WINDOW)), g_selectedPen);
 }
@@ -124,7 +122,6 @@ inline void move()
 
         Serial.print("Number of samples: ");
         Serial.println(g_samplesNumber);
-        Serial.flush();
 
         l_computedArray = calculateAverage(l_xValues, l_yValues, l_zValues);
 
@@ -26,12 +26,10 @@ inline uint8_t getSelectedPen()
     {
         Serial.print("ERROR! Cannot identify pen! Value is: ");
         Serial.println(mechanics.destination[Z_AXIS]);
-        Serial.flush();
     }
 
     Serial.print("Selected pen: ");
     Serial.println(l_retVal+1);
-    Serial.flush();
     
     return l_retVal;
 }
@@ -42,7 +40,6 @@ inline extern void setMovingTime(float p_movingAngle, uint8_t p_selectedPen)
 
     Serial.print("New Angle is: ");
     Serial.println(g_timeLimit[p_selectedPen]);
-    Serial.flush();
 }
 
 inline void gcode_G101(void)
@@ -52,7 +49,6 @@ inline void gcode_G101(void)
     Serial.println("********************** G101");
     Serial.print("Movement time is:");
     Serial.println(g_timeLimit[l_selectedPen]);
-    Serial.flush();
 
     mechanics.data.travel_acceleration = 1000;
     mechanics.feedrate_mm_s = MMM_TO_MMS(2000);
@@ -66,6 +62,11 @@ inline void gcode_G101(void)
         mechanics.destination[Z_AXIS] = mechanics.destination[Z_AXIS] - 30;
     }
 
+#if ENABLED(Z_MOTION_CHANNEL)
+    //Pen down is ordered by the Z channel, the next moves wait for it
+    if (!mechanics.prepare_z_move_to_destination())
+        mechanics.prepare_move_to_destination();
+#else
     mechanics.prepare_move_to_destination();
 
     while(planner.has_blocks_queued() || planner.cleaning_buffer_flag)
@@ -73,4 +74,5 @@ inline void gcode_G101(void)
         printer.keepalive(InProcess);
         printer.idle();
     }
+#endif
 }
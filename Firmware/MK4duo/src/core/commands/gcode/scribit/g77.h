@@ -168,7 +168,6 @@ inline void initHall()
     Serial.println(g_threshold);
     Serial.print("Average: ");
     Serial.println(MEAN);
-    Serial.flush();
 
     //Check for initialization results-----------
     if (delta > THRESHOLD_DELTA_NO_HALL) //Old hardware
@@ -274,7 +273,6 @@ inline bool home_cylinder()
 
                 Serial.print("Triggered, value is: ");
                 Serial.println(sum);
-                Serial.flush();
             }            
         }
         
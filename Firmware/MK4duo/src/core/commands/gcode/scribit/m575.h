@@ -0,0 +1,103 @@
+/**
+ * ESP link baudrate Gcode
+ *
+ */
+
+#define CODE_M575
+
+#define SI_LINK_MIN_BAUDRATE 9600
+#define SI_LINK_MAX_BAUDRATE 1000000
+#define SI_LINK_TEST_TIMEOUT_MS 1000 //Time without valid test lines before switching back
+#define SI_LINK_TEST_PREFIX "LINKTEST:"
+#define SI_LINK_CONFIRM "LINKOK"
+
+/**
+ * Reads a raw line from ESP link
+ *
+ * Returns false if the deadline expires first
+ */
+inline bool readLinkLine(char *p_buffer, const uint8_t p_size, const millis_t p_deadline)
+{
+    uint8_t l_len = 0;
+    int l_c;
+
+    while (PENDING(millis(), p_deadline))
+    {
+        watchdog.reset();
+        if ((l_c = Com::serialRead(0)) < 0)
+            continue;
+        if (l_c == '\n' || l_c == '\r')
+        {
+            //Skip empty lines (CR LF)
+            if (l_len == 0)
+                continue;
+            p_buffer[l_len] = 0;
+            return true;
+        }
+        if (l_len < p_size - 1)
+            p_buffer[l_len++] = l_c;
+    }
+    return false;
+}
+
+/**
+ * M575: Change ESP link baudrate
+ *
+ *  B<baudrate> New baudrate
+ *
+ * Handshake:
+ *  - "LINK:<baudrate>" is sent at current rate, then the link is switched
+ *  - Every "LINKTEST:<pattern>" received is echoed back
+ *  - "LINKOK" confirms the new rate, no valid line within SI_LINK_TEST_TIMEOUT_MS switches back
+ *  - Any other line means the ESP gave up: switch back and request it again with Resend
+ *  The ok is sent at the resulting rate.
+ *
+ * The ESP sends it after an M400 ok, so the command queue is empty.
+ */
+inline void gcode_M575(void)
+{
+    char buffer[MAX_CMD_SIZE];
+    const uint32_t l_oldRate = g_linkBaudrate;
+
+    if (!parser.seenval('B'))
+        return;
+
+    const uint32_t l_newRate = parser.value_ulong();
+    if (!WITHIN(l_newRate, SI_LINK_MIN_BAUDRATE, SI_LINK_MAX_BAUDRATE))
+    {
+        SERIAL_LMV(ER, "Unsupported baudrate ", l_newRate);
+        return;
+    }
+
+    //Announce and switch
+    SERIAL_MV("LINK:", l_newRate);
+    SERIAL_EOL();
+    Com::changeBaudrate(l_newRate);
+
+    //Echo test lines until confirmed
+    bool l_dropped = false;
+    millis_t l_deadline = millis() + SI_LINK_TEST_TIMEOUT_MS;
+    while (!l_dropped && readLinkLine(buffer, sizeof(buffer), l_deadline))
+    {
+        if (strcmp(buffer, SI_LINK_CONFIRM) == 0)
+        {
+            g_linkBaudrate = l_newRate;
+            return;
+        }
+        if (strncmp(buffer, SI_LINK_TEST_PREFIX, sizeof(SI_LINK_TEST_PREFIX) - 1) == 0)
+        {
+            SERIAL_TXT(buffer);
+            SERIAL_EOL();
+            l_deadline = millis() + SI_LINK_TEST_TIMEOUT_MS;
+        }
+        else
+            l_dropped = true;
+    }
+
+    //Not confirmed, back to previous rate
+    Com::changeBaudrate(l_oldRate);
+
+    //A command was read instead of a test line, ask the ESP for it again
+    if (l_dropped)
+        SERIAL_LV(RESEND, commands.gcode_LastN + 1);
+}
@@ -0,0 +1,413 @@
+/**
+ * Swing resonance measurement Gcode
+ *
+ */
+
+#if ENABLED(SWING_RESONANCE_MEASUREMENT)
+
+#define CODE_M779
+
+#define SI_RESONANCE_SAMPLES 320         //Samples for each channel (6 channels of int16)
+#define SI_RESONANCE_DEFAULT_RATE 25     //Hz
+#define SI_RESONANCE_MAX_RATE 100        //Hz, sensors work at 833Hz
+#define SI_RESONANCE_DEFAULT_DISTANCE 10 //mm
+#define SI_RESONANCE_GYRO_SCALE 100.0f   //Stored units per dps
+#define SI_RESONANCE_ACC_SCALE 10000.0f  //Stored units per g
+#define SI_RESONANCE_MIN_QUALITY 0.5f    //Below this the fit is reported as poor
+#define SI_RESONANCE_REFINE_STEPS 16     //Golden section steps for each parameter
+#define SI_RESONANCE_IDLE_SLACK 15000    //us, time left before the next sample to keep the printer alive
+
+enum resonanceChannel_t : uint8_t
+{
+    RES_GYRO_X, RES_GYRO_Y, RES_GYRO_Z,
+    RES_ACC_X, RES_ACC_Y, RES_ACC_Z,
+    RES_CHANNELS
+};
+
+struct resonanceFit_t
+{
+    float omega;     //Damped angular frequency, rad/sample
+    float sigma;     //Decay rate, 1/sample
+    float quality;   //R^2 of the fit, 1 is a perfect damped oscillation
+    float amplitude; //Initial amplitude, stored units
+};
+
+//Recorded samples, static so the measurement can't run out of memory
+static int16_t g_resonanceData[RES_CHANNELS][SI_RESONANCE_SAMPLES];
+
+/**
+ * Fits y = e^(-sigma*t) * (a*cos(omega*t) + b*sin(omega*t)) + c
+ * by linear least squares for the given omega and sigma
+ *
+ * Returns the quality (R^2) and sets the amplitude (sqrt(a^2 + b^2))
+ */
+inline float resonanceQuality(const int16_t *p_data, const uint16_t p_count, const float p_omega, const float p_sigma, float *p_amplitude)
+{
+    //Rotation and decay of one sample, applied by recurrence
+    const float l_cosStep = cosf(p_omega), l_sinStep = sinf(p_omega), l_decay = expf(-p_sigma);
+
+    float l_suu = 0, l_suv = 0, l_svv = 0, l_su = 0, l_sv = 0;
+    float l_suy = 0, l_svy = 0, l_sy = 0, l_syy = 0;
+    float l_u = 1, l_v = 0;
+
+    for (uint16_t i = 0; i < p_count; i++)
+    {
+        const float y = p_data[i];
+        l_suu += l_u * l_u; l_suv += l_u * l_v; l_svv += l_v * l_v;
+        l_su += l_u; l_sv += l_v;
+        l_suy += l_u * y; l_svy += l_v * y; l_sy += y; l_syy += y * y;
+
+        const float l_next = (l_u * l_cosStep - l_v * l_sinStep) * l_decay;
+        l_v = (l_v * l_cosStep + l_u * l_sinStep) * l_decay;
+        l_u = l_next;
+    }
+
+    //Normal equations [suu suv su; suv svv sv; su sv n] * [a b c] = [suy svy sy]
+    const float n = p_count;
+    const float l_c00 = l_svv * n - l_sv * l_sv,
+                l_c01 = l_su * l_sv - l_suv * n,
+                l_c02 = l_suv * l_sv - l_svv * l_su,
+                l_c11 = l_suu * n - l_su * l_su,
+                l_c12 = l_suv * l_su - l_suu * l_sv,
+                l_c22 = l_suu * l_svv - l_suv * l_suv;
+    const float l_det = l_suu * l_c00 + l_suv * l_c01 + l_su * l_c02;
+
+    const float l_ssTot = l_syy - l_sy * l_sy / n;
+    if (l_ssTot <= 0 || l_det == 0)
+    {
+        *p_amplitude = 0;
+        return 0;
+    }
+
+    const float a = (l_c00 * l_suy + l_c01 * l_svy + l_c02 * l_sy) / l_det,
+                b = (l_c01 * l_suy + l_c11 * l_svy + l_c12 * l_sy) / l_det,
+                c = (l_c02 * l_suy + l_c12 * l_svy + l_c22 * l_sy) / l_det;
+
+    //Residuals on a second pass, the closed form loses too much precision in float
+    float l_ssRes = 0;
+    l_u = 1; l_v = 0;
+    for (uint16_t i = 0; i < p_count; i++)
+    {
+        const float l_error = p_data[i] - (a * l_u + b * l_v + c);
+        l_ssRes += l_error * l_error;
+
+        const float l_next = (l_u * l_cosStep - l_v * l_sinStep) * l_decay;
+        l_v = (l_v * l_cosStep + l_u * l_sinStep) * l_decay;
+        l_u = l_next;
+    }
+
+    *p_amplitude = SQRT(a * a + b * b);
+    return 1.0f - l_ssRes / l_ssTot;
+}
+
+/**
+ * Golden section search of omega (p_sigmaParam false) or sigma
+ * in [p_low, p_high] for the best quality, updates p_fit
+ */
+inline void resonanceRefine(const int16_t *p_data, const uint16_t p_count, resonanceFit_t &p_fit, const bool p_sigmaParam, float p_low, float p_high)
+{
+    const float l_ratio = 0.618034f;
+    float l_amplitude;
+    float &l_param = p_sigmaParam ? p_fit.sigma : p_fit.omega;
+
+    float l_x1 = p_high - l_ratio * (p_high - p_low),
+          l_x2 = p_low + l_ratio * (p_high - p_low);
+    float l_q1 = p_sigmaParam ? resonanceQuality(p_data, p_count, p_fit.omega, l_x1, &l_amplitude)
+                              : resonanceQuality(p_data, p_count, l_x1, p_fit.sigma, &l_amplitude);
+    float l_q2 = p_sigmaParam ? resonanceQuality(p_data, p_count, p_fit.omega, l_x2, &l_amplitude)
+                              : resonanceQuality(p_data, p_count, l_x2, p_fit.sigma, &l_amplitude);
+
+    for (uint8_t i = 0; i < SI_RESONANCE_REFINE_STEPS; i++)
+    {
+        watchdog.reset();
+        if (l_q1 > l_q2)
+        {
+            p_high = l_x2; l_x2 = l_x1; l_q2 = l_q1;
+            l_x1 = p_high - l_ratio * (p_high - p_low);
+            l_q1 = p_sigmaParam ? resonanceQuality(p_data, p_count, p_fit.omega, l_x1, &l_amplitude)
+                                : resonanceQuality(p_data, p_count, l_x1, p_fit.sigma, &l_amplitude);
+        }
+        else
+        {
+            p_low = l_x1; l_x1 = l_x2; l_q1 = l_q2;
+            l_x2 = p_low + l_ratio * (p_high - p_low);
+            l_q2 = p_sigmaParam ? resonanceQuality(p_data, p_count, p_fit.omega, l_x2, &l_amplitude)
+                                : resonanceQuality(p_data, p_count, l_x2, p_fit.sigma, &l_amplitude);
+        }
+    }
+
+    //Keep the previous value if the search didn't improve it
+    const float l_best = l_q1 > l_q2 ? l_x1 : l_x2;
+    const float l_old = l_param;
+    l_param = l_best;
+    const float l_quality = resonanceQuality(p_data, p_count, p_fit.omega, p_fit.sigma, &l_amplitude);
+    if (l_quality >= p_fit.quality)
+    {
+        p_fit.quality = l_quality;
+        p_fit.amplitude = l_amplitude;
+    }
+    else
+        l_param = l_old;
+}
+
+/**
+ * Fits a damped oscillation on a channel
+ *
+ * First guess from the zero crossings (period) and the cycle peaks
+ * (log decrement), then refined by golden section on the quality.
+ * Returns false if there is no oscillation to fit.
+ */
+inline bool resonanceFit(const int16_t *p_data, const uint16_t p_count, resonanceFit_t &p_fit)
+{
+    float l_mean = 0;
+    int16_t l_peak = 0;
+
+    for (uint16_t i = 0; i < p_count; i++)
+        l_mean += p_data[i];
+    l_mean /= p_count;
+    for (uint16_t i = 0; i < p_count; i++)
+        l_peak = MAX(l_peak, (int16_t)ABS(p_data[i] - l_mean));
+
+    //Hysteresis, so noise around zero doesn't count as crossings
+    const float l_hysteresis = l_peak * 0.1f;
+    if (l_hysteresis < 1)
+        return false;
+
+    bool l_armed = false;
+    uint8_t l_crossings = 0, l_peaks = 0;
+    float l_first = 0, l_last = 0;
+    float l_cyclePeak = 0, l_cyclePeakTime = 0;
+    //Least squares of ln(peak) over time
+    float l_st = 0, l_stt = 0, l_sl = 0, l_stl = 0;
+
+    for (uint16_t i = 1; i < p_count; i++)
+    {
+        const float l_prev = p_data[i - 1] - l_mean, l_cur = p_data[i] - l_mean;
+
+        if (l_cur > l_cyclePeak)
+        {
+            l_cyclePeak = l_cur;
+            l_cyclePeakTime = i;
+        }
+        if (l_cur < -l_hysteresis)
+            l_armed = true;
+        else if (l_armed && l_cur >= 0)
+        {
+            //Upward crossing, interpolated between the samples
+            const float l_time = i - l_cur / (l_cur - l_prev);
+            l_armed = false;
+            if (l_crossings == 0)
+                l_first = l_time;
+            else if (l_cyclePeak > l_hysteresis)
+            {
+                //Positive peak of the cycle just ended
+                const float l_log = logf(l_cyclePeak);
+                l_st += l_cyclePeakTime; l_stt += l_cyclePeakTime * l_cyclePeakTime;
+                l_sl += l_log; l_stl += l_cyclePeakTime * l_log;
+                l_peaks++;
+            }
+            else
+                break; //Swing decayed into the noise
+            l_crossings++;
+            l_last = l_time;
+            l_cyclePeak = 0;
+        }
+    }
+
+    if (l_crossings < 2)
+        return false;
+
+    p_fit.omega = 2 * M_PI * (l_crossings - 1) / (l_last - l_first);
+    p_fit.sigma = 0;
+    if (l_peaks >= 2)
+    {
+        const float l_den = l_peaks * l_stt - l_st * l_st;
+        if (l_den > 0)
+            p_fit.sigma = MAX(0.0f, -(l_peaks * l_stl - l_st * l_sl) / l_den);
+    }
+    p_fit.quality = resonanceQuality(p_data, p_count, p_fit.omega, p_fit.sigma, &p_fit.amplitude);
+
+    //Frequency, then decay, then frequency again on a narrower range
+    resonanceRefine(p_data, p_count, p_fit, false, p_fit.omega * 0.85f, p_fit.omega * 1.15f);
+    resonanceRefine(p_data, p_count, p_fit, true, 0, p_fit.sigma * 2 + p_fit.omega * 0.5f);
+    resonanceRefine(p_data, p_count, p_fit, false, p_fit.omega * 0.97f, p_fit.omega * 1.03f);
+
+    return true;
+}
+
+/**
+ * Fits the channel with most signal in [p_from, p_to] and prints the result
+ *
+ * Returns the quality, 0 if nothing could be fitted
+ */
+inline float resonanceReport(const char *p_sensor, const uint8_t p_from, const uint8_t p_to, const uint16_t p_count, const float p_rate, resonanceFit_t &p_fit)
+{
+    static const char l_axes[] = "XYZ";
+    uint8_t l_channel = p_from;
+    float l_best = -1;
+
+    //Channel with the biggest variance
+    for (uint8_t ch = p_from; ch <= p_to; ch++)
+    {
+        float l_sum = 0, l_sum2 = 0;
+        for (uint16_t i = 0; i < p_count; i++)
+        {
+            l_sum += g_resonanceData[ch][i];
+            l_sum2 += (float)g_resonanceData[ch][i] * g_resonanceData[ch][i];
+        }
+        const float l_variance = l_sum2 - l_sum * l_sum / p_count;
+        if (l_variance > l_best)
+        {
+            l_best = l_variance;
+            l_channel = ch;
+        }
+    }
+
+    SERIAL_MT("Resonance ", p_sensor);
+    SERIAL_CHR(l_axes[l_channel - p_from]);
+
+    if (!resonanceFit(g_resonanceData[l_channel], p_count, p_fit))
+    {
+        SERIAL_EM(": no oscillation");
+        return 0;
+    }
+
+    //Natural frequency and damping ratio from the damped oscillation
+    const float l_omegaN = SQRT(p_fit.omega * p_fit.omega + p_fit.sigma * p_fit.sigma);
+    SERIAL_MV(": F", l_omegaN * p_rate / (2 * M_PI), 3);
+    SERIAL_MV(" D", p_fit.sigma / l_omegaN, 3);
+    SERIAL_MV(" Q", p_fit.quality, 3);
+    SERIAL_MV(" A", p_fit.amplitude / (p_from == RES_GYRO_X ? SI_RESONANCE_GYRO_SCALE : SI_RESONANCE_ACC_SCALE), 4);
+    if (p_fit.quality < SI_RESONANCE_MIN_QUALITY)
+        SERIAL_MSG(" poor fit");
+    SERIAL_EOL();
+
+    return p_fit.quality;
+}
+
+/**
+ * M779: Measure the swing resonance with the IMU
+ *
+ *  D<mm>     Sideways excitation move, out and back (default SI_RESONANCE_DEFAULT_DISTANCE)
+ *  F<mm/min> Excitation feedrate (default current feedrate)
+ *  A<mm/s2>  Excitation acceleration (default current acceleration)
+ *  S<hz>     Sample rate (default SI_RESONANCE_DEFAULT_RATE, max SI_RESONANCE_MAX_RATE)
+ *  P<ms>     Recording time, limited by SI_RESONANCE_SAMPLES
+ *
+ * The swing after the move is recorded from gyroscope and accelerometer,
+ * a damped oscillation is fitted on the axis of each sensor with most signal.
+ * Reports natural frequency (F), damping ratio (D), quality of fit (Q, R^2)
+ * and amplitude (A, dps or g) for both sensors, after the samples taken
+ * more than a tenth of the period late.
+ */
+inline void gcode_M779(void)
+{
+    //Check imu state
+    if (SIIMU.getStatus() != IMU_SUCCESS)
+    {
+        SERIAL_STR(ER);
+        SERIAL_PS("IMU unavailable, error ");
+        SERIAL_CHR('0'+SIIMU.getStatus());
+        SERIAL_EOL();
+        return;
+    }
+
+    const float l_distance = parser.linearval('D', SI_RESONANCE_DEFAULT_DISTANCE);
+    const float l_rate = constrain(parser.floatval('S', SI_RESONANCE_DEFAULT_RATE), 1, SI_RESONANCE_MAX_RATE);
+    const uint16_t l_count = parser.seenval('P') ? constrain(parser.value_millis() * l_rate / 1000, 16, SI_RESONANCE_SAMPLES) : SI_RESONANCE_SAMPLES;
+    const uint32_t l_period = 1000000UL / l_rate;
+
+    //Excitation: out and back, the stop sets the robot swinging
+    const float l_oldFeedrate = mechanics.feedrate_mm_s;
+    const float l_oldAcceleration = mechanics.data.acceleration, l_oldTravelAcceleration = mechanics.data.travel_acceleration;
+    if (parser.seenval('F'))
+        mechanics.feedrate_mm_s = MMM_TO_MMS(parser.value_linear_units());
+    if (parser.seenval('A'))
+        mechanics.data.acceleration = mechanics.data.travel_acceleration = parser.value_linear_units();
+
+    #if ENABLED(INPUT_SHAPING)
+        //The shaper would cancel the swing to be measured
+        const ShaperTypeEnum l_oldShaper = stepper.shaping_type;
+        if (l_oldShaper != SHAPER_NONE)
+        {
+            stepper.shaping_type = SHAPER_NONE;
+            stepper.set_input_shaping();
+        }
+    #endif
+
+    mechanics.set_destination_to_current();
+    mechanics.destination[X_AXIS] += l_distance;
+    #if !MECH(POLARGRAPH)
+        //Cords lengths, moving sideways shortens the other one
+        mechanics.destination[Y_AXIS] -= l_distance;
+    #endif
+    mechanics.prepare_move_to_destination();
+    mechanics.destination[X_AXIS] -= l_distance;
+    #if !MECH(POLARGRAPH)
+        mechanics.destination[Y_AXIS] += l_distance;
+    #endif
+    mechanics.prepare_move_to_destination();
+    planner.synchronize();
+
+    mechanics.feedrate_mm_s = l_oldFeedrate;
+    mechanics.data.acceleration = l_oldAcceleration;
+    mechanics.data.travel_acceleration = l_oldTravelAcceleration;
+
+    #if ENABLED(INPUT_SHAPING)
+        //Nothing moves while recording
+        if (l_oldShaper != SHAPER_NONE)
+        {
+            stepper.shaping_type = l_oldShaper;
+            stepper.set_input_shaping();
+        }
+    #endif
+
+    //Record at fixed rate, the printer is kept alive only when there is time before the next sample
+    uint16_t l_late = 0;
+    uint32_t l_next = micros();
+    for (uint16_t i = 0; i < l_count; i++)
+    {
+        while ((int32_t)(micros() - l_next) < 0)
+            watchdog.reset();
+        if ((int32_t)(micros() - l_next) > (int32_t)(l_period / 10))
+            l_late++;
+        l_next += l_period;
+
+        g_resonanceData[RES_GYRO_X][i] = constrain(LROUND(SIIMU.getXGyroscope() * SI_RESONANCE_GYRO_SCALE), -32767, 32767);
+        g_resonanceData[RES_GYRO_Y][i] = constrain(LROUND(SIIMU.getYGyroscope() * SI_RESONANCE_GYRO_SCALE), -32767, 32767);
+        g_resonanceData[RES_GYRO_Z][i] = constrain(LROUND(SIIMU.getZGyroscope() * SI_RESONANCE_GYRO_SCALE), -32767, 32767);
+        g_resonanceData[RES_ACC_X][i] = constrain(LROUND(SIIMU.getXAcc() * SI_RESONANCE_ACC_SCALE), -32767, 32767);
+        g_resonanceData[RES_ACC_Y][i] = constrain(LROUND(SIIMU.getYAcc() * SI_RESONANCE_ACC_SCALE), -32767, 32767);
+        g_resonanceData[RES_ACC_Z][i] = constrain(LROUND(SIIMU.getZAcc() * SI_RESONANCE_ACC_SCALE), -32767, 32767);
+
+        if ((int32_t)(l_next - micros()) > SI_RESONANCE_IDLE_SLACK)
+        {
+            printer.keepalive(InProcess);
+            printer.idle();
+        }
+    }
+
+    SERIAL_MV("Resonance samples:", l_count);
+    SERIAL_MV(" rate:", l_rate, 1);
+    SERIAL_EMV(" late:", l_late);
+
+    resonanceFit_t l_gyroFit = { 0 }, l_accFit = { 0 };
+    const float l_gyroQuality = resonanceReport("gyro ", RES_GYRO_X, RES_GYRO_Z, l_count, l_rate, l_gyroFit);
+    const float l_accQuality = resonanceReport("acc ", RES_ACC_X, RES_ACC_Z, l_count, l_rate, l_accFit);
+
+    #if ENABLED(INPUT_SHAPING)
+        //Suggest the shaper settings from the better fit
+        const resonanceFit_t &l_fit = l_gyroQuality >= l_accQuality ? l_gyroFit : l_accFit;
+        if (MAX(l_gyroQuality, l_accQuality) >= SI_RESONANCE_MIN_QUALITY)
+        {
+            const float l_omegaN = SQRT(l_fit.omega * l_fit.omega + l_fit.sigma * l_fit.sigma);
+            SERIAL_MV("Suggested: M593 F", l_omegaN * l_rate / (2 * M_PI), 3);
+            SERIAL_EMV(" D", MIN(l_fit.sigma / l_omegaN, 0.3f), 3);
+        }
+    #else
+        UNUSED(l_gyroQuality);
+        UNUSED(l_accQuality);
+    #endif
+}
+
+#endif // ENABLED(SWING_RESONANCE_MEASUREMENT)
@@ -0,0 +1,44 @@
+/**
+ * IMU drift correction Gcode
+ *
+ */
+
+#define CODE_M780
+
+/**
+ * M780: IMU drift correction
+ *
+ *  S<mode>  0 off, 1 measure and report each travel, 2 measure, report and correct
+ *  R        Restart from a new reference, forget the corrections
+ *
+ * The pitch is sampled while the pen is up, at pen down the error
+ * from the reference is reported and, with S2, corrected.
+ * The pitch model uses the mechanics nail distance (M665 D).
+ * Always reports the state.
+ */
+inline void gcode_M780(void)
+{
+    if (parser.seenval('S'))
+    {
+        const uint8_t l_mode = parser.value_byte();
+        if (l_mode > DRIFT_CORRECT)
+        {
+            SERIAL_LM(ER, "Invalid drift mode");
+            return;
+        }
+        SIDrift.setMode((driftMode_t)l_mode);
+    }
+
+    if (parser.seen('R'))
+        SIDrift.reset();
+
+    if (SIDrift.getMode() != DRIFT_OFF && SIIMU.getStatus() != IMU_SUCCESS)
+    {
+        SERIAL_STR(ER);
+        SERIAL_PS("IMU unavailable, error ");
+        SERIAL_CHR('0'+SIIMU.getStatus());
+        SERIAL_EOL();
+    }
+
+    SIDrift.report();
+}
@@ -33,7 +33,21 @@
  */
 inline void gcode_M78(void) {
   // "M78 S78" will reset the statistics
-  if (parser.seen('S') && parser.value_int() == 78)
+  if (parser.seen('S') && parser.value_int() == 78) {
     print_job_counter.initStats();
-  else print_job_counter.showStats();
+    #if ENABLED(SERIAL_ESP_TX_DMA)
+      serialDmaTx.resetStats();
+    #endif
+  }
+  else {
+    print_job_counter.showStats();
+    #if ENABLED(SERIAL_ESP_TX_DMA)
+      SERIAL_MV("Link TX max queued:", (int)serialDmaTx.maxQueued());
+      SERIAL_MV(" stalls:", serialDmaTx.stalled());
+      #if ENABLED(SERIAL_ESP_RX_DMA)
+        SERIAL_MV(" RX dropped:", serialDmaRx.dropped());
+      #endif
+      SERIAL_EOL();
+    #endif
+  }
 }
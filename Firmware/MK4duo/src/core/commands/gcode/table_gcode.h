@@ -330,7 +330,13 @@ constexpr GCode_command_t GCode_Table[] = {
     { 98, gcode_G98 },
   #endif
   #if ENABLED(CODE_G99)
-    { 99, gcode_G99 }
+    { 99, gcode_G99 },
+  #endif
+  #if ENABLED(CODE_G100)
+    { 100, gcode_G100 },
+  #endif
+  #if ENABLED(CODE_G101)
+    { 101, gcode_G101 },
   #endif
 
 };
@@ -0,0 +1,124 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * table_index.h
+ *
+ * Two level index of the G and M code tables, built at compile time.
+ *
+ * Code numbers are split in blocks of CODE_INDEX_BLOCK. For each block
+ * the index keeps the table position of its first code and a mask of
+ * the codes present, so the position of a code is the block start plus
+ * the codes present before it in the mask: one bounded lookup, no search.
+ * The index costs 3 bytes per block up to the highest code below
+ * CODE_INDEX_LIMIT (about 150 bytes for M codes up to M781), whatever
+ * the gaps between codes. Higher codes (M9999) are found by binary search.
+ */
+
+#define CODE_INDEX_NONE   0xFF
+#define CODE_INDEX_LIMIT  1000
+#define CODE_INDEX_BLOCK  16    // Codes per block, bits of the block mask
+
+// Position of a code in a sorted table, or CODE_INDEX_NONE
+template <typename T, size_t N>
+constexpr uint8_t code_index(const T (&table)[N], const uint16_t code, const size_t lo=0, const size_t hi=N) {
+  return lo >= hi                               ? CODE_INDEX_NONE
+       : table[(lo + hi) / 2].code == code      ? (lo + hi) / 2
+       : table[(lo + hi) / 2].code < code       ? code_index(table, code, (lo + hi) / 2 + 1, hi)
+                                                : code_index(table, code, lo, (lo + hi) / 2);
+}
+
+// Table codes strictly ascending, as code_index needs
+template <typename T, size_t N>
+constexpr bool code_sorted(const T (&table)[N], const size_t lo=0, const size_t hi=N) {
+  return hi - lo < 2 || (code_sorted(table, lo, (lo + hi) / 2)
+                     && table[(lo + hi) / 2 - 1].code < table[(lo + hi) / 2].code
+                     && code_sorted(table, (lo + hi) / 2, hi));
+}
+
+// Position of the first code not below code, N if none
+template <typename T, size_t N>
+constexpr uint8_t code_lower_bound(const T (&table)[N], const uint16_t code, const size_t lo=0, const size_t hi=N) {
+  return lo >= hi                               ? lo
+       : table[(lo + hi) / 2].code < code       ? code_lower_bound(table, code, (lo + hi) / 2 + 1, hi)
+                                                : code_lower_bound(table, code, lo, (lo + hi) / 2);
+}
+
+// Mask of the codes of a block, from the first one at position i
+template <typename T, size_t N>
+constexpr uint16_t code_block_mask(const T (&table)[N], const size_t block, const size_t i) {
+  return i >= N || table[i].code >= (block + 1) * CODE_INDEX_BLOCK ? 0
+       : (1U << (table[i].code % CODE_INDEX_BLOCK)) | code_block_mask(table, block, i + 1);
+}
+
+// Index blocks, up to the highest code below CODE_INDEX_LIMIT
+template <typename T, size_t N>
+constexpr size_t code_index_size(const T (&table)[N], const size_t i=N) {
+  return i == 0 ? 1 : table[i - 1].code < CODE_INDEX_LIMIT ? table[i - 1].code / CODE_INDEX_BLOCK + 1 : code_index_size(table, i - 1);
+}
+
+// 0, 1, ... N-1 in log(N) template depth
+template <size_t... I> struct code_seq { };
+template <typename A, typename B> struct code_seq_cat;
+template <size_t... A, size_t... B> struct code_seq_cat<code_seq<A...>, code_seq<B...>> { typedef code_seq<A..., (sizeof...(A) + B)...> type; };
+template <size_t N> struct make_code_seq {
+  typedef typename code_seq_cat<typename make_code_seq<N / 2>::type, typename make_code_seq<N - N / 2>::type>::type type;
+};
+template <> struct make_code_seq<0> { typedef code_seq<> type; };
+template <> struct make_code_seq<1> { typedef code_seq<0> type; };
+
+// Index of the table FIND::table(), one start and one mask per block
+template <typename FIND, typename SEQ> struct Code_Index;
+template <typename FIND, size_t... I> struct Code_Index<FIND, code_seq<I...>> {
+  static constexpr uint8_t  start[] = { code_lower_bound(FIND::table(), I * CODE_INDEX_BLOCK)... };
+  static constexpr uint16_t mask[]  = { code_block_mask(FIND::table(), I, code_lower_bound(FIND::table(), I * CODE_INDEX_BLOCK))... };
+
+  // Position of a code in FIND::table(), or CODE_INDEX_NONE
+  static inline uint8_t position(const uint16_t code) {
+    const uint16_t block = code / CODE_INDEX_BLOCK;
+    if (block >= COUNT(mask)) return code_index(FIND::table(), code);
+    const uint16_t bit = 1U << (code % CODE_INDEX_BLOCK);
+    return (mask[block] & bit) ? start[block] + __builtin_popcount(mask[block] & (bit - 1)) : CODE_INDEX_NONE;
+  }
+};
+template <typename FIND, size_t... I> constexpr uint8_t  Code_Index<FIND, code_seq<I...>>::start[];
+template <typename FIND, size_t... I> constexpr uint16_t Code_Index<FIND, code_seq<I...>>::mask[];
+
+struct GCode_Find { static constexpr const decltype(GCode_Table) &table() { return GCode_Table; } };
+struct MCode_Find { static constexpr const decltype(MCode_Table) &table() { return MCode_Table; } };
+
+typedef Code_Index<GCode_Find, make_code_seq<code_index_size(GCode_Table)>::type> GCode_Index;
+typedef Code_Index<MCode_Find, make_code_seq<code_index_size(MCode_Table)>::type> MCode_Index;
+
+static_assert(COUNT(GCode_Table) < CODE_INDEX_NONE && COUNT(MCode_Table) < CODE_INDEX_NONE, "Too many G or M codes for table_index.h.");
+static_assert(code_sorted(GCode_Table) && code_sorted(MCode_Table), "G and M code tables must be in ascending order.");
+
+// Handler of a G or M code, NULL if not available
+FORCE_INLINE command_t gcode_command(const uint16_t code) {
+  const uint8_t i = GCode_Index::position(code);
+  return i == CODE_INDEX_NONE ? (command_t)NULL : GCode_Table[i].command;
+}
+FORCE_INLINE command_t mcode_command(const uint16_t code) {
+  const uint8_t i = MCode_Index::position(code);
+  return i == CODE_INDEX_NONE ? (command_t)NULL : MCode_Table[i].command;
+}
@@ -42,6 +42,11 @@ char *GCodeParser::command_ptr,
      *GCodeParser::string_arg,
      *GCodeParser::value_ptr;
 
+#if ENABLED(COMPACT_COMMAND_QUEUE)
+  const gcode_t *GCodeParser::packed;
+  bool GCodeParser::value_is_fixed;
+#endif
+
 char  GCodeParser::command_letter;
 
 uint16_t GCodeParser::codenum;
@@ -52,22 +57,26 @@ uint16_t GCodeParser::codenum;
 
 #if ENABLED(FASTER_GCODE_PARSER)
   // Optimized Parameters
-  uint32_t  GCodeParser::codebits;  // found bits
-  uint8_t   GCodeParser::param[26]; // parameter offsets from command_ptr
-#else
-  char *GCodeParser::command_args; // start of parameters
+  uint32_t  GCodeParser::codebits;                    // found bits
+  uint8_t   GCodeParser::param[FASTER_GCODE_PARAMS],  // parameter offsets from command_ptr, in letter order
+            GCodeParser::param_count;                 // parameter offsets stored
 #endif
 
+char *GCodeParser::command_args; // start of parameters
+
 // Create a global instance of the GCodeParser singleton
 GCodeParser parser;
 
 /**
  * Clear all code-seen (and value pointers)
  *
- * Since each param is set/cleared on seen codes,
- * this may be optimized by commenting out ZERO(param)
+ * Parameter offsets are only read for codebits set,
+ * so param[] doesn't need to be cleared
  */
 void GCodeParser::reset() {
+  #if ENABLED(COMPACT_COMMAND_QUEUE)
+    packed = NULL;                    // Text line
+  #endif
   string_arg = NULL;                  // No whole line argument
   command_letter = '?';               // No command letter
   codenum = 0;                        // No command code
@@ -76,7 +85,7 @@ void GCodeParser::reset() {
   #endif
   #if ENABLED(FASTER_GCODE_PARSER)
     codebits = 0;                     // No codes yet
-    //ZERO(param);                    // No parameters (should be safe to comment out this line)
+    param_count = 0;                  // No parameters
   #endif
 }
 // Populate all fields by parsing a single line of GCode
@@ -145,9 +154,7 @@ void GCodeParser::parse(char *p) {
 
   // The command parameters (if any) start here, for sure!
 
-  #if DISABLED(FASTER_GCODE_PARSER)
-    command_args = p; // Scan for parameters in seen()
-  #endif
+  command_args = p; // Scan for parameters in seen(), or when out of param slots
 
   // Only use string_arg for these M codes
   if (letter == 'M') switch (codenum) { case 23: case 28: case 30: case 117: case 118: case 928: string_arg = p; return; default: break; }
@@ -226,6 +233,173 @@ void GCodeParser::parse(char *p) {
   }
 }
 
+bool GCodeParser::scan_number(const char * &p, int32_t &value, bool &is_fixed, const bool round/*=false*/) {
+
+  const bool neg = *p == '-';
+  if (*p == '-' || *p == '+') ++p;
+
+  uint32_t num = 0;
+  while (NUMERIC(*p)) {
+    if (num > (INT32_MAX - 9) / 10) return false;
+    num = num * 10 + (*p++ - '0');
+  }
+
+  is_fixed = *p == '.';
+  if (is_fixed) {
+    ++p;
+    uint32_t frac = 0;
+    for (uint8_t d = 0; d < GCODE_FIXED_DECIMALS; d++) {
+      frac *= 10;
+      if (NUMERIC(*p)) frac += *p++ - '0';
+    }
+    if (NUMERIC(*p)) {
+      if (!round) return false;
+      if (*p >= '5') frac++;
+      while (NUMERIC(*p)) ++p;
+    }
+    if (num > (INT32_MAX - frac) / GCODE_FIXED_SCALE) return false;
+    num = num * GCODE_FIXED_SCALE + frac;
+  }
+
+  value = neg ? -(int32_t)num : (int32_t)num;
+  return true;
+}
+
+#if ENABLED(COMPACT_COMMAND_QUEUE)
+
+  void GCodeParser::parse(const gcode_t &cmd) {
+    static char empty[] = "";
+    packed = &cmd;
+    command_ptr = command_args = empty;
+    string_arg = NULL;
+    command_letter = cmd.letter;
+    codenum = cmd.codenum;
+    #if USE_GCODE_SUBCODES
+      subcode = cmd.subcode;
+    #endif
+  }
+
+  /**
+   * Same rules as parse(), any case it would handle with
+   * string_arg or by scanning the text gives false.
+   */
+  bool GCodeParser::pack(const char * p, gcode_t &cmd) {
+
+    cmd.codebits = 0;
+    cmd.fixbits = cmd.subcode = 0;
+
+    // Skip spaces
+    while (*p == ' ') ++p;
+
+    // Skip N[-0-9] if included in the command line
+    #if ENABLED(ADVANCED_OK)
+      cmd.has_line = false;
+    #endif
+    if (*p == 'N' && NUMERIC_SIGNED(p[1])) {
+      #if ENABLED(ADVANCED_OK)
+        cmd.line = strtol(p + 1, NULL, 10);
+        cmd.has_line = true;
+      #endif
+      p += 2;
+      while (NUMERIC(*p)) ++p;
+      while (*p == ' ') ++p;
+    }
+
+    // Command letter, G, M, or T
+    const char letter = *p++;
+    switch (letter) { case 'G': case 'M': case 'T': break; default: return false; }
+
+    while (*p == ' ') ++p;
+    if (!NUMERIC(*p)) return false;
+
+    uint16_t code = 0;
+    do {
+      code = code * 10 + (*p++ - '0');
+    } while (NUMERIC(*p));
+
+    #if USE_GCODE_SUBCODES
+      if (*p == '.') {
+        p++;
+        while (NUMERIC(*p)) cmd.subcode = cmd.subcode * 10 + (*p++ - '0');
+      }
+    #endif
+
+    // Codes using string_arg
+    if (letter == 'M') switch (code) { case 23: case 28: case 30: case 32: case 117: case 118: case 928: return false; default: break; }
+
+    cmd.letter = letter;
+    cmd.codenum = code;
+
+    uint8_t count = 0;
+    for (;;) {
+
+      while (*p == ' ') ++p;
+
+      const char param = *p++;
+      if (param == '\0' || param == '*') break;   // End or checksum
+      if (!WITHIN(param, 'A', 'Z')) return false;
+
+      const uint8_t ind = LETTER_BIT(param);
+      if (TEST32(cmd.codebits, ind)) return false;
+
+      if (!valid_float(p)) return false;          // No value, or after spaces, differs among parsers
+      if (count >= COMMAND_VALUES) return false;
+
+      int32_t num;
+      bool fixed;
+      if (!scan_number(p, num, fixed, true)) return false;
+
+      // A value ends at a space, the checksum or the next parameter
+      if (*p && *p != ' ' && *p != '*' && !WITHIN(*p, 'A', 'Z')) return false;
+
+      // Keep the values in letter order
+      const uint8_t slot = __builtin_popcount(cmd.codebits & (_BV32(ind) - 1));
+      for (uint8_t i = count; i > slot; i--) cmd.value[i] = cmd.value[i - 1];
+      cmd.fixbits = (cmd.fixbits & (_BV(slot) - 1)) | ((cmd.fixbits >> slot) << (slot + 1));
+      if (fixed) SBI(cmd.fixbits, slot);
+      cmd.value[slot] = num;
+      SBI32(cmd.codebits, ind);
+      count++;
+    }
+
+    return true;
+  }
+
+  void GCodeParser::unpack(const gcode_t &cmd, char * buffer) {
+    char *p = buffer;
+    *p++ = cmd.letter;
+    p += sprintf_P(p, PSTR("%u"), cmd.codenum);
+    #if USE_GCODE_SUBCODES
+      if (cmd.subcode) p += sprintf_P(p, PSTR(".%u"), cmd.subcode);
+    #endif
+    uint8_t slot = 0;
+    for (uint8_t ind = 0; ind < 26; ind++) {
+      if (!TEST32(cmd.codebits, ind)) continue;
+      *p++ = ' ';
+      *p++ = 'A' + ind;
+      const int32_t v = cmd.value[slot];
+      if (!TEST(cmd.fixbits, slot))
+        p += sprintf_P(p, PSTR("%ld"), (long)v);
+      else {
+        // Integer part, then decimals without trailing zeros
+        const uint32_t a = v < 0 ? -v : v;
+        p += sprintf_P(p, PSTR("%s%lu"), v < 0 ? "-" : "", (unsigned long)(a / GCODE_FIXED_SCALE));
+        uint32_t frac = a % GCODE_FIXED_SCALE;
+        if (frac) {
+          *p++ = '.';
+          for (uint32_t d = GCODE_FIXED_SCALE / 10; frac; d /= 10) {
+            *p++ = '0' + frac / d;
+            frac %= d;
+          }
+        }
+      }
+      slot++;
+    }
+    *p = '\0';
+  }
+
+#endif // COMPACT_COMMAND_QUEUE
+
 pin_t GCodeParser::value_pin() {
   const pin_t pin = (int8_t)value_int();
   return printer.pin_is_protected(pin) ? NoPin : pin;
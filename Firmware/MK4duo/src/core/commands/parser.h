@@ -35,12 +35,25 @@
  *  - Parse a single gcode line for its letter, code, subcode, and parameters
  *  - FASTER_GCODE_PARSER:
  *    - Flags existing params (1 bit each)
- *    - Stores value offsets (1 byte each)
+ *    - Stores value offsets (1 byte each) of up to FASTER_GCODE_PARAMS
+ *      params in letter order, lines with more are scanned as without it
  *  - Provide accessors for parameters:
  *    - Parameter exists
  *    - Parameter has value
  *    - Parameter value in different units and types
+ *  - COMPACT_COMMAND_QUEUE:
+ *    - Pack a line into a gcode_t when it is queued
+ *    - Provide the same accessors on a packed command
  */
+
+#if ENABLED(FASTER_GCODE_PARSER) && !defined(FASTER_GCODE_PARAMS)
+  #define FASTER_GCODE_PARAMS 26
+#endif
+
+// Fixed point values are stored as value * GCODE_FIXED_SCALE
+#define GCODE_FIXED_SCALE     10000
+#define GCODE_FIXED_DECIMALS  4
+
 class GCodeParser {
 
   public: /** Public Parameters */
@@ -56,9 +69,13 @@ class GCodeParser {
     #endif
 
     // Command line state
-    static char *command_ptr,     // The command, so it can be echoed
+    static char *command_ptr,     // The command, so it can be echoed (empty for a packed command)
                 *string_arg;      // string of command line
 
+    #if ENABLED(COMPACT_COMMAND_QUEUE)
+      static const gcode_t *packed; // The packed command, NULL for a text line
+    #endif
+
     static char command_letter;  // G, M, or T
 
     static uint16_t codenum;      // 123
@@ -71,13 +88,18 @@ class GCodeParser {
 
     static char *value_ptr;       // Set by seen, used to fetch the value
 
+    #if ENABLED(COMPACT_COMMAND_QUEUE)
+      static bool value_is_fixed; // Packed value set by seen is in fixed point
+    #endif
+
     #if ENABLED(FASTER_GCODE_PARSER)
-      static uint32_t codebits;   // Parameters pre-scanned
-      static uint8_t param[26];   // For A-Z, offsets into command args
-    #else
-      static char *command_args;  // Args start here, for slow scan
+      static uint32_t codebits;                   // Parameters pre-scanned
+      static uint8_t  param[FASTER_GCODE_PARAMS], // Offsets into command args of the codebits params, in letter order
+                      param_count;                // Offsets stored, more than FASTER_GCODE_PARAMS if some didn't fit
     #endif
 
+    static char *command_args;    // Args start here, for slow scan
+
   public: /** Public Function */
 
     #if ENABLED(DEBUG_GCODE_PARSER)
@@ -101,20 +123,84 @@ class GCodeParser {
       return NUMERIC(p[0]) || ((p[0] == '-' || p[0] == '+') && NUMERIC(p[1])); // [-+]?[0-9]
     }
 
+    /**
+     * Scan [-+]?[0-9]*(.[0-9]*)? at p, leaving p after it.
+     * Without a decimal point value is the integer and is_fixed is false,
+     * else value is scaled by GCODE_FIXED_SCALE. Decimals past
+     * GCODE_FIXED_DECIMALS are rounded if round is set.
+     * Return false on overflow or on decimals not rounded.
+     * No float operation, the SAMD21 has no FPU.
+     */
+    static bool scan_number(const char * &p, int32_t &value, bool &is_fixed, const bool round=false);
+
+    // Integer part and decimals converted apart. The division and the
+    // sum round once each, so the result is within one ULP of the text
+    // value: it may differ from strtof by one ULP (about 1 in 2000 values)
+    FORCE_INLINE static float fixed_to_float(const int32_t v) {
+      return float(v / GCODE_FIXED_SCALE) + float(v % GCODE_FIXED_SCALE) / float(GCODE_FIXED_SCALE);
+    }
+
+    #if ENABLED(COMPACT_COMMAND_QUEUE)
+
+      // Code seen bit was set in the packed command, every packed parameter has a value.
+      // value_ptr points to the value, so has_value() works as for text.
+      static inline bool seen_packed(const char c) {
+        const uint8_t ind = LETTER_BIT(c);
+        if (ind >= 26) return false;                // Only A-Z
+        const bool b = TEST32(packed->codebits, ind);
+        if (b) {
+          const uint8_t slot = __builtin_popcount(packed->codebits & (_BV32(ind) - 1));
+          value_ptr = (char*)&packed->value[slot];
+          value_is_fixed = TEST(packed->fixbits, slot);
+        }
+        return b;
+      }
+
+      FORCE_INLINE static int32_t value_packed() { return *(const int32_t*)value_ptr; }
+
+      static inline float value_packed_float() {
+        const int32_t v = value_packed();
+        return value_is_fixed ? fixed_to_float(v) : float(v);
+      }
+
+      #define PACKED_SEEN(STR) if (packed) return !!(packed->codebits & letter_mask(STR))
+
+      FORCE_INLINE static constexpr uint32_t letter_mask(const char * const str) {
+        return str[0] ? _BV32(LETTER_BIT(str[0])) | letter_mask(str + 1) : 0;
+      }
+
+    #else
+
+      #define PACKED_SEEN(STR) NOOP
+
+    #endif
+
     #if ENABLED(FASTER_GCODE_PARSER)
 
+      // Index in param[] of a parameter
+      FORCE_INLINE static uint8_t param_slot(const uint8_t ind) { return __builtin_popcount(codebits & (_BV32(ind) - 1)); }
+
       // Set the flag and pointer for a parameter
       static inline void set(const char c, char * const ptr) {
         const uint8_t ind = LETTER_BIT(c);
-        if (ind >= COUNT(param)) return;           // Only A-Z
-        SBI32(codebits, ind);                      // parameter exists
-        param[ind] = ptr ? ptr - command_ptr : 0;  // parameter offset or 0
+        if (ind >= 26) return;                            // Only A-Z
+        const uint8_t slot = param_slot(ind);
+        if (!TEST32(codebits, ind)) {
+          SBI32(codebits, ind);                           // parameter exists
+          if (param_count >= FASTER_GCODE_PARAMS) {       // No room, seen() will scan
+            param_count = FASTER_GCODE_PARAMS + 1;
+            return;
+          }
+          for (uint8_t i = param_count++; i > slot; i--) param[i] = param[i - 1];
+        }
+        else if (param_count > FASTER_GCODE_PARAMS) return;
+        param[slot] = ptr ? ptr - command_ptr : 0;        // parameter offset or 0
         #if ENABLED(DEBUG_GCODE_PARSER)
           if (codenum == 800) {
             SERIAL_MV("Set bit ", (int)ind);
             SERIAL_MV(" of codebits (", hex_address((void*)(codebits >> 16)));
             print_hex_word((uint16_t)(codebits & 0xFFFF));
-            SERIAL_EMV(" | param = ",(int)param[ind]);
+            SERIAL_EMV(" | param = ",(int)param[slot]);
           }
         #endif
       }
@@ -122,12 +208,17 @@ class GCodeParser {
       // Code seen bit was set. If not found, value_ptr is unchanged.
       // This allows "if (seen('A')||seen('B'))" to use the last-found value.
       static inline bool seen(const char c) {
+        #if ENABLED(COMPACT_COMMAND_QUEUE)
+          if (packed) return seen_packed(c);
+        #endif
         const uint8_t ind = LETTER_BIT(c);
-        if (ind >= COUNT(param)) return false; // Only A-Z
+        if (ind >= 26) return false; // Only A-Z
         const bool b = TEST32(codebits, ind);
         if (b) {
-          char * const ptr = command_ptr + param[ind];
-          value_ptr = param[ind] && valid_float(ptr) ? ptr : (char*)NULL;
+          if (param_count > FASTER_GCODE_PARAMS) return seen_scan(c);
+          const uint8_t offset = param[param_slot(ind)];
+          char * const ptr = command_ptr + offset;
+          value_ptr = offset && valid_float(ptr) ? ptr : (char*)NULL;
         }
         return b;
       }
@@ -148,10 +239,11 @@ class GCodeParser {
 
       // At least one of a list of code letters was seen
       #if ENABLED(CPU_32_BIT)
-        FORCE_INLINE static bool seen(const char * const str) { return !!(codebits & letter_bits(str)); }
+        FORCE_INLINE static bool seen(const char * const str) { PACKED_SEEN(str); return !!(codebits & letter_bits(str)); }
       #else
         // At least one of a list of code letters was seen
         FORCE_INLINE static bool seen(const char * const str) {
+          PACKED_SEEN(str);
           const uint32_t letrbits = letter_bits(str);
           const uint8_t * const cb = (uint8_t*)&codebits;
           const uint8_t * const lb = (uint8_t*)&letrbits;
@@ -159,28 +251,36 @@ class GCodeParser {
         }
       #endif
 
-      static inline bool seen_any() { return !!codebits; }
+      static inline bool seen_any() {
+        #if ENABLED(COMPACT_COMMAND_QUEUE)
+          if (packed) return !!packed->codebits;
+        #endif
+        return !!codebits;
+      }
 
       #define SEEN_TEST(L) TEST32(codebits, LETTER_BIT(L))
 
     #else // !FASTER_GCODE_PARSER
 
-      // Code is found in the string. If not found, value_ptr is unchanged.
-      // This allows "if (seen('A')||seen('B'))" to use the last-found value.
-      // p DEVE ESSERE CHAR e non CONST CHAR
       static inline bool seen(const char c) {
-        char *p = strchr(command_args, c);
-        const bool b = !!p;
-        if (b) value_ptr = valid_float(&p[1]) ? &p[1] : (char*)NULL;
-        return b;
+        #if ENABLED(COMPACT_COMMAND_QUEUE)
+          if (packed) return seen_packed(c);
+        #endif
+        return seen_scan(c);
       }
 
-      static inline bool seen_any() { return *command_args == '\0'; }
+      static inline bool seen_any() {
+        #if ENABLED(COMPACT_COMMAND_QUEUE)
+          if (packed) return !!packed->codebits;
+        #endif
+        return *command_args == '\0';
+      }
 
       #define SEEN_TEST(L) !!strchr(command_args, L)
 
       // At least one of a list of code letters was seen
       static inline bool seen(const char * const str) {
+        PACKED_SEEN(str);
         for (uint8_t i = 0; const char c = str[i]; i++)
           if (SEEN_TEST(c)) return true;
         return false;
@@ -188,8 +288,20 @@ class GCodeParser {
 
     #endif // !FASTER_GCODE_PARSER
 
+    // Code is found in the string. If not found, value_ptr is unchanged.
+    // This allows "if (seen('A')||seen('B'))" to use the last-found value.
+    // Slow scan, also the reference for FASTER_GCODE_PARSER.
+    // p DEVE ESSERE CHAR e non CONST CHAR
+    static inline bool seen_scan(const char c) {
+      char *p = strchr(command_args, c);
+      const bool b = !!p;
+      if (b) value_ptr = valid_float(&p[1]) ? &p[1] : (char*)NULL;
+      return b;
+    }
+
     // Seen any axis parameter
     static inline bool seen_axis() {
+      PACKED_SEEN("XYZE");
       return SEEN_TEST('X') || SEEN_TEST('Y') || SEEN_TEST('Z') || SEEN_TEST('E');
     }
 
@@ -197,14 +309,49 @@ class GCodeParser {
     // This uses 54 bytes of SRAM to speed up seen/value
     static void parse(char * p);
 
+    #if ENABLED(COMPACT_COMMAND_QUEUE)
+
+      // Populate all fields from a packed command, no text is scanned
+      static void parse(const gcode_t &cmd);
+
+      /**
+       * Pack a line into cmd, leaving s_port and text alone.
+       * Return false if the line must be kept as text:
+       *  - not a G, M, or T command, or a command using string_arg
+       *  - parameters not uppercase, without value, or repeated
+       *  - more than COMMAND_VALUES values, or a value out of range
+       * Decimals past GCODE_FIXED_DECIMALS are rounded.
+       */
+      static bool pack(const char * p, gcode_t &cmd);
+
+      // Rebuild the text of a packed command in a MAX_CMD_SIZE buffer
+      static void unpack(const gcode_t &cmd, char * buffer);
+
+    #endif
+
     // Code value pointer was set
     FORCE_INLINE static bool has_value() { return value_ptr != NULL; }
 
     // Seen a parameter with a value
     static inline bool seenval(const char c) { return seen(c) && has_value(); }
 
-    // Float removes 'E' to prevent scientific notation interpretation
+    // Fixed point scan for the usual values, strtof for the others
     static inline float value_float() {
+      #if ENABLED(COMPACT_COMMAND_QUEUE)
+        if (packed) return value_ptr ? value_packed_float() : 0;
+      #endif
+      if (value_ptr) {
+        const char *p = value_ptr;
+        int32_t v;
+        bool is_fixed;
+        if (scan_number(p, v, is_fixed) && (*p == '\0' || *p == ' ' || WITHIN(*p, 'A', 'Z')))
+          return is_fixed ? fixed_to_float(v) : float(v);
+      }
+      return value_float_strtof();
+    }
+
+    // Float removes 'E' to prevent scientific notation interpretation
+    static inline float value_float_strtof() {
       if (value_ptr) {
         char *e = value_ptr;
         for (;;) {
@@ -224,8 +371,20 @@ class GCodeParser {
     }
 
     // Code value as a long or ulong
-    static inline int32_t   value_long()  { return value_ptr ? strtol(value_ptr, NULL, 10) : 0L; }
-    static inline uint32_t  value_ulong() { return value_ptr ? strtoul(value_ptr, NULL, 10) : 0UL; }
+    #if ENABLED(COMPACT_COMMAND_QUEUE)
+      // Fixed point values truncate toward zero, as strtol does
+      static inline int32_t   value_long()  {
+        if (packed) return value_ptr ? (value_is_fixed ? value_packed() / GCODE_FIXED_SCALE : value_packed()) : 0L;
+        return value_ptr ? strtol(value_ptr, NULL, 10) : 0L;
+      }
+      static inline uint32_t  value_ulong() {
+        if (packed) return (uint32_t)value_long();
+        return value_ptr ? strtoul(value_ptr, NULL, 10) : 0UL;
+      }
+    #else
+      static inline int32_t   value_long()  { return value_ptr ? strtol(value_ptr, NULL, 10) : 0L; }
+      static inline uint32_t  value_ulong() { return value_ptr ? strtoul(value_ptr, NULL, 10) : 0UL; }
+    #endif
 
     // Code value for use as time
     static inline millis_t  value_millis()              { return value_ulong(); }
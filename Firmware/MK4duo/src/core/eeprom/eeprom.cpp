@@ -252,6 +252,15 @@ typedef struct EepromDataStruct {
                       stepper_maximum_rate;
   uint8_t             stepper_minimum_pulse;
 
+  //
+  // Input Shaping
+  //
+  #if ENABLED(INPUT_SHAPING)
+    ShaperTypeEnum    stepper_shaping_type;
+    float             stepper_shaping_frequency,
+                      stepper_shaping_damping;
+  #endif
+
   //
   // Sound
   //
@@ -666,6 +675,15 @@ void EEPROM::post_process() {
     EEPROM_WRITE(stepper.minimum_pulse);
     EEPROM_WRITE(stepper.maximum_rate);
 
+    //
+    // Input Shaping
+    //
+    #if ENABLED(INPUT_SHAPING)
+      EEPROM_WRITE(stepper.shaping_type);
+      EEPROM_WRITE(stepper.shaping_frequency);
+      EEPROM_WRITE(stepper.shaping_damping);
+    #endif
+
     //
     // Sound
     //
@@ -1117,6 +1135,16 @@ void EEPROM::post_process() {
       EEPROM_READ(stepper.minimum_pulse);
       EEPROM_READ(stepper.maximum_rate);
 
+      //
+      // Input Shaping
+      //
+      #if ENABLED(INPUT_SHAPING)
+        EEPROM_READ(stepper.shaping_type);
+        EEPROM_READ(stepper.shaping_frequency);
+        EEPROM_READ(stepper.shaping_damping);
+        if (!validating) stepper.set_input_shaping();
+      #endif
+
       //
       // Sound
       //
@@ -2231,6 +2259,16 @@ void EEPROM::reset() {
     SERIAL_MV(" R", stepper.maximum_rate);
     SERIAL_EOL();
 
+    /**
+     * Input Shaping
+     */
+    #if ENABLED(INPUT_SHAPING)
+      SERIAL_LM(CFG, "Input Shaping");
+      SERIAL_SMV(CFG, "  M593 T", (int)stepper.shaping_type);
+      SERIAL_MV(" F", stepper.shaping_frequency, 2);
+      SERIAL_EMV(" D", stepper.shaping_damping, 2);
+    #endif
+
     /**
      * Alligator current drivers M906
      */
@@ -29,7 +29,14 @@
 #pragma once
 
 // Struct Cartesian Settings
-typedef struct : public generic_data_t {} mechanics_data_t;
+#if ENABLED(POLARGRAPH_NAIL_DISTANCE)
+  // Robot hanging from two nails, with the cords as X and Y (Scribit)
+  typedef struct : public generic_data_t {
+    float nail_distance;
+  } mechanics_data_t;
+#else
+  typedef struct : public generic_data_t {} mechanics_data_t;
+#endif
 
 class Cartesian_Mechanics : public Mechanics {
 
@@ -127,6 +134,7 @@ class Cartesian_Mechanics : public Mechanics {
      *
      * The arc is approximated by generating many small linear segments.
      * The length of each segment is configured in MM_PER_ARC_SEGMENT (Default 1mm)
+     * or, with ARC_CHORD_TOLERANCE, sized by Mechanics::arc_segments.
      * Arcs should only be made relatively large (over 5mm), as larger arcs with
      * larger segments will tend to be more efficient. Your slicer should have
      * options for G2/G3 arc generation. In future these options may be GCode tunable.
@@ -569,6 +569,7 @@
      *
      * The arc is approximated by generating many small linear segments.
      * The length of each segment is configured in MM_PER_ARC_SEGMENT (Default 1mm)
+     * or, with ARC_CHORD_TOLERANCE, sized by Mechanics::arc_segments.
      * Arcs should only be made relatively large (over 5mm), as larger arcs with
      * larger segments will tend to be more efficient. Your slicer should have
      * options for G2/G3 arc generation. In future these options may be GCode tunable.
@@ -615,8 +616,9 @@
                   mm_of_travel = linear_travel ? HYPOT(flat_mm, linear_travel) : ABS(flat_mm);
       if (mm_of_travel < 0.001f) return;
 
-      uint16_t segments = FLOOR(mm_of_travel / (MM_PER_ARC_SEGMENT));
-      if (segments == 0) segments = 1;
+      const float fr_mm_s = MMS_SCALED(feedrate_mm_s);
+
+      const uint16_t segments = arc_segments(radius, mm_of_travel, fr_mm_s);
 
       /**
        * Vector rotation by transformation matrix: r is the original vector, r_T is the rotated vector,
@@ -648,9 +650,14 @@
       float raw[XYZE];
       const float theta_per_segment = angular_travel / segments,
                   linear_per_segment = linear_travel / segments,
-                  extruder_per_segment = extruder_travel / segments,
-                  sin_T = theta_per_segment,
-                  cos_T = 1 - 0.5f * sq(theta_per_segment); // Small angle approximation
+                  extruder_per_segment = extruder_travel / segments;
+
+      #if ENABLED(ARC_CHORD_TOLERANCE)
+        arc_rotation_t rotation(offset, radius, theta_per_segment);
+      #else
+        const float sin_T = theta_per_segment,
+                    cos_T = 1 - 0.5f * sq(theta_per_segment); // Small angle approximation
+      #endif
 
       // Initialize the linear axis
       raw[l_axis] = current_position[l_axis];
@@ -658,11 +665,9 @@
       // Initialize the extruder axis
       raw[E_AXIS] = current_position[E_AXIS];
 
-      const float fr_mm_s = MMS_SCALED(feedrate_mm_s);
-
       millis_t next_idle_ms = millis() + 200UL;
 
-      #if N_ARC_CORRECTION > 1
+      #if DISABLED(ARC_CHORD_TOLERANCE) && N_ARC_CORRECTION > 1
         int8_t arc_recalc_count = N_ARC_CORRECTION;
       #endif
 
@@ -674,29 +679,33 @@
           printer.idle();
         }
 
-        #if N_ARC_CORRECTION > 1
-          if (--arc_recalc_count) {
-            // Apply vector rotation matrix to previous r_P / 1
-            const float r_new_Y = r_P * sin_T + r_Q * cos_T;
-            r_P = r_P * cos_T - r_Q * sin_T;
-            r_Q = r_new_Y;
-          }
-          else
-        #endif
-        {
+        #if ENABLED(ARC_CHORD_TOLERANCE)
+          rotation.next(r_P, r_Q);
+        #else
           #if N_ARC_CORRECTION > 1
-            arc_recalc_count = N_ARC_CORRECTION;
+            if (--arc_recalc_count) {
+              // Apply vector rotation matrix to previous r_P / 1
+              const float r_new_Y = r_P * sin_T + r_Q * cos_T;
+              r_P = r_P * cos_T - r_Q * sin_T;
+              r_Q = r_new_Y;
+            }
+            else
           #endif
+          {
+            #if N_ARC_CORRECTION > 1
+              arc_recalc_count = N_ARC_CORRECTION;
+            #endif
 
-          // Arc correction to radius vector. Computed only every N_ARC_CORRECTION increments.
-          // Compute exact location by applying transformation matrix from initial radius vector(=-offset).
-          // To reduce stuttering, the sin and cos could be computed at different times.
-          // For now, compute both at the same time.
-          const float cos_Ti = cos(i * theta_per_segment),
-                      sin_Ti = sin(i * theta_per_segment);
-          r_P = -offset[0] * cos_Ti + offset[1] * sin_Ti;
-          r_Q = -offset[0] * sin_Ti - offset[1] * cos_Ti;
-        }
+            // Arc correction to radius vector. Computed only every N_ARC_CORRECTION increments.
+            // Compute exact location by applying transformation matrix from initial radius vector(=-offset).
+            // To reduce stuttering, the sin and cos could be computed at different times.
+            // For now, compute both at the same time.
+            const float cos_Ti = cos(i * theta_per_segment),
+                        sin_Ti = sin(i * theta_per_segment);
+            r_P = -offset[0] * cos_Ti + offset[1] * sin_Ti;
+            r_Q = -offset[0] * sin_Ti - offset[1] * cos_Ti;
+          }
+        #endif
 
         // Update raw location
         raw[p_axis] = center_P + r_P;
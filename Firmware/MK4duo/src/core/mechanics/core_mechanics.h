@@ -115,6 +115,7 @@ class Core_Mechanics: public Mechanics {
      *
      * The arc is approximated by generating many small linear segments.
      * The length of each segment is configured in MM_PER_ARC_SEGMENT (Default 1mm)
+     * or, with ARC_CHORD_TOLERANCE, sized by Mechanics::arc_segments.
      * Arcs should only be made relatively large (over 5mm), as larger arcs with
      * larger segments will tend to be more efficient. Your slicer should have
      * options for G2/G3 arc generation. In future these options may be GCode tunable.
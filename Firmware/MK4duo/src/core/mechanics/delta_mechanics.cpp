@@ -766,6 +766,7 @@
      *
      * The arc is approximated by generating many small linear segments.
      * The length of each segment is configured in MM_PER_ARC_SEGMENT (Default 1mm)
+     * or, with ARC_CHORD_TOLERANCE, sized by Mechanics::arc_segments.
      * Arcs should only be made relatively large (over 5mm), as larger arcs with
      * larger segments will tend to be more efficient. Your slicer should have
      * options for G2/G3 arc generation. In future these options may be GCode tunable.
@@ -800,8 +801,9 @@
                   mm_of_travel = linear_travel ? HYPOT(flat_mm, linear_travel) : ABS(flat_mm);
       if (mm_of_travel < 0.001f) return;
 
-      uint16_t segments = FLOOR(mm_of_travel / (MM_PER_ARC_SEGMENT));
-      if (segments == 0) segments = 1;
+      const float fr_mm_s = MMS_SCALED(feedrate_mm_s);
+
+      const uint16_t segments = arc_segments(radius, mm_of_travel, fr_mm_s);
 
       /**
        * Vector rotation by transformation matrix: r is the original vector, r_T is the rotated vector,
@@ -834,8 +836,14 @@
       const float theta_per_segment = angular_travel / segments,
                   linear_per_segment = linear_travel / segments,
                   extruder_per_segment = extruder_travel / segments,
-                  sin_T = theta_per_segment,
-                  cos_T = 1 - 0.5f * sq(theta_per_segment); // Small angle approximation
+                  segment_mm = mm_of_travel / segments;
+
+      #if ENABLED(ARC_CHORD_TOLERANCE)
+        arc_rotation_t rotation(offset, radius, theta_per_segment);
+      #else
+        const float sin_T = theta_per_segment,
+                    cos_T = 1 - 0.5f * sq(theta_per_segment); // Small angle approximation
+      #endif
 
       // Initialize the linear axis
       raw[Z_AXIS] = current_position[Z_AXIS];
@@ -843,20 +851,18 @@
       // Initialize the extruder axis
       raw[E_AXIS] = current_position[E_AXIS];
 
-      const float fr_mm_s = MMS_SCALED(feedrate_mm_s);
-
       millis_t next_idle_ms = millis() + 200UL;
 
       #if ENABLED(DELTA_FEEDRATE_SCALING)
         // DELTA needs to scale the feed rate from mm/s to degrees/s
-        const float inv_segment_length = 1.0f / float(MM_PER_ARC_SEGMENT),
+        const float inv_segment_length = segments / mm_of_travel,
                     inverse_secs = inv_segment_length * fr_mm_s;
         float oldA = planner.position_float[A_AXIS],
               oldB = planner.position_float[B_AXIS],
               oldC = planner.position_float[C_AXIS];
       #endif
 
-      #if N_ARC_CORRECTION > 1
+      #if DISABLED(ARC_CHORD_TOLERANCE) && N_ARC_CORRECTION > 1
         int8_t arc_recalc_count = N_ARC_CORRECTION;
       #endif
 
@@ -868,29 +874,33 @@
           printer.idle();
         }
 
-        #if N_ARC_CORRECTION > 1
-          if (--arc_recalc_count) {
-            // Apply vector rotation matrix to previous r_P / 1
-            const float r_new_Y = r_P * sin_T + r_Q * cos_T;
-            r_P = r_P * cos_T - r_Q * sin_T;
-            r_Q = r_new_Y;
-          }
-          else
-        #endif
-        {
+        #if ENABLED(ARC_CHORD_TOLERANCE)
+          rotation.next(r_P, r_Q);
+        #else
           #if N_ARC_CORRECTION > 1
-            arc_recalc_count = N_ARC_CORRECTION;
+            if (--arc_recalc_count) {
+              // Apply vector rotation matrix to previous r_P / 1
+              const float r_new_Y = r_P * sin_T + r_Q * cos_T;
+              r_P = r_P * cos_T - r_Q * sin_T;
+              r_Q = r_new_Y;
+            }
+            else
           #endif
-
-          // Arc correction to radius vector. Computed only every N_ARC_CORRECTION increments.
-          // Compute exact location by applying transformation matrix from initial radius vector(=-offset).
-          // To reduce stuttering, the sin and cos could be computed at different times.
-          // For now, compute both at the same time.
-          const float cos_Ti = cos(i * theta_per_segment),
-                      sin_Ti = sin(i * theta_per_segment);
-          r_P = -offset[0] * cos_Ti + offset[1] * sin_Ti;
-          r_Q = -offset[0] * sin_Ti - offset[1] * cos_Ti;
-        }
+          {
+            #if N_ARC_CORRECTION > 1
+              arc_recalc_count = N_ARC_CORRECTION;
+            #endif
+
+            // Arc correction to radius vector. Computed only every N_ARC_CORRECTION increments.
+            // Compute exact location by applying transformation matrix from initial radius vector(=-offset).
+            // To reduce stuttering, the sin and cos could be computed at different times.
+            // For now, compute both at the same time.
+            const float cos_Ti = cos(i * theta_per_segment),
+                        sin_Ti = sin(i * theta_per_segment);
+            r_P = -offset[0] * cos_Ti + offset[1] * sin_Ti;
+            r_Q = -offset[0] * sin_Ti - offset[1] * cos_Ti;
+          }
+        #endif
 
         // Update raw location
         raw[X_AXIS] = center_P + r_P;
@@ -916,13 +926,13 @@
         #if ENABLED(DELTA_FEEDRATE_SCALING)
           // For DELTA scale the feed rate from Effector mm/s to Carriage mm/s
           // i.e., Complete the linear vector in the given time.
-          if (!planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], delta[C_AXIS], raw[E_AXIS], SQRT(sq(delta[A_AXIS] - oldA) + sq(delta[B_AXIS] - oldB) + sq(delta[C_AXIS] - oldC)) * inverse_secs, tools.active_extruder, MM_PER_ARC_SEGMENT))
+          if (!planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], delta[C_AXIS], raw[E_AXIS], SQRT(sq(delta[A_AXIS] - oldA) + sq(delta[B_AXIS] - oldB) + sq(delta[C_AXIS] - oldC)) * inverse_secs, tools.active_extruder, segment_mm))
             break;
           oldA = delta[A_AXIS]; oldB = delta[B_AXIS]; oldC = delta[C_AXIS];
         #elif HAS_UBL_AND_CURVES
           float pos[XYZ] = { raw[X_AXIS], raw[Y_AXIS], raw[Z_AXIS] };
           bedlevel.apply_leveling(pos);
-          if (!planner.buffer_segment(pos[X_AXIS], pos[Y_AXIS], pos[Z_AXIS], raw[E_AXIS], fr_mm_s, tools.active_extruder, MM_PER_ARC_SEGMENT))
+          if (!planner.buffer_segment(pos[X_AXIS], pos[Y_AXIS], pos[Z_AXIS], raw[E_AXIS], fr_mm_s, tools.active_extruder, segment_mm))
             break;
         #else
           if (!planner.buffer_line(raw, fr_mm_s, tools.active_extruder))
@@ -947,11 +957,11 @@
       #if ENABLED(DELTA_FEEDRATE_SCALING)
         const float diff2 = sq(delta[A_AXIS] - oldA) + sq(delta[B_AXIS] - oldB) + sq(delta[C_AXIS] - oldC);
         if (diff2)
-          planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], delta[C_AXIS], cart[E_AXIS], SQRT(diff2) * inverse_secs, tools.active_extruder, MM_PER_ARC_SEGMENT);
+          planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], delta[C_AXIS], cart[E_AXIS], SQRT(diff2) * inverse_secs, tools.active_extruder, segment_mm);
       #elif HAS_UBL_AND_CURVES
         float pos[XYZ] = { cart[X_AXIS], cart[Y_AXIS], cart[Z_AXIS] };
         bedlevel.apply_leveling(pos);
-        planner.buffer_segment(pos[X_AXIS], pos[Y_AXIS], pos[Z_AXIS], cart[E_AXIS], fr_mm_s, tools.active_extruder, MM_PER_ARC_SEGMENT);
+        planner.buffer_segment(pos[X_AXIS], pos[Y_AXIS], pos[Z_AXIS], cart[E_AXIS], fr_mm_s, tools.active_extruder, segment_mm);
       #else
         planner.buffer_line(cart, fr_mm_s, tools.active_extruder);
       #endif
@@ -137,6 +137,8 @@ void Mechanics::prepare_move_to_destination() {
   #endif
 
   if (!printer.debugSimulation()) { // Simulation Mode no movement
+    // Pen up and down end the IMU drift travels
+    SIDrift.zMove(current_position[Z_AXIS], destination[Z_AXIS]);
     if (
       #if UBL_DELTA
         ubl.prepare_segmented_line_to(destination, feedrate_mm_s)
@@ -149,6 +151,26 @@ void Mechanics::prepare_move_to_destination() {
   set_current_to_destination();
 }
 
+#if ENABLED(Z_MOTION_CHANNEL)
+
+  bool Mechanics::prepare_z_move_to_destination() {
+    if (destination[X_AXIS] != current_position[X_AXIS] || destination[Y_AXIS] != current_position[Y_AXIS] || destination[E_AXIS] != current_position[E_AXIS])
+      return false;
+
+    endstops.clamp_to_software(destination);
+
+    if (!printer.debugSimulation()) { // Simulation Mode no movement
+      // Pen up and down end the IMU drift travels
+      SIDrift.zMove(current_position[Z_AXIS], destination[Z_AXIS]);
+      planner.buffer_z_line(destination[Z_AXIS], MMS_SCALED(feedrate_mm_s));
+    }
+
+    set_current_to_destination();
+    return true;
+  }
+
+#endif // Z_MOTION_CHANNEL
+
 #if ENABLED(G5_BEZIER)
 
   /**
@@ -168,6 +190,62 @@ void Mechanics::prepare_move_to_destination() {
 
 #endif // G5_BEZIER
 
+#if ENABLED(ARC_SUPPORT)
+
+  uint16_t Mechanics::arc_segments(const float &radius, const float &mm_of_travel, const float &fr_mm_s) {
+
+    #if ENABLED(ARC_CHORD_TOLERANCE)
+      // Longest chord that stays within the tolerance from the arc
+      float segment_mm = MM_PER_ARC_SEGMENT;
+      if (radius > (ARC_CHORD_TOLERANCE))
+        NOMORE(segment_mm, 2.0f * SQRT((ARC_CHORD_TOLERANCE) * (2.0f * radius - (ARC_CHORD_TOLERANCE))));
+      // Don't queue segments faster than the planner can take them,
+      // but keep at least 6 segments in a circle
+      NOLESS(segment_mm, MIN(fr_mm_s * (1.0f / (ARC_SEGMENTS_PER_SEC)), radius));
+      NOLESS(segment_mm, MIN_ARC_SEGMENT_MM);
+      const float segments = CEIL(mm_of_travel / segment_mm);
+      return segments > 65535.0f ? 65535 : segments < 1.0f ? 1 : (uint16_t)segments;
+    #else
+      UNUSED(radius);
+      UNUSED(fr_mm_s);
+      const uint16_t segments = FLOOR(mm_of_travel / (MM_PER_ARC_SEGMENT));
+      return segments ? segments : 1;
+    #endif
+  }
+
+  #if ENABLED(ARC_CHORD_TOLERANCE)
+
+    arc_rotation_t::arc_rotation_t(const float (&offset)[2], const float &radius, const float &theta_per_segment) {
+      const float inv_radius = radius ? 1.0f / radius : 0.0f;
+      start_P = -offset[0] * inv_radius;
+      start_Q = -offset[1] * inv_radius;
+      theta = theta_per_segment;
+      scale = radius * (1.0f / float(_BV32(30)));
+      // One exact cos and sin for the whole arc
+      cos_T = LROUND(cos(theta) * float(_BV32(30)));
+      sin_T = LROUND(sin(theta) * float(_BV32(30)));
+      p = LROUND(start_P * float(_BV32(30)));
+      q = LROUND(start_Q * float(_BV32(30)));
+      index = 0;
+      #if N_ARC_CORRECTION > 1
+        recalc_count = N_ARC_CORRECTION;
+      #endif
+    }
+
+    void arc_rotation_t::correct() {
+      #if N_ARC_CORRECTION > 1
+        recalc_count = N_ARC_CORRECTION;
+      #endif
+      const float cos_Ti = cos(index * theta),
+                  sin_Ti = sin(index * theta);
+      p = LROUND((start_P * cos_Ti - start_Q * sin_Ti) * float(_BV32(30)));
+      q = LROUND((start_P * sin_Ti + start_Q * cos_Ti) * float(_BV32(30)));
+    }
+
+  #endif // ARC_CHORD_TOLERANCE
+
+#endif // ARC_SUPPORT
+
 /**
  * sync_plan_position
  *
@@ -110,6 +110,54 @@ typedef struct {
 
 } generic_data_t;
 
+#if ENABLED(ARC_SUPPORT) && ENABLED(ARC_CHORD_TOLERANCE)
+
+  /**
+   * Radius vector rotation for plan_arc.
+   *
+   * The unit radius vector and the rotation matrix are held in Q30
+   * fixed point, so each segment costs four integer multiplies.
+   * The exact position is computed again every N_ARC_CORRECTION
+   * segments, as the float recurrence does.
+   */
+  struct arc_rotation_t {
+
+    arc_rotation_t(const float (&offset)[2], const float &radius, const float &theta_per_segment);
+
+    // Rotate by one segment and return the radius vector in mm
+    FORCE_INLINE void next(float &r_P, float &r_Q) {
+      index++;
+      #if N_ARC_CORRECTION > 1
+        if (--recalc_count) {
+          const int32_t new_p = ((int64_t)p * cos_T - (int64_t)q * sin_T + _BV32(29)) >> 30;
+          q = ((int64_t)p * sin_T + (int64_t)q * cos_T + _BV32(29)) >> 30;
+          p = new_p;
+        }
+        else
+      #endif
+          correct();
+      r_P = p * scale;
+      r_Q = q * scale;
+    }
+
+    private:
+
+      float     start_P, start_Q,   // Unit radius vector at the arc start
+                theta,              // Rotation per segment
+                scale;              // Q30 to mm
+      int32_t   p, q,               // Unit radius vector, Q30
+                cos_T, sin_T;       // Rotation matrix, Q30
+      uint16_t  index;
+      #if N_ARC_CORRECTION > 1
+        uint8_t recalc_count;
+      #endif
+
+      void correct();
+
+  };
+
+#endif
+
 class Mechanics {
 
   public: /** Constructor */
@@ -278,6 +326,14 @@ class Mechanics {
      */
     static void prepare_move_to_destination();
 
+    #if ENABLED(Z_MOTION_CHANNEL)
+      /**
+       * Send a move of Z alone to the Z motion channel.
+       * Return false, doing nothing, if X, Y or E move too.
+       */
+      static bool prepare_z_move_to_destination();
+    #endif
+
     /**
      * Compute a Bézier curve using the De Casteljau's algorithm (see
      * https://en.wikipedia.org/wiki/De_Casteljau%27s_algorithm), which is
@@ -288,6 +344,15 @@ class Mechanics {
       static void plan_cubic_move(const float offset[4]);
     #endif
 
+    /**
+     * Number of segments for an arc of mm_of_travel, MM_PER_ARC_SEGMENT
+     * long or, with ARC_CHORD_TOLERANCE, as long as the chord error,
+     * the segment rate and MM_PER_ARC_SEGMENT allow.
+     */
+    #if ENABLED(ARC_SUPPORT)
+      static uint16_t arc_segments(const float &radius, const float &mm_of_travel, const float &fr_mm_s);
+    #endif
+
     /**
      * sync_plan_position
      *
@@ -374,4 +439,6 @@ class Mechanics {
   #include "delta_mechanics.h"
 #elif IS_SCARA
   #include "scara_mechanics.h"
+#elif MECH(POLARGRAPH)
+  #include "polargraph_mechanics.h"
 #endif
@@ -0,0 +1,791 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * polargraph_mechanics.cpp
+ */
+
+#include "../../../MK4duo.h"
+
+#if MECH(POLARGRAPH)
+
+  Polargraph_Mechanics mechanics;
+
+  /** Public Parameters */
+  mechanics_data_t Polargraph_Mechanics::data;
+
+  const float Polargraph_Mechanics::base_max_pos[XYZ]   = { X_MAX_POS, Y_MAX_POS, Z_MAX_POS },
+              Polargraph_Mechanics::base_min_pos[XYZ]   = { X_MIN_POS, Y_MIN_POS, Z_MIN_POS },
+              Polargraph_Mechanics::base_home_pos[XYZ]  = { X_HOME_POS, Y_HOME_POS, Z_HOME_POS },
+              Polargraph_Mechanics::max_length[XYZ]     = { X_MAX_LENGTH, Y_MAX_LENGTH, Z_MAX_LENGTH };
+
+  float Polargraph_Mechanics::delta[ABC]                = { 0.0 };
+
+  /** Public Function */
+  void Polargraph_Mechanics::factory_parameters() {
+
+    static const float    tmp_step[]          PROGMEM = DEFAULT_AXIS_STEPS_PER_UNIT,
+                          tmp_maxfeedrate[]   PROGMEM = DEFAULT_MAX_FEEDRATE;
+
+    static const uint32_t tmp_maxacc[]        PROGMEM = DEFAULT_MAX_ACCELERATION,
+                          tmp_retract[]       PROGMEM = DEFAULT_RETRACT_ACCELERATION;
+
+    LOOP_XYZE_N(i) {
+      data.axis_steps_per_mm[i]           = pgm_read_float(&tmp_step[i < COUNT(tmp_step) ? i : COUNT(tmp_step) - 1]);
+      data.max_feedrate_mm_s[i]           = pgm_read_float(&tmp_maxfeedrate[i < COUNT(tmp_maxfeedrate) ? i : COUNT(tmp_maxfeedrate) - 1]);
+      data.max_acceleration_mm_per_s2[i]  = pgm_read_dword_near(&tmp_maxacc[i < COUNT(tmp_maxacc) ? i : COUNT(tmp_maxacc) - 1]);
+    }
+
+    LOOP_EXTRUDER()
+      data.retract_acceleration[e]  = pgm_read_dword_near(&tmp_retract[e < COUNT(tmp_retract) ? e : COUNT(tmp_retract) - 1]);
+
+    data.acceleration               = DEFAULT_ACCELERATION;
+    data.travel_acceleration        = DEFAULT_TRAVEL_ACCELERATION;
+    data.min_feedrate_mm_s          = DEFAULT_MIN_FEEDRATE;
+    data.min_segment_time_us        = DEFAULT_MIN_SEGMENT_TIME;
+    data.min_travel_feedrate_mm_s   = DEFAULT_MIN_TRAVEL_FEEDRATE;
+
+    #if ENABLED(JUNCTION_DEVIATION)
+      data.junction_deviation_mm = float(JUNCTION_DEVIATION_MM);
+    #endif
+
+    static const float tmp_ejerk[] PROGMEM = DEFAULT_EJERK;
+    data.max_jerk[X_AXIS]  = DEFAULT_XJERK;
+    data.max_jerk[Y_AXIS]  = DEFAULT_YJERK;
+    data.max_jerk[Z_AXIS]  = DEFAULT_ZJERK;
+    #if DISABLED(JUNCTION_DEVIATION) || DISABLED(LIN_ADVANCE)
+      LOOP_EXTRUDER()
+        data.max_jerk[E_AXIS + e] = pgm_read_float(&tmp_ejerk[e < COUNT(tmp_ejerk) ? e : COUNT(tmp_ejerk) - 1]);
+    #endif
+
+    data.nail_distance      = POLARGRAPH_NAIL_DISTANCE;
+    data.segment_tolerance  = POLARGRAPH_SEGMENT_TOLERANCE;
+
+    #if ENABLED(WORKSPACE_OFFSETS)
+      ZERO(mechanics.data.home_offset);
+    #endif
+
+  }
+
+  /**
+   * Get the stepper positions in the cartesian_position[] array.
+   * Forward kinematics are applied for the cords.
+   */
+  void Polargraph_Mechanics::get_cartesian_from_steppers() {
+    InverseTransform(
+      planner.get_axis_position_mm(A_AXIS),
+      planner.get_axis_position_mm(B_AXIS),
+      cartesian_position
+    );
+    cartesian_position[Z_AXIS] = planner.get_axis_position_mm(Z_AXIS);
+  }
+
+  /**
+   * Prepare a linear move in a Polargraph setup.
+   *
+   * The steppers move the cords linearly between the ends of each
+   * segment, so the pen runs along a curve. Every segment is as
+   * long as the curve allows, staying within segment_tolerance of
+   * the straight line: long in the middle of the wall, short next
+   * to the nails.
+   */
+  bool Polargraph_Mechanics::prepare_move_to_destination_mech_specific() {
+
+    // Get the top feedrate of the move in the XY plane
+    const float _feedrate_mm_s = MMS_SCALED(feedrate_mm_s);
+
+    // Get the cartesian distances moved in XYZE
+    const float difference[XYZE] = {
+      destination[X_AXIS] - current_position[X_AXIS],
+      destination[Y_AXIS] - current_position[Y_AXIS],
+      destination[Z_AXIS] - current_position[Z_AXIS],
+      destination[E_AXIS] - current_position[E_AXIS]
+    };
+
+    // If the move is only in Z/E don't split up the move
+    if (!difference[X_AXIS] && !difference[Y_AXIS]) {
+      planner.buffer_line(destination, _feedrate_mm_s, tools.active_extruder);
+      return false; // caller will update current_position
+    }
+
+    // Fail if attempting move outside the wall
+    if (endstops.isSoftEndstop() && !position_is_reachable(destination[X_AXIS], destination[Y_AXIS])) return true;
+
+    // Get the linear distance in XYZ
+    const float cartesian_mm = SQRT(sq(difference[X_AXIS]) + sq(difference[Y_AXIS]) + sq(difference[Z_AXIS])),
+                inv_mm = 1.0f / cartesian_mm;
+
+    // Get the current position as starting point
+    float raw[XYZE];
+    COPY_ARRAY(raw, current_position);
+
+    // Calculate and execute the segments
+    float done_mm = 0.0f;
+    for (;;) {
+
+      // The curvature changes along the segment, check both of its ends
+      float segment_mm = segment_length(raw[X_AXIS], raw[Y_AXIS]);
+      if (done_mm + segment_mm >= cartesian_mm) break;
+      const float end_ratio = (done_mm + segment_mm) * inv_mm;
+      NOMORE(segment_mm, segment_length(current_position[X_AXIS] + difference[X_AXIS] * end_ratio, current_position[Y_AXIS] + difference[Y_AXIS] * end_ratio));
+
+      done_mm += segment_mm;
+      const float ratio = done_mm * inv_mm;
+      LOOP_XYZE(i) raw[i] = current_position[i] + difference[i] * ratio;
+
+      printer.check_periodical_actions();
+
+      // The segment length is known, the planner takes it as the cartesian length
+      if (!planner.buffer_line(raw, _feedrate_mm_s, tools.active_extruder, segment_mm))
+        break;
+
+    }
+
+    // Ensure last segment arrives at target location.
+    planner.buffer_line(destination, _feedrate_mm_s, tools.active_extruder, cartesian_mm - done_mm);
+
+    return false; // caller will update current_position
+  }
+
+  /**
+   *  Plan a move to (X, Y, Z) and set the current_position
+   *  The final current_position may not be the one that was requested
+   */
+  void Polargraph_Mechanics::do_blocking_move_to(const float rx, const float ry, const float rz, const float &fr_mm_s /*=0.0*/) {
+    const float old_feedrate_mm_s = feedrate_mm_s;
+
+    #if ENABLED(DEBUG_FEATURE)
+      if (printer.debugFeature()) Com::print_xyz(PSTR(">>> do_blocking_move_to"), NULL, rx, ry, rz);
+    #endif
+
+    const float z_feedrate = fr_mm_s ? fr_mm_s : homing_feedrate_mm_s[Z_AXIS];
+
+    if (!position_is_reachable(rx, ry)) return;
+
+    set_destination_to_current();
+
+    // If Z needs to raise, do it before moving XY
+    if (destination[Z_AXIS] < rz) {
+      destination[Z_AXIS] = rz;
+      prepare_uninterpolated_move_to_destination(z_feedrate);
+    }
+
+    // XY moves are segmented, the pen could be down
+    destination[X_AXIS] = rx;
+    destination[Y_AXIS] = ry;
+    feedrate_mm_s = fr_mm_s ? fr_mm_s : XY_PROBE_FEEDRATE_MM_S;
+    prepare_move_to_destination();
+
+    // If Z needs to lower, do it after moving XY
+    if (destination[Z_AXIS] > rz) {
+      destination[Z_AXIS] = rz;
+      prepare_uninterpolated_move_to_destination(z_feedrate);
+    }
+
+    feedrate_mm_s = old_feedrate_mm_s;
+
+    #if ENABLED(DEBUG_FEATURE)
+      if (printer.debugFeature()) SERIAL_EM("<<< do_blocking_move_to");
+    #endif
+
+    planner.synchronize();
+
+  }
+  void Polargraph_Mechanics::do_blocking_move_to_x(const float &rx, const float &fr_mm_s/*=0.0*/) {
+    do_blocking_move_to(rx, current_position[Y_AXIS], current_position[Z_AXIS], fr_mm_s);
+  }
+  void Polargraph_Mechanics::do_blocking_move_to_z(const float &rz, const float &fr_mm_s/*=0.0*/) {
+    do_blocking_move_to(current_position[X_AXIS], current_position[Y_AXIS], rz, fr_mm_s);
+  }
+  void Polargraph_Mechanics::do_blocking_move_to_xy(const float &rx, const float &ry, const float &fr_mm_s/*=0.0*/) {
+    do_blocking_move_to(rx, ry, current_position[Z_AXIS], fr_mm_s);
+  }
+
+  /**
+   * Polargraph InverseTransform. Results in cartesian[].
+   * The pen is where the circles of the two cords meet, below the nails.
+   */
+  void Polargraph_Mechanics::InverseTransform(const float Ha, const float Hb, float cartesian[XYZ]) {
+
+    const float D = data.nail_distance,
+                x = (sq(Ha) - sq(Hb) + sq(D)) / (2.0f * D);
+
+    cartesian[X_AXIS] = x;
+    cartesian[Y_AXIS] = SQRT(MAX(sq(Ha) - sq(x), 0.0f));
+
+  }
+
+  /**
+   * Polargraph Transform. Results in delta[].
+   * The cord lengths from the left and the right nail.
+   */
+  void Polargraph_Mechanics::Transform(const float raw[XYZ]) {
+    delta[A_AXIS] = HYPOT(raw[X_AXIS], raw[Y_AXIS]);
+    delta[B_AXIS] = HYPOT(data.nail_distance - raw[X_AXIS], raw[Y_AXIS]);
+    delta[C_AXIS] = raw[Z_AXIS];
+  }
+
+  /**
+   * Home Polargraph
+   */
+  void Polargraph_Mechanics::home() {
+
+    if (printer.debugSimulation()) {
+      LOOP_XYZ(axis) set_axis_is_at_home((AxisEnum)axis);
+      return;
+    }
+
+    #if HAS_POWER_SWITCH
+      powerManager.power_on(); // Power On if power is off
+    #endif
+
+    // Wait for planner moves to finish!
+    planner.synchronize();
+
+    // Always home with tool 0 active
+    #if HOTENDS > 1
+      const uint8_t old_tool_index = tools.active_extruder;
+      tools.change(0, 0, true);
+    #endif
+
+    printer.setup_for_endstop_or_probe_move();
+    #if ENABLED(DEBUG_FEATURE)
+      if (printer.debugFeature()) SERIAL_EM("> endstops.setEnabled(true)");
+    #endif
+    endstops.setEnabled(true); // Enable endstops for next homing move
+
+    bool come_back = parser.boolval('B');
+    float lastpos[NUM_AXIS];
+    float old_feedrate_mm_s;
+    if (come_back) {
+      old_feedrate_mm_s = feedrate_mm_s;
+      COPY_ARRAY(lastpos, current_position);
+    }
+
+    #if ENABLED(DEBUG_FEATURE)
+      if (printer.debugFeature()) DEBUG_POS(">>> home_polargraph", current_position);
+    #endif
+
+    const bool  homeXY  = parser.seen('X') || parser.seen('Y'),
+                homeZ   = parser.seen('Z');
+
+    const bool home_all = (!homeXY && !homeZ) || (homeXY && homeZ);
+
+    // Home Z
+    if (home_all || homeZ) {
+      homeaxis(Z_AXIS);
+      #if ENABLED(DEBUG_FEATURE)
+        if (printer.debugFeature()) DEBUG_POS("> homeZ", current_position);
+      #endif
+    }
+
+    // X and Y need each other, the plotter is hung at the home position
+    if (home_all || homeXY) {
+      set_axis_is_at_home(X_AXIS);
+      set_axis_is_at_home(Y_AXIS);
+      #if ENABLED(DEBUG_FEATURE)
+        if (printer.debugFeature()) DEBUG_POS("> homeXY", current_position);
+      #endif
+    }
+
+    #if ENABLED(DEBUG_FEATURE)
+      if (printer.debugFeature()) DEBUG_POS("<<< home_polargraph", current_position);
+    #endif
+    sync_plan_position();
+    endstops.setNotHoming();
+
+    if (come_back) {
+      feedrate_mm_s = homing_feedrate_mm_s[X_AXIS];
+      COPY_ARRAY(destination, lastpos);
+      prepare_move_to_destination();
+      feedrate_mm_s = old_feedrate_mm_s;
+    }
+
+    printer.clean_up_after_endstop_or_probe_move();
+
+    planner.synchronize();
+
+    // Restore the active tool after homing
+    #if HOTENDS > 1
+      tools.change(old_tool_index, 0, true);
+    #endif
+
+    lcdui.refresh();
+
+    report_current_position();
+
+    #if ENABLED(DEBUG_FEATURE)
+      if (printer.debugFeature()) SERIAL_EM("<<< G28");
+    #endif
+
+  }
+
+  void Polargraph_Mechanics::do_homing_move(const AxisEnum axis, const float distance, const float fr_mm_s/*=0.0*/) {
+
+    #if ENABLED(DEBUG_FEATURE)
+      if (printer.debugFeature()) {
+        SERIAL_MV(">>> do_homing_move(", axis_codes[axis]);
+        SERIAL_MV(", ", distance);
+        SERIAL_MSG(", ");
+        if (fr_mm_s)
+          SERIAL_VAL(fr_mm_s);
+        else {
+          SERIAL_MV(" [", homing_feedrate_mm_s[axis]);
+          SERIAL_CHR(']');
+        }
+        SERIAL_CHR(')');
+        SERIAL_EOL();
+      }
+    #endif
+
+    const bool is_home_dir = (get_homedir(axis) > 0) == (distance > 0);
+
+    // Z is the same on the wall and on the steppers, move the C axis directly
+    float target[ABCE] = { planner.get_axis_position_mm(A_AXIS), planner.get_axis_position_mm(B_AXIS), planner.get_axis_position_mm(C_AXIS), planner.get_axis_position_mm(E_AXIS) };
+    target[axis] = 0;
+    planner.set_machine_position_mm(target);
+    target[axis] = distance;
+
+    #if ENABLED(JUNCTION_DEVIATION)
+      const float delta_mm_cart[XYZE] = {0, 0, 0, 0};
+    #endif
+
+    planner.buffer_segment(target
+      #if ENABLED(JUNCTION_DEVIATION)
+        , delta_mm_cart
+      #endif
+      , fr_mm_s ? fr_mm_s : homing_feedrate_mm_s[axis], tools.active_extruder
+    );
+
+    planner.synchronize();
+
+    if (is_home_dir) endstops.validate_homing_move();
+
+    #if ENABLED(DEBUG_FEATURE)
+      if (printer.debugFeature()) {
+        SERIAL_MV("<<< do_homing_move(", axis_codes[axis]);
+        SERIAL_CHR(')'); SERIAL_EOL();
+      }
+    #endif
+  }
+
+  /**
+   * Set an axis' current position to its home position (after homing).
+   *
+   * X and Y have no endstops, the plotter must be hung at the home
+   * position. Z can be homed individually.
+   *
+   * Callers must sync the planner position after calling this!
+   */
+  void Polargraph_Mechanics::set_axis_is_at_home(const AxisEnum axis) {
+
+    #if ENABLED(DEBUG_FEATURE)
+      if (printer.debugFeature()) {
+        SERIAL_MV(">>> set_axis_is_at_home(", axis_codes[axis]);
+        SERIAL_CHR(')'); SERIAL_EOL();
+      }
+    #endif
+
+    setAxisHomed(axis, true);
+
+    #if ENABLED(WORKSPACE_OFFSETS)
+      position_shift[axis] = 0;
+      endstops.update_software_endstops(axis);
+    #endif
+
+    current_position[axis] = base_home_pos[axis];
+
+    #if ENABLED(DEBUG_FEATURE)
+      if (printer.debugFeature()) {
+        DEBUG_POS("", current_position);
+        SERIAL_MV("<<< set_axis_is_at_home(", axis_codes[axis]);
+        SERIAL_CHR(')'); SERIAL_EOL();
+      }
+    #endif
+  }
+
+  // Return true if the given point is between the nails and below them
+  bool Polargraph_Mechanics::position_is_reachable(const float &rx, const float &ry) {
+    return WITHIN(rx, 0, data.nail_distance) && ry > 0;
+  }
+
+  /**
+   * Calculate delta, start a line, and set current_position to destination
+   */
+  void Polargraph_Mechanics::prepare_uninterpolated_move_to_destination(const float fr_mm_s/*=0.0*/) {
+
+    #if ENABLED(DEBUG_FEATURE)
+      if (printer.debugFeature()) DEBUG_POS("prepare_uninterpolated_move_to_destination", destination);
+    #endif
+
+    if ( current_position[X_AXIS] == destination[X_AXIS]
+      && current_position[Y_AXIS] == destination[Y_AXIS]
+      && current_position[Z_AXIS] == destination[Z_AXIS]
+      && current_position[E_AXIS] == destination[E_AXIS]
+    ) return;
+
+    planner.buffer_line(destination, MMS_SCALED(fr_mm_s ? fr_mm_s : feedrate_mm_s), tools.active_extruder);
+
+    set_current_to_destination();
+  }
+
+  // Report detail current position to host
+  void Polargraph_Mechanics::report_current_position_detail() {
+
+    SERIAL_MSG("\nLogical:");
+    const float logical[XYZ] = {
+      LOGICAL_X_POSITION(current_position[X_AXIS]),
+      LOGICAL_Y_POSITION(current_position[Y_AXIS]),
+      LOGICAL_Z_POSITION(current_position[Z_AXIS])
+    };
+    report_xyz(logical);
+
+    SERIAL_MSG("Cords:  ");
+    Transform(current_position);
+    report_xyz(delta);
+
+    planner.synchronize();
+
+    SERIAL_MSG("Stepper:");
+    LOOP_XYZE(i) {
+      SERIAL_CHR(' ');
+      SERIAL_CHR(axis_codes[i]);
+      SERIAL_CHR(':');
+      SERIAL_VAL(stepper.position((AxisEnum)i));
+      SERIAL_MSG("    ");
+    }
+    SERIAL_EOL();
+
+    SERIAL_MSG("FromStp:");
+    get_cartesian_from_steppers();  // writes cartesian_position[XYZ] (with forward kinematics)
+    const float from_steppers[XYZE] = { cartesian_position[X_AXIS], cartesian_position[Y_AXIS], cartesian_position[Z_AXIS], planner.get_axis_position_mm(E_AXIS) };
+    report_xyze(from_steppers);
+
+    const float diff[XYZE] = {
+      from_steppers[X_AXIS] - current_position[X_AXIS],
+      from_steppers[Y_AXIS] - current_position[Y_AXIS],
+      from_steppers[Z_AXIS] - current_position[Z_AXIS],
+      from_steppers[E_AXIS] - current_position[E_AXIS]
+    };
+
+    SERIAL_MSG("Differ: ");
+    report_xyze(diff);
+
+  }
+
+  #if ENABLED(ARC_SUPPORT)
+
+    #if N_ARC_CORRECTION < 1
+      #undef N_ARC_CORRECTION
+      #define N_ARC_CORRECTION 1
+    #endif
+
+    /**
+     * Plan an arc in 2 dimensions
+     *
+     * The arc is approximated by generating many small linear segments.
+     * The length of each segment is configured in MM_PER_ARC_SEGMENT (Default 1mm)
+     * or, with ARC_CHORD_TOLERANCE, sized by Mechanics::arc_segments.
+     * Each segment is short enough to be drawn straight by the cords.
+     */
+    void Polargraph_Mechanics::plan_arc(
+      const float (&cart)[XYZE],  // Destination position
+      const float (&offset)[2],   // Center of rotation relative to current_position
+      const uint8_t clockwise     // Clockwise?
+    ) {
+
+      // Radius vector from center to current location
+      float r_P = -offset[0], r_Q = -offset[1];
+
+      const float radius = HYPOT(r_P, r_Q),
+                  center_P = current_position[X_AXIS] - r_P,
+                  center_Q = current_position[Y_AXIS] - r_Q,
+                  rt_X = cart[X_AXIS] - center_P,
+                  rt_Y = cart[Y_AXIS] - center_Q,
+                  linear_travel = cart[Z_AXIS] - current_position[Z_AXIS],
+                  extruder_travel = cart[E_AXIS] - current_position[E_AXIS];
+
+      // CCW angle of rotation between position and target from the circle center. Only one atan2() trig computation required.
+      float angular_travel = ATAN2(r_P * rt_Y - r_Q * rt_X, r_P * rt_X + r_Q * rt_Y);
+      if (angular_travel < 0) angular_travel += RADIANS(360);
+      if (clockwise) angular_travel -= RADIANS(360);
+
+      // Make a circle if the angular rotation is 0
+      if (angular_travel == 0 && current_position[X_AXIS] == cart[X_AXIS] && current_position[Y_AXIS] == cart[Y_AXIS])
+        angular_travel += RADIANS(360);
+
+      const float flat_mm = radius * angular_travel,
+                  mm_of_travel = linear_travel ? HYPOT(flat_mm, linear_travel) : ABS(flat_mm);
+      if (mm_of_travel < 0.001f) return;
+
+      const float fr_mm_s = MMS_SCALED(feedrate_mm_s);
+
+      uint16_t segments = arc_segments(radius, mm_of_travel, fr_mm_s);
+
+      // Each chord must also be drawn straight by the cords
+      const float cord_mm = MIN(segment_length(current_position[X_AXIS], current_position[Y_AXIS]), segment_length(cart[X_AXIS], cart[Y_AXIS]));
+      NOLESS(segments, (uint16_t)MIN(CEIL(mm_of_travel / cord_mm), 65535.0f));
+
+      // Vector rotation matrix values, see Cartesian_Mechanics::plan_arc
+      float raw[XYZE];
+      const float theta_per_segment = angular_travel / segments,
+                  linear_per_segment = linear_travel / segments,
+                  extruder_per_segment = extruder_travel / segments;
+
+      #if ENABLED(ARC_CHORD_TOLERANCE)
+        arc_rotation_t rotation(offset, radius, theta_per_segment);
+      #else
+        const float sin_T = theta_per_segment,
+                    cos_T = 1 - 0.5f * sq(theta_per_segment); // Small angle approximation
+      #endif
+
+      // Initialize the linear axis
+      raw[Z_AXIS] = current_position[Z_AXIS];
+
+      // Initialize the extruder axis
+      raw[E_AXIS] = current_position[E_AXIS];
+
+      millis_t next_idle_ms = millis() + 200UL;
+
+      #if DISABLED(ARC_CHORD_TOLERANCE) && N_ARC_CORRECTION > 1
+        int8_t arc_recalc_count = N_ARC_CORRECTION;
+      #endif
+
+      for (uint16_t i = 1; i < segments; i++) { // Iterate (segments-1) times
+
+        printer.check_periodical_actions();
+        if (ELAPSED(millis(), next_idle_ms)) {
+          next_idle_ms = millis() + 200UL;
+          printer.idle();
+        }
+
+        #if ENABLED(ARC_CHORD_TOLERANCE)
+          rotation.next(r_P, r_Q);
+        #else
+          #if N_ARC_CORRECTION > 1
+            if (--arc_recalc_count) {
+              // Apply vector rotation matrix to previous r_P / 1
+              const float r_new_Y = r_P * sin_T + r_Q * cos_T;
+              r_P = r_P * cos_T - r_Q * sin_T;
+              r_Q = r_new_Y;
+            }
+            else
+          #endif
+          {
+            #if N_ARC_CORRECTION > 1
+              arc_recalc_count = N_ARC_CORRECTION;
+            #endif
+
+            // Arc correction to radius vector. Computed only every N_ARC_CORRECTION increments.
+            // Compute exact location by applying transformation matrix from initial radius vector(=-offset).
+            const float cos_Ti = cos(i * theta_per_segment),
+                        sin_Ti = sin(i * theta_per_segment);
+            r_P = -offset[0] * cos_Ti + offset[1] * sin_Ti;
+            r_Q = -offset[0] * sin_Ti - offset[1] * cos_Ti;
+          }
+        #endif
+
+        // Update raw location
+        raw[X_AXIS] = center_P + r_P;
+        raw[Y_AXIS] = center_Q + r_Q;
+        raw[Z_AXIS] += linear_per_segment;
+        raw[E_AXIS] += extruder_per_segment;
+
+        endstops.clamp_to_software(raw);
+
+        if (!planner.buffer_line(raw, fr_mm_s, tools.active_extruder))
+          break;
+      }
+
+      // Ensure last segment arrives at target location.
+      planner.buffer_line(cart, fr_mm_s, tools.active_extruder);
+
+      COPY_ARRAY(current_position, cart);
+
+    }
+
+  #endif // ENABLED(ARC_SUPPORT)
+
+  #if DISABLED(DISABLE_M503)
+
+    void Polargraph_Mechanics::print_parameters() {
+
+      SERIAL_LM(CFG, "Steps per unit:");
+      SERIAL_SMV(CFG, "  M92 X", LINEAR_UNIT(data.axis_steps_per_mm[X_AXIS]), 3);
+      SERIAL_MV(" Y", LINEAR_UNIT(data.axis_steps_per_mm[Y_AXIS]), 3);
+      SERIAL_MV(" Z", LINEAR_UNIT(data.axis_steps_per_mm[Z_AXIS]), 3);
+      #if EXTRUDERS == 1
+        SERIAL_MV(" T0 E", VOLUMETRIC_UNIT(data.axis_steps_per_mm[E_AXIS]), 3);
+      #endif
+      SERIAL_EOL();
+      #if EXTRUDERS > 1
+        LOOP_EXTRUDER() {
+          SERIAL_SMV(CFG, "  M92 T", (int)e);
+          SERIAL_EMV(" E", VOLUMETRIC_UNIT(data.axis_steps_per_mm[E_AXIS + e]), 3);
+        }
+      #endif // EXTRUDERS > 1
+
+      SERIAL_LM(CFG, "Maximum feedrates (units/s):");
+      SERIAL_SMV(CFG, "  M203 X", LINEAR_UNIT(data.max_feedrate_mm_s[X_AXIS]), 3);
+      SERIAL_MV(" Y", LINEAR_UNIT(data.max_feedrate_mm_s[Y_AXIS]), 3);
+      SERIAL_MV(" Z", LINEAR_UNIT(data.max_feedrate_mm_s[Z_AXIS]), 3);
+      #if EXTRUDERS == 1
+        SERIAL_MV(" T0 E", VOLUMETRIC_UNIT(data.max_feedrate_mm_s[E_AXIS]), 3);
+      #endif
+      SERIAL_EOL();
+      #if EXTRUDERS > 1
+        LOOP_EXTRUDER() {
+          SERIAL_SMV(CFG, "  M203 T", (int)e);
+          SERIAL_EMV(" E", VOLUMETRIC_UNIT(data.max_feedrate_mm_s[E_AXIS + e]), 3);
+        }
+      #endif // EXTRUDERS > 1
+
+      SERIAL_LM(CFG, "Maximum Acceleration (units/s2):");
+      SERIAL_SMV(CFG, "  M201 X", LINEAR_UNIT(data.max_acceleration_mm_per_s2[X_AXIS]));
+      SERIAL_MV(" Y", LINEAR_UNIT(data.max_acceleration_mm_per_s2[Y_AXIS]));
+      SERIAL_MV(" Z", LINEAR_UNIT(data.max_acceleration_mm_per_s2[Z_AXIS]));
+      #if EXTRUDERS == 1
+        SERIAL_MV(" T0 E", VOLUMETRIC_UNIT(data.max_acceleration_mm_per_s2[E_AXIS]));
+      #endif
+      SERIAL_EOL();
+      #if EXTRUDERS > 1
+        LOOP_EXTRUDER() {
+          SERIAL_SMV(CFG, "  M201 T", (int)e);
+          SERIAL_EMV(" E", VOLUMETRIC_UNIT(data.max_acceleration_mm_per_s2[E_AXIS + e]));
+        }
+      #endif // EXTRUDERS > 1
+
+      SERIAL_LM(CFG, "Acceleration (units/s2): P<DEFAULT_ACCELERATION> V<DEFAULT_TRAVEL_ACCELERATION> T* R<DEFAULT_RETRACT_ACCELERATION>:");
+      SERIAL_SMV(CFG,"  M204 P", LINEAR_UNIT(data.acceleration), 3);
+      SERIAL_MV(" V", LINEAR_UNIT(data.travel_acceleration), 3);
+      #if EXTRUDERS == 1
+        SERIAL_MV(" T0 R", LINEAR_UNIT(data.retract_acceleration[0]), 3);
+      #endif
+      SERIAL_EOL();
+      #if EXTRUDERS > 1
+        LOOP_EXTRUDER() {
+          SERIAL_SMV(CFG, "  M204 T", (int)e);
+          SERIAL_EMV(" R", LINEAR_UNIT(data.retract_acceleration[e]), 3);
+        }
+      #endif
+
+      SERIAL_LM(CFG, "Advanced variables: B<DEFAULT_MIN_SEGMENT_TIME> S<DEFAULT_MIN_FEEDRATE> V<DEFAULT_MIN_TRAVEL_FEEDRATE>:");
+      SERIAL_SMV(CFG, " M205 B", data.min_segment_time_us);
+      SERIAL_MV(" S", LINEAR_UNIT(data.min_feedrate_mm_s), 3);
+      SERIAL_EMV(" V", LINEAR_UNIT(data.min_travel_feedrate_mm_s), 3);
+
+      #if ENABLED(JUNCTION_DEVIATION)
+        SERIAL_LM(CFG, "Junction Deviation: J<JUNCTION_DEVIATION_MM>:");
+        SERIAL_LMV(CFG, "  M205 J", data.junction_deviation_mm, 3);
+      #else
+        SERIAL_LM(CFG, "Jerk: X<DEFAULT_XJERK> Y<DEFAULT_YJERK> Z<max_z_jerk> T* E<DEFAULT_EJERK>:");
+        SERIAL_SMV(CFG, " M205 X", LINEAR_UNIT(data.max_jerk[X_AXIS]), 3);
+        SERIAL_MV(" Y", LINEAR_UNIT(data.max_jerk[Y_AXIS]), 3);
+        SERIAL_MV(" Z", LINEAR_UNIT(data.max_jerk[Z_AXIS]), 3);
+        #if EXTRUDERS == 1
+          SERIAL_MV(" T0 E", LINEAR_UNIT(data.max_jerk[E_AXIS]), 3);
+        #endif
+        SERIAL_EOL();
+        #if (EXTRUDERS > 1)
+          LOOP_EXTRUDER() {
+            SERIAL_SMV(CFG, "  M205 T", (int)e);
+            SERIAL_EMV(" E" , LINEAR_UNIT(data.max_jerk[E_AXIS + e]), 3);
+          }
+        #endif
+      #endif
+
+      SERIAL_LM(CFG, "Polargraph: D<nail distance> S<segment tolerance>");
+      SERIAL_SMV(CFG, "  M665 D", LINEAR_UNIT(data.nail_distance), 3);
+      SERIAL_EMV(" S", LINEAR_UNIT(data.segment_tolerance), 3);
+
+    }
+
+  #endif // DISABLED(DISABLE_M503)
+
+  /** Private Function */
+  void Polargraph_Mechanics::homeaxis(const AxisEnum axis) {
+
+    // Only Z has an endstop
+    if (axis != Z_AXIS) return;
+
+    #define CAN_HOME_Z ((Z_MIN_PIN > -1 && Z_HOME_DIR < 0) || (Z_MAX_PIN > -1 && Z_HOME_DIR > 0))
+    if (!CAN_HOME_Z) return;
+
+    #if ENABLED(DEBUG_FEATURE)
+      if (printer.debugFeature()) {
+        SERIAL_MV(">>> homeaxis(", axis_codes[axis]);
+        SERIAL_CHR(')'); SERIAL_EOL();
+      }
+    #endif
+
+    const int axis_home_dir = get_homedir(axis);
+
+    // Fast move towards endstop until triggered
+    #if ENABLED(DEBUG_FEATURE)
+      if (printer.debugFeature()) SERIAL_EM("Home 1 Fast:");
+    #endif
+    do_homing_move(axis, 1.5f * max_length[axis] * axis_home_dir);
+
+    const float bump = axis_home_dir * home_bump_mm[axis];
+
+    // If a second homing move is configured...
+    if (bump) {
+      // Move away from the endstop by the axis HOME_BUMP_MM
+      #if ENABLED(DEBUG_FEATURE)
+        if (printer.debugFeature()) SERIAL_EM("Move Away:");
+      #endif
+      do_homing_move(axis, -bump);
+
+      // Slow move towards endstop until triggered
+      #if ENABLED(DEBUG_FEATURE)
+        if (printer.debugFeature()) SERIAL_EM("Home 2 Slow:");
+      #endif
+      do_homing_move(axis, 2 * bump, get_homing_bump_feedrate(axis));
+    }
+
+    set_axis_is_at_home(axis);
+    sync_plan_position();
+
+    destination[axis] = current_position[axis];
+
+    #if ENABLED(DEBUG_FEATURE)
+      if (printer.debugFeature()) {
+        SERIAL_MV("<<< homeaxis(", axis_codes[axis]);
+        SERIAL_CHR(')'); SERIAL_EOL();
+      }
+    #endif
+  }
+
+  /**
+   * The cords are drawn straight between the ends of a segment, the
+   * pen strays from the line by about s^2 * max(L,R) / (8 * D * y),
+   * with L,R the cords, D the nail distance and y the depth below
+   * the nails. Return the length s giving segment_tolerance.
+   */
+  float Polargraph_Mechanics::segment_length(const float &rx, const float &ry) {
+    const float longest_cord = MAX(HYPOT(rx, ry), HYPOT(data.nail_distance - rx, ry));
+    float segment_mm = SQRT(8.0f * data.segment_tolerance * data.nail_distance * MAX(ry, 0.0f) / longest_cord);
+    LIMIT(segment_mm, POLARGRAPH_MIN_SEGMENT_MM, POLARGRAPH_MAX_SEGMENT_MM);
+    return segment_mm;
+  }
+
+#endif // MECH(POLARGRAPH)
@@ -0,0 +1,160 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * polargraph_mechanics.h
+ *
+ * Hanging plotter, moved by two cords from two nails.
+ * A (X motor) is the left cord, B (Y motor) the right cord, both in mm.
+ * Wall coordinates: X to the right of the left nail, Y down from the nails.
+ */
+
+#pragma once
+
+// Struct Polargraph Settings
+typedef struct : public generic_data_t {
+
+  float nail_distance,
+        segment_tolerance;
+
+} mechanics_data_t;
+
+class Polargraph_Mechanics : public Mechanics {
+
+  public: /** Constructor */
+
+    Polargraph_Mechanics() {}
+
+  public: /** Public Parameters */
+
+    static mechanics_data_t data;
+
+    static const float  base_max_pos[XYZ],
+                        base_min_pos[XYZ],
+                        base_home_pos[XYZ],
+                        max_length[XYZ];
+
+    static float  delta[ABC];
+
+  public: /** Public Function */
+
+    /**
+     * Initialize Factory parameters
+     */
+    static void factory_parameters();
+
+    /**
+     * Get the stepper positions in the cartesian_position[] array.
+     * Forward kinematics are applied for the cords.
+     */
+    static void get_cartesian_from_steppers();
+
+    /**
+     * Prepare a linear move in a Polargraph setup.
+     *
+     * The cords change length along a curve, the move is split in
+     * segments short enough to keep the pen within segment_tolerance
+     * of the straight line.
+     */
+    static bool prepare_move_to_destination_mech_specific();
+
+    /**
+     *  Plan a move to (X, Y, Z) and set the current_position
+     *  The final current_position may not be the one that was requested
+     */
+    static void do_blocking_move_to(const float rx, const float ry, const float rz, const float &fr_mm_s=0.0);
+    static void do_blocking_move_to_x(const float &rx, const float &fr_mm_s=0.0);
+    static void do_blocking_move_to_z(const float &rz, const float &fr_mm_s=0.0);
+    static void do_blocking_move_to_xy(const float &rx, const float &ry, const float &fr_mm_s=0.0);
+
+    /**
+     * Polargraph function
+     */
+    static void InverseTransform(const float Ha, const float Hb, float cartesian[XYZ]);
+    static void InverseTransform(const float point[XYZ], float cartesian[XYZ]) { InverseTransform(point[A_AXIS], point[B_AXIS], cartesian); }
+    static void Transform(const float raw[XYZ]);
+
+    /**
+     * Home Polargraph
+     */
+    static void home();
+
+    /**
+     * Home an individual linear axis
+     */
+    static void do_homing_move(const AxisEnum axis, const float distance, const float fr_mm_s=0.0);
+
+    /**
+     * Set an axis' current position to its home position (after homing).
+     *
+     * X and Y have no endstops, the plotter must be hung at the home
+     * position. Z can be homed individually.
+     *
+     * Callers must sync the planner position after calling this!
+     */
+    static void set_axis_is_at_home(const AxisEnum axis);
+
+    static bool position_is_reachable(const float &rx, const float &ry);
+
+    /**
+     * Calculate delta, start a line, and set current_position to destination
+     */
+    static void prepare_uninterpolated_move_to_destination(const float fr_mm_s=0.0);
+
+    /**
+     * Report current position to host
+     */
+    static void report_current_position_detail();
+
+    /**
+     * Plan an arc in 2 dimensions
+     *
+     * The arc is approximated by generating many small linear segments.
+     * The length of each segment is configured in MM_PER_ARC_SEGMENT (Default 1mm)
+     * or, with ARC_CHORD_TOLERANCE, sized by Mechanics::arc_segments.
+     */
+    #if ENABLED(ARC_SUPPORT)
+      static void plan_arc(const float (&cart)[XYZE], const float (&offset)[2], const uint8_t clockwise);
+    #endif
+
+    /**
+     * Print mechanics parameters in memory
+     */
+    #if DISABLED(DISABLE_M503)
+      static void print_parameters();
+    #endif
+
+  private: /** Private Function */
+
+    /**
+     *  Home axis
+     */
+    static void homeaxis(const AxisEnum axis);
+
+    /**
+     * Longest segment starting at rx,ry within segment_tolerance
+     */
+    static float segment_length(const float &rx, const float &ry);
+
+};
+
+extern Polargraph_Mechanics mechanics;
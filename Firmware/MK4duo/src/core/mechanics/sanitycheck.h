@@ -252,6 +252,16 @@
 #if DISABLED(N_ARC_CORRECTION)
   #error "DEPENDENCY ERROR: Missing setting N_ARC_CORRECTION."
 #endif
+#if ENABLED(ARC_CHORD_TOLERANCE)
+  #if DISABLED(ARC_SEGMENTS_PER_SEC)
+    #error "DEPENDENCY ERROR: Missing setting ARC_SEGMENTS_PER_SEC."
+  #elif DISABLED(MIN_ARC_SEGMENT_MM)
+    #error "DEPENDENCY ERROR: Missing setting MIN_ARC_SEGMENT_MM."
+  #endif
+#endif
+#if ENABLED(G5_BEZIER) && DISABLED(G5_BEZIER_TOLERANCE)
+  #error "DEPENDENCY ERROR: Missing setting G5_BEZIER_TOLERANCE."
+#endif
 #if DISABLED(DEFAULT_AXIS_STEPS_PER_UNIT)
   #error "DEPENDENCY ERROR: Missing setting DEFAULT_AXIS_STEPS_PER_UNIT."
 #endif
@@ -604,4 +614,32 @@
 
 #endif // IS_SCARA
 
+// Polargraph settings
+#if MECH(POLARGRAPH)
+
+  #if DISABLED(POLARGRAPH_NAIL_DISTANCE)
+    #error "DEPENDENCY ERROR: Missing setting POLARGRAPH_NAIL_DISTANCE."
+  #endif
+  #if DISABLED(POLARGRAPH_SEGMENT_TOLERANCE)
+    #error "DEPENDENCY ERROR: Missing setting POLARGRAPH_SEGMENT_TOLERANCE."
+  #endif
+  #if DISABLED(POLARGRAPH_MIN_SEGMENT_MM)
+    #error "DEPENDENCY ERROR: Missing setting POLARGRAPH_MIN_SEGMENT_MM."
+  #endif
+  #if DISABLED(POLARGRAPH_MAX_SEGMENT_MM)
+    #error "DEPENDENCY ERROR: Missing setting POLARGRAPH_MAX_SEGMENT_MM."
+  #endif
+
+  /**
+   * Bed Leveling, Probe and Babystepping
+   */
+  #if HAS_LEVELING || HAS_BED_PROBE
+    #error "DEPENDENCY ERROR: Bed leveling and Z probes are not supported by POLARGRAPH."
+  #endif
+  #if ENABLED(BABYSTEPPING)
+    #error "DEPENDENCY ERROR: BABYSTEPPING is not implemented for POLARGRAPH yet."
+  #endif
+
+#endif // MECH(POLARGRAPH)
+
 #endif /* _MECH_SANITYCHECK_H_ */
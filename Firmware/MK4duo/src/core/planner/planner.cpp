@@ -108,6 +108,38 @@ float Planner::previous_speed[NUM_AXIS]   = { 0.0 },
   uint32_t Planner::axis_segment_time_us[2][3] = { { MAX_FREQ_TIME_US + 1, 0, 0 }, { MAX_FREQ_TIME_US + 1, 0, 0 } };
 #endif
 
+#if ENABLED(SEGMENT_MERGE)
+  float   Planner::merge_start[XYZE]                      = { 0.0 },
+          Planner::merge_end[XYZE]                        = { 0.0 },
+          Planner::merge_joint[SEGMENT_MERGE_MAX - 1][2]  = { { 0.0 } },
+          Planner::merge_fr_mm_s                          = 0.0;
+  uint8_t Planner::merge_extruder                         = 0,
+          Planner::merge_count                            = 0;
+  bool    Planner::merge_valid                            = false;
+#endif
+
+#if ENABLED(PATH_BLENDING)
+  float   Planner::blend_tolerance      = 0.0,
+          Planner::blend_start[XYZE]    = { 0.0 },
+          Planner::blend_end[XYZE]      = { 0.0 },
+          Planner::blend_fr_mm_s        = 0.0;
+  uint8_t Planner::blend_extruder       = 0;
+  bool    Planner::blend_held           = false,
+          Planner::blend_valid          = false;
+#endif
+
+#if ENABLED(CABLE_TENSION_LIMITS)
+  int32_t Planner::cable_gain_steps[2]  = { 0 };
+  float   Planner::cable_gain           = 0.0;
+#endif
+
+#if ENABLED(Z_MOTION_CHANNEL)
+  zblock_t          Planner::zblock_buffer[Z_MOTION_BUFFER_SIZE];
+  volatile uint8_t  Planner::zblock_buffer_head = 0,
+                    Planner::zblock_buffer_tail = 0;
+  bool              Planner::z_pen_up           = false;
+#endif
+
 #if ENABLED(LIN_ADVANCE)
   float Planner::extruder_advance_K   = LIN_ADVANCE_K;
 #endif
@@ -665,6 +697,81 @@ float Planner::previous_speed[NUM_AXIS]   = { 0.0 },
 
 #define MINIMAL_STEP_RATE 120
 
+#if ENABLED(FIXED_POINT_PLANNER)
+
+  static_assert(HAL_ACCELERATION_RATE > 1, "FIXED_POINT_PLANNER needs HAL_ACCELERATION_RATE over 1.");
+
+  // Smallest integer whose square is x or more
+  static uint32_t ceil_sqrt(const uint32_t x) {
+    uint32_t rem = x, root = 0, bit = 1UL << 30;
+    while (bit > rem) bit >>= 2;
+    while (bit) {
+      if (rem >= root + bit) {
+        rem -= root + bit;
+        root = (root >> 1) + bit;
+      }
+      else
+        root >>= 1;
+      bit >>= 2;
+    }
+    return rem ? root + 1 : root;
+  }
+
+  // Step rate at a squared speed, limited to the nominal rate
+  static FORCE_INLINE uint32_t speed_sqr_to_rate(const block_t * const block, const speed_sqr_t speed_sqr) {
+    const uint64_t rate_sqr = (uint64_t(speed_sqr) * block->rate_sqr_factor) >> (2 * (SPEED_SQR_BITS));
+    return rate_sqr < sq(uint32_t(block->nominal_rate)) ? ceil_sqrt(rate_sqr) : block->nominal_rate;
+  }
+
+  /**
+   * Calculate trapezoid parameters from the entry and exit squared speeds,
+   * with integer math only. Step rates are 16 bit, so their squares fit
+   * 32 bit. Same precondition as below: the block is NOT BUSY and marked
+   * as RECALCULATE.
+   */
+  void Planner::calculate_trapezoid_for_block(block_t* const block, const speed_sqr_t entry_speed_sqr, const speed_sqr_t exit_speed_sqr) {
+
+    uint32_t initial_rate = speed_sqr_to_rate(block, entry_speed_sqr),
+             final_rate   = speed_sqr_to_rate(block, exit_speed_sqr);
+
+    // Limit minimal step rate (Otherwise the timer will overflow.)
+    NOLESS(initial_rate,  uint32_t(MINIMAL_STEP_RATE));
+    NOLESS(final_rate,    uint32_t(MINIMAL_STEP_RATE));
+
+    // acceleration_rate / HAL_ACCELERATION_RATE, rounded, through a 32 bit reciprocal
+    const uint32_t accel = (uint64_t(block->acceleration_rate) * uint32_t(4294967296.0 / (HAL_ACCELERATION_RATE)) + 0x80000000UL) >> 32,
+                   accel2 = accel * 2,
+                   nominal_rate_sqr = sq(uint32_t(block->nominal_rate)),
+                   step_event_count = block->step_event_count;
+
+              // Steps required for acceleration, deceleration to/from nominal rate
+    uint32_t  accelerate_steps = 0,
+              decelerate_steps = 0;
+    if (accel) {
+      if (block->nominal_rate > initial_rate) accelerate_steps = (nominal_rate_sqr - sq(initial_rate) - 1) / accel2 + 1;
+      if (block->nominal_rate > final_rate) decelerate_steps = (nominal_rate_sqr - sq(final_rate)) / accel2;
+      NOMORE(accelerate_steps, step_event_count + 1);
+      NOMORE(decelerate_steps, step_event_count + 1);
+    }
+              // Steps between acceleration and deceleration, if any
+    int32_t   plateau_steps = int32_t(step_event_count - accelerate_steps) - int32_t(decelerate_steps);
+
+    // No cruising: accelerate up to the point where braking reaches final_rate at the end
+    if (plateau_steps < 0) {
+      const int64_t num = int64_t(accel2) * step_event_count + int64_t(final_rate) * final_rate - int64_t(initial_rate) * initial_rate;
+      accelerate_steps = num > 0 ? MIN(uint32_t((num - 1) / (accel2 * 2) + 1), step_event_count) : 0;
+      plateau_steps = 0;
+    }
+
+    // Store new block parameters
+    block->accelerate_until = accelerate_steps;
+    block->decelerate_after = accelerate_steps + plateau_steps;
+    block->initial_rate = initial_rate;
+    block->final_rate = final_rate;
+  }
+
+#else // !FIXED_POINT_PLANNER
+
 /**
  * Calculate trapezoid parameters, multiplying the entry- and exit-speeds
  * by the provided factors.
@@ -688,7 +795,11 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
     uint32_t cruise_rate = initial_rate;
   #endif
 
-  const int32_t accel = block->acceleration_steps_per_s2;
+  #if ENABLED(COMPACT_BLOCK_BUFFER)
+    const int32_t accel = LROUND(block->acceleration_rate * float(1.0 / (HAL_ACCELERATION_RATE)));
+  #else
+    const int32_t accel = block->acceleration_steps_per_s2;
+  #endif
 
             // Steps required for acceleration, deceleration to/from nominal rate
   uint32_t  accelerate_steps = CEIL(estimate_acceleration_distance(initial_rate, block->nominal_rate, accel)),
@@ -740,6 +851,8 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
 
 }
 
+#endif // !FIXED_POINT_PLANNER
+
 /*                            PLANNER SPEED DEFINITION
                                      +--------+   <- current->nominal_speed
                                     /          \
@@ -810,7 +923,7 @@ void Planner::reverse_pass_kernel(block_t* const current, const block_t* const n
     // in the next block, there is no need to recheck. Block is cruising and there is no need to
     // compute anything for this block,
     // If not, block entry speed needs to be recalculated to ensure maximum possible planned speed.
-    const float max_entry_speed_sqr = current->max_entry_speed_sqr;
+    const speed_sqr_t max_entry_speed_sqr = current->max_entry_speed_sqr;
 
     // Compute maximum entry speed decelerating over the current block from its exit speed.
     // If not at the maximum entry speed, or the previous block entry speed changed
@@ -824,9 +937,9 @@ void Planner::reverse_pass_kernel(block_t* const current, const block_t* const n
       // the reverse and forward planners, the corresponding block junction speed will always be at the
       // the maximum junction speed and may always be ignored for any speed reduction checks.
 
-      const float new_entry_speed_sqr = TEST(current->flag, BLOCK_BIT_NOMINAL_LENGTH)
+      const speed_sqr_t new_entry_speed_sqr = TEST(current->flag, BLOCK_BIT_NOMINAL_LENGTH)
         ? max_entry_speed_sqr
-        : MIN(max_entry_speed_sqr, max_allowable_speed_sqr(-current->acceleration, next ? next->entry_speed_sqr : sq(MINIMUM_PLANNER_SPEED), current->millimeters));
+        : MIN(max_entry_speed_sqr, accelerated_speed_sqr(current, next ? next->entry_speed_sqr : to_speed_sqr(sq(MINIMUM_PLANNER_SPEED))));
       if (current->entry_speed_sqr != new_entry_speed_sqr) {
 
         // Need to recalculate the block speed - Mark it now, so the stepper
@@ -914,7 +1027,7 @@ void Planner::forward_pass_kernel(const block_t* const previous, block_t* const
       previous->entry_speed_sqr < current->entry_speed_sqr) {
 
       // Compute the maximum allowable speed
-      const float new_entry_speed_sqr = max_allowable_speed_sqr(-previous->acceleration, previous->entry_speed_sqr, previous->millimeters);
+      const speed_sqr_t new_entry_speed_sqr = accelerated_speed_sqr(previous, previous->entry_speed_sqr);
 
       // If true, current block is full-acceleration and we can move the planned pointer forward.
       if (new_entry_speed_sqr < current->entry_speed_sqr) {
@@ -1027,14 +1140,18 @@ void Planner::recalculate_trapezoids() {
 
   // Go from the tail (currently executed block) to the first block, without including it)
   block_t *current = NULL, *next = NULL;
-  float current_entry_speed = 0.0, next_entry_speed = 0.0;
+  #if DISABLED(FIXED_POINT_PLANNER)
+    float current_entry_speed = 0.0, next_entry_speed = 0.0;
+  #endif
   while (block_index != head_block_index) {
 
     next = &block_buffer[block_index];
 
     // Skip sync blocks
     if (!TEST(next->flag, BLOCK_BIT_SYNC_POSITION)) {
-      next_entry_speed = SQRT(next->entry_speed_sqr);
+      #if DISABLED(FIXED_POINT_PLANNER)
+        next_entry_speed = SQRT(next->entry_speed_sqr);
+      #endif
 
       if (current) {
         // Recalculate if current block entry or exit junction speed has changed.
@@ -1051,16 +1168,20 @@ void Planner::recalculate_trapezoids() {
           if (!stepper.is_block_busy(current)) {
             // Block is not BUSY, we won the race against the Stepper ISR:
 
-            // NOTE: Entry and exit factors always > 0 by all previous logic operations.
-            const float current_nominal_speed = SQRT(current->nominal_speed_sqr),
-                        nomr = 1.0 / current_nominal_speed;
-            calculate_trapezoid_for_block(current, current_entry_speed * nomr, next_entry_speed * nomr);
-            #if ENABLED(LIN_ADVANCE)
-              if (current->use_advance_lead) {
-                const float comp = current->e_D_ratio * extruder_advance_K * mechanics.data.axis_steps_per_mm[E_INDEX];
-                current->max_adv_steps = current_nominal_speed * comp;
-                current->final_adv_steps = next_entry_speed * comp;
-              }
+            #if ENABLED(FIXED_POINT_PLANNER)
+              calculate_trapezoid_for_block(current, current->entry_speed_sqr, next->entry_speed_sqr);
+            #else
+              // NOTE: Entry and exit factors always > 0 by all previous logic operations.
+              const float current_nominal_speed = SQRT(current->nominal_speed_sqr),
+                          nomr = 1.0 / current_nominal_speed;
+              calculate_trapezoid_for_block(current, current_entry_speed * nomr, next_entry_speed * nomr);
+              #if ENABLED(LIN_ADVANCE)
+                if (current->use_advance_lead) {
+                  const float comp = current->e_D_ratio * extruder_advance_K * mechanics.data.axis_steps_per_mm[E_INDEX];
+                  current->max_adv_steps = current_nominal_speed * comp;
+                  current->final_adv_steps = next_entry_speed * comp;
+                }
+              #endif
             #endif
           }
 
@@ -1071,7 +1192,9 @@ void Planner::recalculate_trapezoids() {
       }
 
       current = next;
-      current_entry_speed = next_entry_speed;
+      #if DISABLED(FIXED_POINT_PLANNER)
+        current_entry_speed = next_entry_speed;
+      #endif
     }
 
     block_index = next_block_index(block_index);
@@ -1091,15 +1214,19 @@ void Planner::recalculate_trapezoids() {
     if (!stepper.is_block_busy(current)) {
       // Block is not BUSY, we won the race against the Stepper ISR:
 
-      const float next_nominal_speed = SQRT(next->nominal_speed_sqr),
-                  nomr = 1.0 / next_nominal_speed;
-      calculate_trapezoid_for_block(next, next_entry_speed * nomr, (MINIMUM_PLANNER_SPEED) * nomr);
-      #if ENABLED(LIN_ADVANCE)
-        if (next->use_advance_lead) {
-          const float comp = next->e_D_ratio * extruder_advance_K * mechanics.data.axis_steps_per_mm[E_INDEX];
-          next->max_adv_steps = next_nominal_speed * comp;
-          next->final_adv_steps = (MINIMUM_PLANNER_SPEED) * comp;
-        }
+      #if ENABLED(FIXED_POINT_PLANNER)
+        calculate_trapezoid_for_block(next, next->entry_speed_sqr, to_speed_sqr(sq(MINIMUM_PLANNER_SPEED)));
+      #else
+        const float next_nominal_speed = SQRT(next->nominal_speed_sqr),
+                    nomr = 1.0 / next_nominal_speed;
+        calculate_trapezoid_for_block(next, next_entry_speed * nomr, (MINIMUM_PLANNER_SPEED) * nomr);
+        #if ENABLED(LIN_ADVANCE)
+          if (next->use_advance_lead) {
+            const float comp = next->e_D_ratio * extruder_advance_K * mechanics.data.axis_steps_per_mm[E_INDEX];
+            next->max_adv_steps = next_nominal_speed * comp;
+            next->final_adv_steps = (MINIMUM_PLANNER_SPEED) * comp;
+          }
+        #endif
       #endif
     }
 
@@ -1200,6 +1327,10 @@ void Planner::check_axes_activity() {
   #if DISABLE_Y
     if (!axis_active[Y_AXIS]) stepper.disable_Y();
   #endif
+  #if ENABLED(Z_MOTION_CHANNEL)
+    if (has_zblocks_queued()) axis_active[Z_AXIS]++;
+  #endif
+
   #if DISABLE_Z
     if (!axis_active[Z_AXIS]) stepper.disable_Z();
   #endif
@@ -1283,6 +1414,21 @@ void Planner::quick_stop() {
   // Drop all queue entries
   block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail;
 
+  #if ENABLED(Z_MOTION_CHANNEL)
+    // And the Z moves, the busy one is stopped by the Stepper ISR
+    zblock_buffer_head = zblock_buffer_tail;
+  #endif
+
+  #if ENABLED(SEGMENT_MERGE)
+    // And the segment held back
+    merge_count = 0;
+    merge_valid = false;
+  #endif
+  #if ENABLED(PATH_BLENDING)
+    blend_held = false;
+    blend_valid = false;
+  #endif
+
   //  And restart the block delay for the first movement - As the queue was
   // forced to empty, there is no risk the ISR could touch this variable.
   delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
@@ -1353,7 +1499,20 @@ float Planner::get_axis_position_mm(const AxisEnum axis) {
 }
 
 void Planner::synchronize() {
-  while (has_blocks_queued() || cleaning_buffer_flag) {
+  #if ENABLED(SEGMENT_MERGE)
+    flush_merge();
+  #endif
+  #if ENABLED(PATH_BLENDING)
+    flush_blend();
+  #endif
+  while (has_blocks_queued() || cleaning_buffer_flag
+    #if ENABLED(INPUT_SHAPING)
+      || stepper.shaping_busy()
+    #endif
+    #if ENABLED(Z_MOTION_CHANNEL)
+      || has_zblocks_queued()
+    #endif
+  ) {
     printer.idle();
     printer.keepalive(InProcess);
   }
@@ -1390,6 +1549,52 @@ bool Planner::buffer_steps(const int32_t (&target)[XYZE]
   // If we are cleaning, do not accept queuing of movements
   if (cleaning_buffer_flag) return false;
 
+  #if ENABLED(COMPACT_BLOCK_BUFFER)
+
+    // Step counts are 16 bit, queue longer moves in equal parts
+    float max_steps = ABS((target[E_AXIS] - position[E_AXIS]) * tools.e_factor[extruder]);
+    #if IS_CORE
+      // Core motors step up to the sum of their axes
+      NOLESS(max_steps, ABS(target[X_AXIS] - position[X_AXIS]) + ABS(target[Y_AXIS] - position[Y_AXIS]) + ABS(target[Z_AXIS] - position[Z_AXIS]));
+    #else
+      LOOP_XYZ(i) NOLESS(max_steps, ABS(target[i] - position[i]));
+    #endif
+
+    const uint16_t parts = max_steps / (UINT16_MAX) + 1;
+    if (parts > 1) {
+      const int32_t start[XYZE] = { position[X_AXIS], position[Y_AXIS], position[Z_AXIS], position[E_AXIS] };
+      #if HAS_POSITION_FLOAT
+        const float start_float[XYZE] = { position_float[X_AXIS], position_float[Y_AXIS], position_float[Z_AXIS], position_float[E_AXIS] };
+        float part_float[XYZE];
+      #endif
+      #if IS_KINEMATIC && ENABLED(JUNCTION_DEVIATION)
+        float part_mm_cart[XYZE];
+        LOOP_XYZE(i) part_mm_cart[i] = delta_mm_cart[i] / parts;
+      #endif
+      int32_t part[XYZE];
+      for (uint16_t p = 1; p <= parts; p++) {
+        const float ratio = float(p) / parts;
+        LOOP_XYZE(i) {
+          part[i] = p == parts ? target[i] : start[i] + LROUND((target[i] - start[i]) * ratio);
+          #if HAS_POSITION_FLOAT
+            part_float[i] = p == parts ? target_float[i] : start_float[i] + (target_float[i] - start_float[i]) * ratio;
+          #endif
+        }
+        if (!buffer_steps(part
+          #if HAS_POSITION_FLOAT
+            , part_float
+          #endif
+          #if IS_KINEMATIC && ENABLED(JUNCTION_DEVIATION)
+            , part_mm_cart
+          #endif
+          , fr_mm_s, extruder, millimeters / parts
+        )) return false;
+      }
+      return true;
+    }
+
+  #endif // COMPACT_BLOCK_BUFFER
+
   // Wait for the next available block
   uint8_t next_buffer_head;
   block_t * const block = get_next_free_block(next_buffer_head);
@@ -1946,12 +2151,18 @@ bool Planner::fill_block(block_t * const block, bool split_move,
     if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
 
     block_buffer_runtime_us += segment_time_us;
+    block->segment_time_us = segment_time_us;
 
     // Reenable Stepper ISR
     if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
   #endif
 
-  block->nominal_speed_sqr = sq(block->millimeters * inverse_secs);   //   (mm/sec)^2 Always > 0
+  #if ENABLED(COMPACT_BLOCK_BUFFER)
+    // Step rates are 16 bit, slow down faster moves
+    NOMORE(inverse_secs, float(UINT16_MAX - 1) / block->step_event_count);
+  #endif
+
+  float nominal_speed_sqr = sq(block->millimeters * inverse_secs);    //   (mm/sec)^2 Always > 0
   block->nominal_rate = CEIL(block->step_event_count * inverse_secs); // (step/sec) Always > 0
 
   #if ENABLED(FILAMENT_SENSOR)
@@ -1988,11 +2199,29 @@ bool Planner::fill_block(block_t * const block, bool split_move,
     }
   #endif
 
+  #if ENABLED(CABLE_TENSION_LIMITS)
+    // Weakest tension along the block, the start is where the last block ended
+    const float start_gain = (position[A_AXIS] == cable_gain_steps[0] && position[B_AXIS] == cable_gain_steps[1])
+                             ? cable_gain : cable_tension_gain(position[A_AXIS], position[B_AXIS]);
+    cable_gain_steps[0] = target[A_AXIS];
+    cable_gain_steps[1] = target[B_AXIS];
+    cable_gain = cable_tension_gain(target[A_AXIS], target[B_AXIS]);
+    const float tension_gain = MIN(start_gain, cable_gain),
+                feedrate_gain = 1.0 + ((CABLE_FEEDRATE_GAIN) - 1.0) * tension_gain;
+  #endif
+
   // Calculate and limit speed in mm/sec for each axis
   float current_speed[NUM_AXIS], speed_factor = 1.0f; // factor <1 decreases speed
   LOOP_XYZE(i) {
     const float delta_mm_i = delta_mm[i];
     const float cs = ABS(current_speed[i] = delta_mm_i * inverse_secs);
+    #if ENABLED(CABLE_TENSION_LIMITS)
+      if (i == A_AXIS || i == B_AXIS) {
+        const float max_fr = mechanics.data.max_feedrate_mm_s[i] * feedrate_gain;
+        if (cs > max_fr) NOMORE(speed_factor, max_fr / cs);
+        continue;
+      }
+    #endif
     if (i == E_AXIS) i += extruder;
     if (cs > mechanics.data.max_feedrate_mm_s[i]) NOMORE(speed_factor, mechanics.data.max_feedrate_mm_s[i] / cs);
   }
@@ -2039,7 +2268,7 @@ bool Planner::fill_block(block_t * const block, bool split_move,
   if (speed_factor < 1.0) {
     LOOP_XYZE(i) current_speed[i] *= speed_factor;
     block->nominal_rate *= speed_factor;
-    block->nominal_speed_sqr *= sq(speed_factor);
+    nominal_speed_sqr *= sq(speed_factor);
   }
 
   // Compute and limit the acceleration rate for the trapezoid generator.
@@ -2068,7 +2297,12 @@ bool Planner::fill_block(block_t * const block, bool split_move,
     }while(0)
 
     // Start with print or travel acceleration
-    accel = CEIL((esteps ? mechanics.data.acceleration : mechanics.data.travel_acceleration) * steps_per_mm);
+    #if ENABLED(CABLE_TENSION_LIMITS)
+      accel = CEIL((esteps ? mechanics.data.acceleration : mechanics.data.travel_acceleration)
+                   * (1.0 + ((CABLE_ACCELERATION_GAIN) - 1.0) * tension_gain) * steps_per_mm);
+    #else
+      accel = CEIL((esteps ? mechanics.data.acceleration : mechanics.data.travel_acceleration) * steps_per_mm);
+    #endif
 
     #if ENABLED(LIN_ADVANCE)
 
@@ -2131,7 +2365,9 @@ bool Planner::fill_block(block_t * const block, bool split_move,
       LIMIT_ACCEL_FLOAT(E_AXIS, extruder);
     }
   }
-  block->acceleration_steps_per_s2 = accel;
+  #if DISABLED(COMPACT_BLOCK_BUFFER)
+    block->acceleration_steps_per_s2 = accel;
+  #endif
   block->acceleration = accel / steps_per_mm;
   #if DISABLED(BEZIER_JERK_CONTROL)
     block->acceleration_rate = (uint32_t)(accel * (HAL_ACCELERATION_RATE));
@@ -2140,7 +2376,7 @@ bool Planner::fill_block(block_t * const block, bool split_move,
     if (block->use_advance_lead) {
       block->advance_speed = (STEPPER_TIMER_RATE) / (extruder_advance_K * block->e_D_ratio * block->acceleration * mechanics.data.axis_steps_per_mm[E_AXIS_N(extruder)]);
       #if ENABLED(LA_DEBUG)
-        if (extruder_advance_K * block->e_D_ratio * block->acceleration * 2 < SQRT(block->nominal_speed_sqr) * block->e_D_ratio)
+        if (extruder_advance_K * block->e_D_ratio * block->acceleration * 2 < SQRT(nominal_speed_sqr) * block->e_D_ratio)
           SERIAL_EM("More than 2 steps per eISR loop executed.");
         if (block->advance_speed < 200)
           SERIAL_EM("eISR running at > 10kHz.");
@@ -2215,7 +2451,7 @@ bool Planner::fill_block(block_t * const block, bool split_move,
       }
 
       // Get the lowest speed
-      vmax_junction_sqr = MIN(vmax_junction_sqr, block->nominal_speed_sqr, previous_nominal_speed_sqr);
+      vmax_junction_sqr = MIN(vmax_junction_sqr, nominal_speed_sqr, previous_nominal_speed_sqr);
     }
     else // Init entry speed to zero. Assume it starts from rest. Planner will correct this later.
       vmax_junction_sqr = 0;
@@ -2226,7 +2462,7 @@ bool Planner::fill_block(block_t * const block, bool split_move,
 
   #if HAS_CLASSIC_JERK
 
-    const float nominal_speed = SQRT(block->nominal_speed_sqr);
+    const float nominal_speed = SQRT(nominal_speed_sqr);
 
     // Exit speed limited by a jerk to full halt of a previous last segment
     static float previous_safe_speed;
@@ -2321,14 +2557,14 @@ bool Planner::fill_block(block_t * const block, bool split_move,
   #endif // Classic Jerk Limiting
 
   // Max entry speed of this block equals the max exit speed of the previous block.
-  block->max_entry_speed_sqr = vmax_junction_sqr;
+  block->max_entry_speed_sqr = to_speed_sqr(vmax_junction_sqr);
 
   // Initialize block entry speed. Compute based on deceleration to user-defined MINIMUM_PLANNER_SPEED.
   const float v_allowable_sqr = max_allowable_speed_sqr(-block->acceleration, sq(MINIMUM_PLANNER_SPEED), block->millimeters);
 
   // If we are trying to add a split block, start with the
   // max. allowed speed to avoid an interrupted first move.
-  block->entry_speed_sqr = !split_move ? sq(MINIMUM_PLANNER_SPEED) : MIN(vmax_junction_sqr, v_allowable_sqr);
+  block->entry_speed_sqr = to_speed_sqr(!split_move ? sq(MINIMUM_PLANNER_SPEED) : MIN(vmax_junction_sqr, v_allowable_sqr));
 
   // Initialize planner efficiency flags
   // Set flag if block will always reach maximum junction speed regardless of entry/exit speeds.
@@ -2338,11 +2574,22 @@ bool Planner::fill_block(block_t * const block, bool split_move,
   // block nominal speed limits both the current and next maximum junction speeds. Hence, in both
   // the reverse and forward planners, the corresponding block junction speed will always be at the
   // the maximum junction speed and may always be ignored for any speed reduction checks.
-  block->flag |= block->nominal_speed_sqr <= v_allowable_sqr ? BLOCK_FLAG_RECALCULATE | BLOCK_FLAG_NOMINAL_LENGTH : BLOCK_FLAG_RECALCULATE;
+  block->flag |= nominal_speed_sqr <= v_allowable_sqr ? BLOCK_FLAG_RECALCULATE | BLOCK_FLAG_NOMINAL_LENGTH : BLOCK_FLAG_RECALCULATE;
+
+  block->nominal_speed_sqr = to_speed_sqr(nominal_speed_sqr);
+
+  #if ENABLED(FIXED_POINT_PLANNER)
+    // Length and acceleration are not needed anymore, store what the integer planner uses in their place
+    const speed_sqr_t accel_speed_sqr = to_speed_sqr(2 * block->acceleration * block->millimeters);
+    float rate_sqr_factor = sq(float(block->nominal_rate)) / nominal_speed_sqr * float(1UL << (SPEED_SQR_BITS));
+    NOMORE(rate_sqr_factor, float(0xFFFFFF00UL));
+    block->accel_speed_sqr = accel_speed_sqr;
+    block->rate_sqr_factor = rate_sqr_factor;
+  #endif
 
   // Update previous path unit_vector and nominal speed
   COPY_ARRAY(previous_speed, current_speed);
-  previous_nominal_speed_sqr = block->nominal_speed_sqr;
+  previous_nominal_speed_sqr = nominal_speed_sqr;
 
   // Update the position (only when a move was queued)
   static_assert(COUNT(target) > 1, "Parameter to buffer_steps must be (&target)[XYZE]!");
@@ -2390,6 +2637,118 @@ void Planner::buffer_sync_block() {
   stepper.wake_up();
 }
 
+#if ENABLED(Z_MOTION_CHANNEL)
+
+  /**
+   * Planner::z_sync_needed
+   * Is a block queued that a Z move must not run across?
+   * A position sync would overwrite the Z count, a planner
+   * block with Z steps would drive the same motor.
+   */
+  bool Planner::z_sync_needed() {
+    for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
+      const block_t * const block = &block_buffer[b];
+      if (TEST(block->flag, BLOCK_BIT_SYNC_POSITION) ? !TEST(block->flag, BLOCK_BIT_SYNC_Z) : block->steps[C_AXIS])
+        return true;
+    }
+    return false;
+  }
+
+  /**
+   * Planner::buffer_z_line
+   *
+   * Queue a move of Z alone on the Z motion channel.
+   *
+   * While the pen is up, a move further up (pen selection) starts
+   * at once and the following travel runs along with it. Any other
+   * move is ordered: a BLOCK_BIT_SYNC_Z block in the planner buffer
+   * starts it once the moves before are done, and the moves after
+   * wait for it to end.
+   *
+   *  rz      - target position in mm
+   *  fr_mm_s - (target) speed of the move
+   */
+  void Planner::buffer_z_line(const float &rz, const float &fr_mm_s) {
+
+    // If we are cleaning, do not accept queuing of movements
+    if (cleaning_buffer_flag) return;
+
+    #if ENABLED(SEGMENT_MERGE)
+      flush_merge();
+      merge_valid = false;
+    #endif
+    #if ENABLED(PATH_BLENDING)
+      flush_blend();
+      blend_valid = false;
+    #endif
+
+    const float steps_per_mm = mechanics.data.axis_steps_per_mm[C_AXIS];
+    const int32_t target = static_cast<int32_t>(FLOOR(rz * steps_per_mm + 0.5f)),
+                  dz = target - position[C_AXIS];
+
+    if (dz) {
+      const bool  up = (dz > 0) == (steps_per_mm > 0),
+                  ordered = !up || !z_pen_up || z_sync_needed();
+
+      // Steps per second and per second squared
+      const float abs_steps_per_mm = ABS(steps_per_mm),
+                  rate = MIN(fr_mm_s, mechanics.data.max_feedrate_mm_s[Z_AXIS]) * abs_steps_per_mm,
+                  accel = MIN(mechanics.data.travel_acceleration, (float)mechanics.data.max_acceleration_mm_per_s2[Z_AXIS]) * abs_steps_per_mm;
+
+      // To steps per tick, 32 fractional bits
+      constexpr float tick_scale = 4294967296.0f / float(Z_MOTION_STEP_RATE);
+      const float acceleration = MAX(accel * tick_scale / float(Z_MOTION_STEP_RATE), 1.0f),
+                  nominal_speed = constrain(rate * tick_scale, 1.0f, 2147483648.0f),
+                  initial_speed = MIN(SQRT(2.0f * acceleration * 4294967296.0f), nominal_speed);
+
+      // Wait for a free Z slot
+      const uint8_t next_head = ZBLOCK_MOD(zblock_buffer_head + 1);
+      while (next_head == zblock_buffer_tail) printer.idle();
+
+      zblock_t * const zblock = &zblock_buffer[zblock_buffer_head];
+      zblock->step_count    = ABS(dz);
+      zblock->initial_speed = initial_speed;
+      zblock->nominal_speed = nominal_speed;
+      zblock->acceleration  = acceleration;
+      zblock->direction     = dz > 0 ? 1 : -1;
+      zblock->ordered       = ordered;
+
+      // The ordered move first, so the Stepper ISR finds it at the barrier
+      zblock_buffer_head = next_head;
+
+      if (ordered) {
+        uint8_t next_buffer_head;
+        block_t * const block = get_next_free_block(next_buffer_head);
+        memset(block, 0, sizeof(block_t));
+        block->flag = BLOCK_FLAG_SYNC_POSITION | BLOCK_FLAG_SYNC_Z;
+
+        if (block_buffer_head == block_buffer_tail)
+          delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
+
+        block_buffer_head = next_buffer_head;
+
+        // The travel stops at the barrier
+        previous_nominal_speed_sqr = 0.0;
+        ZERO(previous_speed);
+      }
+
+      z_pen_up = up;
+      position[C_AXIS] = target;
+
+      stepper.enable_Z();
+      stepper.wake_up();
+    }
+
+    #if HAS_POSITION_FLOAT
+      position_float[C_AXIS] = rz;
+    #endif
+    #if IS_KINEMATIC
+      position_cart[Z_AXIS] = rz;
+    #endif
+  }
+
+#endif // ENABLED(Z_MOTION_CHANNEL)
+
 /**
  * Planner::buffer_segment
  *
@@ -2412,6 +2771,38 @@ bool Planner::buffer_segment(const float &a, const float &b, const float &c, con
   // If we are cleaning, do not accept queuing of movements
   if (cleaning_buffer_flag) return false;
 
+  #if ENABLED(SEGMENT_MERGE) || ENABLED(PATH_BLENDING)
+    const float target_mm[XYZE] = { a, b, c, e };
+  #endif
+
+  #if ENABLED(SEGMENT_MERGE)
+    // Hold back the segment if it may be merged with the next ones
+    if (merge_segment(target_mm, fr_mm_s, extruder, millimeters == 0.0)) return true;
+  #endif
+
+  #if ENABLED(PATH_BLENDING)
+    // Hold back the segment to blend its end with the next one
+    if (blend_segment(target_mm, fr_mm_s, extruder, millimeters == 0.0)) return true;
+  #endif
+
+  return queue_segment(a, b, c, e
+    #if IS_KINEMATIC && ENABLED(JUNCTION_DEVIATION)
+      , delta_mm_cart
+    #endif
+    , fr_mm_s, extruder, millimeters
+  );
+}
+
+bool Planner::queue_segment(const float &a, const float &b, const float &c, const float &e
+  #if IS_KINEMATIC && ENABLED(JUNCTION_DEVIATION)
+    , const float (&delta_mm_cart)[XYZE]
+  #endif
+  , const float &fr_mm_s, const uint8_t extruder, const float &millimeters/*=0.0*/
+) {
+
+  // If we are cleaning, do not accept queuing of movements
+  if (cleaning_buffer_flag) return false;
+
   // The target position of the tool in absolute steps
   // Calculate target position in absolute steps
   const int32_t target[XYZE] = {
@@ -2551,6 +2942,267 @@ bool Planner::buffer_line(const float &rx, const float &ry, const float &rz, con
 
 }
 
+#if ENABLED(SEGMENT_MERGE)
+
+  /**
+   * Queue the segment held back, then go on tracking
+   * from its end as the last segment queued.
+   */
+  void Planner::flush_merge() {
+    if (!merge_count) return;
+    merge_count = 0;
+    merge_valid = false; // So buffer_segment queues it
+    buffer_segment(merge_end, merge_fr_mm_s, merge_extruder);
+  }
+
+  /**
+   * Merge a segment into the held one, or hold it to be merged later.
+   * Only moves of A/B at the same speed are merged, as long as every
+   * joint merged away is within SEGMENT_MERGE_TOLERANCE of the chord.
+   * Return false if the segment must be queued now.
+   */
+  bool Planner::merge_segment(const float (&target)[XYZE], const float &fr_mm_s, const uint8_t extruder, const bool mergeable) {
+
+    // Where the segment starts is unknown, queue it and track from its end
+    if (!merge_valid) {
+      COPY_ARRAY(merge_end, target);
+      merge_valid = true;
+      return false;
+    }
+
+    const bool planar = mergeable && target[C_AXIS] == merge_end[C_AXIS] && target[E_AXIS] == merge_end[E_AXIS];
+
+    if (merge_count) {
+      if (planar && fr_mm_s == merge_fr_mm_s && extruder == merge_extruder
+        && merge_count < SEGMENT_MERGE_MAX && merge_fits(target[A_AXIS], target[B_AXIS])
+      ) {
+        merge_joint[merge_count - 1][0] = merge_end[A_AXIS];
+        merge_joint[merge_count - 1][1] = merge_end[B_AXIS];
+        merge_count++;
+        COPY_ARRAY(merge_end, target);
+        return true;
+      }
+      flush_merge();
+    }
+
+    // Pen or extruder moves, and segments of a known length, go through as they are
+    if (!planar) {
+      COPY_ARRAY(merge_end, target);
+      return false;
+    }
+
+    COPY_ARRAY(merge_start, merge_end);
+    COPY_ARRAY(merge_end, target);
+    merge_fr_mm_s = fr_mm_s;
+    merge_extruder = extruder;
+    merge_count = 1;
+    return true;
+  }
+
+  /**
+   * Distance of the point p from the chord c, both relative to the
+   * chord start, within SEGMENT_MERGE_TOLERANCE. No division, the
+   * projection on the chord is compared with its squared length.
+   */
+  static bool joint_fits(const float pa, const float pb, const float ca, const float cb, const float chord_sq) {
+    constexpr float tol_sq = sq(SEGMENT_MERGE_TOLERANCE);
+    const float dot = pa * ca + pb * cb;
+    if (dot <= 0.0)                                   // Before the chord start
+      return sq(pa) + sq(pb) <= tol_sq;
+    if (dot >= chord_sq)                              // Past the chord end
+      return sq(pa - ca) + sq(pb - cb) <= tol_sq;
+    return sq(pa * cb - pb * ca) <= tol_sq * chord_sq;
+  }
+
+  // All the joints held within tolerance of the chord ending in a,b
+  bool Planner::merge_fits(const float &a, const float &b) {
+
+    const float ca = a - merge_start[A_AXIS],
+                cb = b - merge_start[B_AXIS],
+                chord_sq = sq(ca) + sq(cb);
+
+    for (uint8_t i = 0; i < merge_count - 1; i++)
+      if (!joint_fits(merge_joint[i][0] - merge_start[A_AXIS], merge_joint[i][1] - merge_start[B_AXIS], ca, cb, chord_sq))
+        return false;
+
+    return joint_fits(merge_end[A_AXIS] - merge_start[A_AXIS], merge_end[B_AXIS] - merge_start[B_AXIS], ca, cb, chord_sq);
+  }
+
+#endif // SEGMENT_MERGE
+
+#if ENABLED(PATH_BLENDING)
+
+  /**
+   * Queue the segment held back, up to its end,
+   * then go on tracking from there.
+   */
+  void Planner::flush_blend() {
+    if (!blend_held) return;
+    blend_held = false;
+    queue_segment(blend_end[A_AXIS], blend_end[B_AXIS], blend_end[C_AXIS], blend_end[E_AXIS], blend_fr_mm_s, blend_extruder);
+  }
+
+  /**
+   * Hold back an A/B segment until the next one shows the corner at its end.
+   * Pen or extruder moves, and segments of a known length, end the path.
+   * Return false if the segment must be queued now.
+   */
+  bool Planner::blend_segment(const float (&target)[XYZE], const float &fr_mm_s, const uint8_t extruder, const bool blendable) {
+
+    // Where the segment starts is unknown, queue it and track from its end
+    if (!blend_valid) {
+      COPY_ARRAY(blend_end, target);
+      blend_valid = true;
+      return false;
+    }
+
+    const bool planar = blendable && blend_tolerance > 0.0 && target[C_AXIS] == blend_end[C_AXIS] && target[E_AXIS] == blend_end[E_AXIS];
+
+    if (blend_held) {
+      if (planar && extruder == blend_extruder)
+        blend_corner(target, fr_mm_s);
+      else
+        flush_blend();
+    }
+
+    if (!planar) {
+      COPY_ARRAY(blend_end, target);
+      return false;
+    }
+
+    if (!blend_held) {
+      COPY_ARRAY(blend_start, blend_end);
+      blend_held = true;
+    }
+    COPY_ARRAY(blend_end, target);
+    blend_fr_mm_s = fr_mm_s;
+    blend_extruder = extruder;
+    return true;
+  }
+
+  /**
+   * Largest turn of a junction taken at fr_mm_s without slowing down
+   */
+  static float blend_free_turn(const float &fr_mm_s) {
+    #if ENABLED(JUNCTION_DEVIATION)
+      // vmax_junction_sqr = accel * deviation * c / (1 - c), c = cos(turn / 2)
+      const float v_sqr = sq(fr_mm_s),
+                  c = v_sqr / (v_sqr + mechanics.data.acceleration * mechanics.data.junction_deviation_mm);
+      return 2.0f * ATAN2(SQRT(1.0f - sq(c)), c);
+    #else
+      // The axis speeds change by up to 2 * v * sin(turn / 2), within jerk
+      const float s = MIN(mechanics.data.max_jerk[A_AXIS], mechanics.data.max_jerk[B_AXIS]) / (2.0f * fr_mm_s);
+      return s < 1.0f ? 2.0f * ATAN2(s, SQRT(1.0f - sq(s))) : M_PI;
+    #endif
+  }
+
+  /**
+   * Queue the held segment, replacing the corner at its end with an arc
+   * tangent to both segments, passing within blend_tolerance of the corner.
+   * The arc is split in chords, enough for each junction to be taken near
+   * the nominal speed, up to PATH_BLENDING_SEGMENTS. The new segment past
+   * the arc becomes the held one, cut back at most to half its length.
+   */
+  void Planner::blend_corner(const float (&target)[XYZE], const float &fr_mm_s) {
+
+    const float a1 = blend_end[A_AXIS] - blend_start[A_AXIS],
+                b1 = blend_end[B_AXIS] - blend_start[B_AXIS],
+                a2 = target[A_AXIS] - blend_end[A_AXIS],
+                b2 = target[B_AXIS] - blend_end[B_AXIS],
+                len1 = HYPOT(a1, b1),
+                len2 = HYPOT(a2, b2);
+
+    if (len1 > 0.0 && len2 > 0.0) {
+
+      const float cross = a1 * b2 - b1 * a2,
+                  turn = ATAN2(ABS(cross), a1 * a2 + b1 * b2),
+                  fr = MIN(fr_mm_s, blend_fr_mm_s),
+                  free_turn = blend_free_turn(fr);
+
+      // Nothing to gain on gentle turns, no loop around a reversal
+      if (turn > free_turn && turn < RADIANS(170)) {
+
+        const uint8_t chords = turn <= 2.0f * free_turn ? 1 : MIN(uint8_t(CEIL(turn / free_turn)), PATH_BLENDING_SEGMENTS);
+
+        // The arc midpoint is within tolerance, or the middle chord with an odd count
+        const float half = 0.5f * turn,
+                    tan_half = SIN(half) / COS(half),
+                    inner = (chords & 1) ? COS(half / chords) : 1.0f;
+        float radius = blend_tolerance / (1.0f / COS(half) - inner),
+              cut = radius * tan_half;
+        NOMORE(cut, MIN(len1, 0.5f * len2));
+        radius = cut / tan_half;
+
+        const float ua1 = a1 / len1, ub1 = b1 / len1,
+                    ua2 = a2 / len2, ub2 = b2 / len2,
+                    side = cross > 0.0 ? 1.0f : -1.0f;
+
+        // Held segment up to the arc
+        const float qa = blend_end[A_AXIS] - ua1 * cut,
+                    qb = blend_end[B_AXIS] - ub1 * cut;
+        if (cut < len1)
+          queue_segment(qa, qb, blend_end[C_AXIS], blend_end[E_AXIS], blend_fr_mm_s, blend_extruder);
+
+        // Inner chords, rotating the radius around the arc center
+        const float ca = qa - side * ub1 * radius,
+                    cb = qb + side * ua1 * radius,
+                    step = side * turn / chords,
+                    cos_step = COS(step), sin_step = SIN(step);
+        float ra = qa - ca, rb = qb - cb;
+        for (uint8_t i = 1; i < chords; i++) {
+          const float r = ra * cos_step - rb * sin_step;
+          rb = rb * cos_step + ra * sin_step;
+          ra = r;
+          queue_segment(ca + ra, cb + rb, blend_end[C_AXIS], blend_end[E_AXIS], fr, blend_extruder);
+        }
+
+        // Last chord ends on the new segment
+        blend_start[A_AXIS] = blend_end[A_AXIS] + ua2 * cut;
+        blend_start[B_AXIS] = blend_end[B_AXIS] + ub2 * cut;
+        blend_start[C_AXIS] = blend_end[C_AXIS];
+        blend_start[E_AXIS] = blend_end[E_AXIS];
+        queue_segment(blend_start[A_AXIS], blend_start[B_AXIS], blend_start[C_AXIS], blend_start[E_AXIS], fr, blend_extruder);
+        return;
+      }
+    }
+
+    // Corner taken as it is
+    queue_segment(blend_end[A_AXIS], blend_end[B_AXIS], blend_end[C_AXIS], blend_end[E_AXIS], blend_fr_mm_s, blend_extruder);
+    COPY_ARRAY(blend_start, blend_end);
+  }
+
+#endif // PATH_BLENDING
+
+#if ENABLED(CABLE_TENSION_LIMITS)
+
+  /**
+   * Gain of the acceleration and feedrate limits for the robot
+   * hanging from cords A (left) and B (right), from 0 at
+   * CABLE_TENSION_LOW to 1 at CABLE_TENSION_HIGH.
+   *
+   * With the robot at x right of the left nail and y below the nails,
+   * the static balance gives the cord tensions in robot weights:
+   *   TA = A * (D - x) / (y * D)    TB = B * x / (y * D)
+   *
+   * D is the mechanics nail distance (M665 D, saved in EEPROM).
+   */
+  float Planner::cable_tension_gain(const int32_t a_steps, const int32_t b_steps) {
+
+    const float D = mechanics.data.nail_distance,
+                a = a_steps * mechanics.steps_to_mm[A_AXIS],
+                b = b_steps * mechanics.steps_to_mm[B_AXIS],
+                x = constrain((sq(a) - sq(b) + sq(D)) / (2 * D), 0, D),
+                y_sq = sq(a) - sq(x);
+
+    // On the nail line or out of the wall, keep the base limits
+    if (y_sq < 1.0) return 0.0;
+
+    const float tension = MIN(a * (D - x), b * x) / (SQRT(y_sq) * D);
+    return constrain((tension - (CABLE_TENSION_LOW)) * (1.0 / ((CABLE_TENSION_HIGH) - (CABLE_TENSION_LOW))), 0.0, 1.0);
+  }
+
+#endif // CABLE_TENSION_LIMITS
+
 /**
  * Directly set the planner ABC position (and stepper positions)
  * converting mm (or angles for SCARA) into steps.
@@ -2559,6 +3211,15 @@ bool Planner::buffer_line(const float &rx, const float &ry, const float &rz, con
  */
 void Planner::set_machine_position_mm(const float &a, const float &b, const float &c, const float &e) {
 
+  #if ENABLED(SEGMENT_MERGE)
+    flush_merge();
+    merge_valid = false;
+  #endif
+  #if ENABLED(PATH_BLENDING)
+    flush_blend();
+    blend_valid = false;
+  #endif
+
   position[A_AXIS] = static_cast<int32_t>(FLOOR(a * mechanics.data.axis_steps_per_mm[A_AXIS] + 0.5f));
   position[B_AXIS] = static_cast<int32_t>(FLOOR(b * mechanics.data.axis_steps_per_mm[B_AXIS] + 0.5f));
   position[C_AXIS] = static_cast<int32_t>(FLOOR(c * mechanics.data.axis_steps_per_mm[C_AXIS] + 0.5f));
@@ -2571,7 +3232,12 @@ void Planner::set_machine_position_mm(const float &a, const float &b, const floa
     position_float[E_AXIS] = e;
   #endif
 
-  if (has_blocks_queued()) {
+  // With Z moves running, the sync block waits for them
+  if (has_blocks_queued()
+    #if ENABLED(Z_MOTION_CHANNEL)
+      || has_zblocks_queued()
+    #endif
+  ) {
     //previous_nominal_speed_sqr = 0.0;
     //ZERO(previous_speed);
     buffer_sync_block();
@@ -2608,6 +3274,15 @@ void Planner::set_position_mm(const float &rx, const float &ry, const float &rz,
 
 void Planner::set_e_position_mm(const float &e) {
 
+  #if ENABLED(SEGMENT_MERGE)
+    flush_merge();
+    merge_valid = false;
+  #endif
+  #if ENABLED(PATH_BLENDING)
+    flush_blend();
+    blend_valid = false;
+  #endif
+
   const uint8_t axis_index = E_AXIS + tools.active_extruder;
 
   #if ENABLED(FWRETRACT)
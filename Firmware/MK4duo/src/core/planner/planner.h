@@ -31,6 +31,18 @@
 
 #pragma once
 
+/**
+ * FIXED_POINT_PLANNER:
+ *  Squared speeds are kept in (mm/s)^2 with SPEED_SQR_BITS fractional bits,
+ *  so the planner passes and the trapezoid are integer only.
+ */
+#if ENABLED(FIXED_POINT_PLANNER)
+  #define SPEED_SQR_BITS  8
+  typedef uint32_t speed_sqr_t;
+#else
+  typedef float speed_sqr_t;
+#endif
+
 /**
  * struct block_t
  *
@@ -39,7 +51,71 @@
  *
  * The "nominal" values are as-specified by gcode, and
  * may never actually be reached due to acceleration limits.
+ *
+ * COMPACT_BLOCK_BUFFER:
+ *  - Lean layout for machines with no laser and a single plain extruder
+ *  - Step counts and step rates are 16 bit, longer moves are queued
+ *    in equal parts by buffer_steps() and faster ones are slowed down
+ *  - The trapezoid fields share the space of the sync block position
+ *  - acceleration_steps_per_s2 is rebuilt from acceleration_rate
  */
+#if ENABLED(COMPACT_BLOCK_BUFFER)
+
+typedef struct __NAMEDCLASS__{
+
+  volatile uint8_t flag;                    // Block flags (See BlockFlagEnum enum above) - Modified by ISR and main thread!
+
+  uint8_t direction_bits;                   // The direction bit set for this block
+
+  uint16_t  step_event_count,               // The number of step events required to complete this block
+            nominal_rate,                   // The nominal step rate for this block in step_events/sec
+            final_rate;                     // The minimal rate at exit
+
+  // Fields used by the motion planner to manage acceleration
+  speed_sqr_t nominal_speed_sqr,            // The nominal speed for this block in (mm/sec)^2
+              entry_speed_sqr,              // Entry speed at previous-current junction in (mm/sec)^2
+              max_entry_speed_sqr;          // Maximum allowable junction entry speed in (mm/sec)^2
+
+  #if ENABLED(FIXED_POINT_PLANNER)
+    // Length and acceleration are only needed by fill_block(), which then
+    // replaces them with what the integer planner passes and trapezoid use
+    union {
+      float       millimeters;              // The total travel of this block in mm
+      speed_sqr_t accel_speed_sqr;          // Squared speed gained accelerating over the whole block
+    };
+    union {
+      float       acceleration;             // acceleration mm/sec^2
+      uint32_t    rate_sqr_factor;          // (step rate / speed)^2, with SPEED_SQR_BITS fractional bits
+    };
+  #else
+    float millimeters,                      // The total travel of this block in mm
+          acceleration;                     // acceleration mm/sec^2
+  #endif
+
+  uint32_t acceleration_rate;               // The acceleration rate used for acceleration calculation
+
+  union {
+    // Data used by all move blocks
+    struct {
+      uint16_t  steps[NUM_AXIS],            // Step count along each axis
+                accelerate_until,           // The index of the step event on which to stop acceleration
+                decelerate_after,           // The index of the step event on which to start decelerating
+                initial_rate;               // The jerk-adjusted step rate at start of block
+    };
+    // Data used by all sync blocks
+    int32_t position[NUM_AXIS];             // New position to force when this sync block is executed
+  };
+
+  static constexpr uint8_t active_extruder = 0;
+
+  #if HAS_SPI_LCD
+    uint32_t segment_time_us;
+  #endif
+
+} block_t;
+
+#else // !COMPACT_BLOCK_BUFFER
+
 typedef struct __NAMEDCLASS__{
 
   volatile uint8_t flag;                    // Block flags (See BlockFlagEnum enum above) - Modified by ISR and main thread!
@@ -105,7 +181,9 @@ typedef struct __NAMEDCLASS__{
     uint8_t valve_pressure, e_to_p_pressure;
   #endif
 
-  uint32_t segment_time_us;
+  #if HAS_SPI_LCD
+    uint32_t segment_time_us;
+  #endif
 
   #if ENABLED(LASER)
     uint8_t   laser_mode;       // CONTINUOUS, PULSED, RASTER
@@ -122,8 +200,32 @@ typedef struct __NAMEDCLASS__{
 
 } block_t;
 
+#endif // !COMPACT_BLOCK_BUFFER
+
 #define BLOCK_MOD(n) ((n)&(BLOCK_BUFFER_SIZE-1))
 
+#if ENABLED(Z_MOTION_CHANNEL)
+
+  /**
+   * struct zblock_t
+   *
+   * A move of the Z motion channel. Speeds are in steps per
+   * Z_MOTION_STEP_RATE tick and the acceleration in steps per
+   * tick squared, both with 32 fractional bits.
+   */
+  typedef struct {
+    uint32_t  step_count,     // The number of steps of the move
+              initial_speed,  // Speed after the first step, and the lowest one
+              nominal_speed,  // Cruise speed
+              acceleration;   // Speed change per tick
+    int8_t    direction;      // +1 or -1 step
+    bool      ordered;        // Wait for a BLOCK_BIT_SYNC_Z block to start
+  } zblock_t;
+
+  #define ZBLOCK_MOD(n) ((n)&(Z_MOTION_BUFFER_SIZE-1))
+
+#endif
+
 class Planner {
 
   public: /** Constructor */
@@ -175,6 +277,10 @@ class Planner {
                     hysteresis_correction;
     #endif
 
+    #if ENABLED(PATH_BLENDING)
+      static float  blend_tolerance;  // G64 P, max distance of a blend from the corner. 0 for the exact path
+    #endif
+
   private: /** Private Parameters */
 
     /**
@@ -218,6 +324,52 @@ class Planner {
       volatile static uint32_t block_buffer_runtime_us; // Theoretical block buffer runtime in µs
     #endif
 
+    #if ENABLED(SEGMENT_MERGE)
+      /**
+       * Segment held back to be merged with the next collinear ones
+       */
+      static float    merge_start[XYZE],                      // Start of the held segment
+                      merge_end[XYZE],                        // End of the held segment, or of the last one queued
+                      merge_joint[SEGMENT_MERGE_MAX - 1][2],  // A/B of the joints merged away
+                      merge_fr_mm_s;
+      static uint8_t  merge_extruder,
+                      merge_count;                            // Segments held, 0 for none
+      static bool     merge_valid;                            // merge_end is where the next segment starts
+    #endif
+
+    #if ENABLED(PATH_BLENDING)
+      /**
+       * Segment held back to blend its end corner with the next one
+       */
+      static float    blend_start[XYZE],                      // Start of the held segment, past the last blend
+                      blend_end[XYZE],                        // End of the held segment, or of the last one queued
+                      blend_fr_mm_s;
+      static uint8_t  blend_extruder;
+      static bool     blend_held,                             // A segment is held
+                      blend_valid;                            // blend_end is where the next segment starts
+    #endif
+
+    #if ENABLED(CABLE_TENSION_LIMITS)
+      /**
+       * Cable tension gain at the end of the last block,
+       * reused as the start gain of the next one
+       */
+      static int32_t  cable_gain_steps[2];                    // A/B steps where cable_gain was computed
+      static float    cable_gain;
+    #endif
+
+    #if ENABLED(Z_MOTION_CHANNEL)
+      /**
+       * The Z motion channel buffer, a ring buffer as block_buffer.
+       * Writer of head is Planner::buffer_z_line().
+       * Reader of tail is Stepper::isr().
+       */
+      static zblock_t         zblock_buffer[Z_MOTION_BUFFER_SIZE];
+      static volatile uint8_t zblock_buffer_head,             // Index of the next Z move to be pushed
+                              zblock_buffer_tail;             // Index of the busy Z move, if any
+      static bool             z_pen_up;                       // The last Z move queued was up
+    #endif
+
   public: /** Public Function */
 
     static void reset_acceleration_rates();
@@ -469,6 +621,70 @@ class Planner {
      */
     static void quick_stop();
 
+    #if ENABLED(SEGMENT_MERGE)
+
+      /**
+       * Queue the segment held back for merging, if any
+       */
+      static void flush_merge();
+
+      /**
+       * Called from idle, queue the held segment before the planner runs dry
+       */
+      FORCE_INLINE static void check_merge() {
+        if (merge_count && movesplanned() < SEGMENT_MERGE_MIN_BLOCKS) flush_merge();
+      }
+
+    #endif
+
+    #if ENABLED(PATH_BLENDING)
+
+      /**
+       * Queue the segment held back for blending, if any, up to its end
+       */
+      static void flush_blend();
+
+      /**
+       * Called from idle, queue the held segment before the planner runs dry
+       */
+      FORCE_INLINE static void check_blend() {
+        if (blend_held && movesplanned() < PATH_BLENDING_MIN_BLOCKS) flush_blend();
+      }
+
+    #endif
+
+    #if ENABLED(Z_MOTION_CHANNEL)
+
+      /**
+       * Queue a move of Z alone, to rz in mm, on the Z motion channel.
+       * A move up with the pen already up starts at once, others wait
+       * for the blocks queued before and hold the blocks queued after.
+       */
+      static void buffer_z_line(const float &rz, const float &fr_mm_s);
+
+      /**
+       * Does the Z motion channel have any move queued?
+       */
+      FORCE_INLINE static bool has_zblocks_queued() { return zblock_buffer_head != zblock_buffer_tail; }
+
+      /**
+       * The current Z move. NULL if the Z buffer is empty.
+       * WARNING: Called from Stepper ISR context!
+       */
+      FORCE_INLINE static zblock_t* get_current_zblock() {
+        return has_zblocks_queued() ? &zblock_buffer[zblock_buffer_tail] : NULL;
+      }
+
+      /**
+       * Release the current Z move, called by the Stepper ISR when done
+       */
+      FORCE_INLINE static void discard_current_zblock() {
+        if (has_zblocks_queued())
+          zblock_buffer_tail = ZBLOCK_MOD(zblock_buffer_tail + 1);
+      }
+
+    #endif
+
     /**
      * Called when an endstop is triggered. Causes the machine to stop inmediately
      */
@@ -596,6 +812,39 @@ class Planner {
 
   private: /** Private Function */
 
+    #if ENABLED(SEGMENT_MERGE)
+      static bool merge_segment(const float (&target)[XYZE], const float &fr_mm_s, const uint8_t extruder, const bool mergeable);
+      static bool merge_fits(const float &a, const float &b);
+    #endif
+
+    #if ENABLED(PATH_BLENDING)
+      static bool blend_segment(const float (&target)[XYZE], const float &fr_mm_s, const uint8_t extruder, const bool blendable);
+      static void blend_corner(const float (&target)[XYZE], const float &fr_mm_s);
+    #endif
+
+    /**
+     * Queue a linear movement in axis units, past the segments held
+     * back for merging and blending. Same arguments as buffer_segment.
+     */
+    static bool queue_segment(const float &a, const float &b, const float &c, const float &e
+      #if IS_KINEMATIC && ENABLED(JUNCTION_DEVIATION)
+        , const float (&delta_mm_cart)[XYZE]
+      #endif
+      , const float &fr_mm_s, const uint8_t extruder, const float &millimeters=0.0
+    );
+
+    #if ENABLED(CABLE_TENSION_LIMITS)
+      static float cable_tension_gain(const int32_t a_steps, const int32_t b_steps);
+    #endif
+
+    #if ENABLED(Z_MOTION_CHANNEL)
+      /**
+       * Are there blocks queued that step Z or sync the position?
+       * A Z move queued now must wait for them.
+       */
+      static bool z_sync_needed();
+    #endif
+
     /**
      * Get the index of the next / previous block in the ring buffer
      */
@@ -633,6 +882,29 @@ class Planner {
       return target_velocity_sqr - 2 * accel * distance;
     }
 
+    /**
+     * Convert a squared speed in (mm/s)^2 to the block format.
+     * Fixed point values are saturated, so two of them can be added.
+     */
+    static constexpr speed_sqr_t to_speed_sqr(const float v_sqr) {
+      #if ENABLED(FIXED_POINT_PLANNER)
+        return v_sqr < float(0x7FFFFFFFUL >> (SPEED_SQR_BITS)) ? speed_sqr_t(v_sqr * float(1UL << (SPEED_SQR_BITS)) + 0.5f) : 0x7FFFFFFFUL;
+      #else
+        return v_sqr;
+      #endif
+    }
+
+    /**
+     * Squared speed reached accelerating over the whole block from 'speed_sqr'
+     */
+    static FORCE_INLINE speed_sqr_t accelerated_speed_sqr(const block_t * const block, const speed_sqr_t speed_sqr) {
+      #if ENABLED(FIXED_POINT_PLANNER)
+        return speed_sqr + block->accel_speed_sqr;
+      #else
+        return max_allowable_speed_sqr(-block->acceleration, speed_sqr, block->millimeters);
+      #endif
+    }
+
     #if ENABLED(BEZIER_JERK_CONTROL)
       /**
        * Calculate the speed reached given initial speed, acceleration and distance
@@ -642,7 +914,11 @@ class Planner {
       }
     #endif
 
-    static void calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor);
+    #if ENABLED(FIXED_POINT_PLANNER)
+      static void calculate_trapezoid_for_block(block_t* const block, const speed_sqr_t entry_speed_sqr, const speed_sqr_t exit_speed_sqr);
+    #else
+      static void calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor);
+    #endif
 
     static void reverse_pass_kernel(block_t* const current, const block_t* const next);
     static void forward_pass_kernel(const block_t* const previous, block_t* const current, const uint8_t block_index);
@@ -582,6 +582,13 @@ void Printer::idle(const bool ignore_stepper_queue/*=false*/) {
 
   commands.get_available();
 
+  #if ENABLED(SEGMENT_MERGE)
+    planner.check_merge();
+  #endif
+  #if ENABLED(PATH_BLENDING)
+    planner.check_blend();
+  #endif
+
   handle_safety_watch();
 
   if (max_inactivity_watch.stopwatch && max_inactivity_watch.elapsed()) {
@@ -845,6 +852,7 @@ void Printer::idle(const bool ignore_stepper_queue/*=false*/) {
   #endif
 
   SIIMU.update();
+  SIDrift.update();
 
   // Reset the watchdog
   watchdog.reset();
@@ -1052,19 +1060,16 @@ void Printer::checkVerticalityOnErasing()
   if(heaters[TARGET_HOTEND].isHeating() && SIIMU.getStatus() == IMU_SUCCESS)
   {
     Serial.println("Unit is heating.");
-    Serial.flush();
 
     if(SIIMU.checkVerticality())
     {
       Serial.println("Vertical check ok!");
-      Serial.flush();
     }
     else
     {
       heaters[TARGET_HOTEND].SwitchOff();
       quickstop_stepper();
       Serial.println("Heater has been switched off.");
-      Serial.flush();
       SERIAL_STR(OK);
       SERIAL_CHR(' ');
       SERIAL_MSG("C:Not vertical, stop erasing.");
@@ -92,6 +92,12 @@ uint8_t   Stepper::minimum_pulse    = 0;
 uint32_t  Stepper::maximum_rate     = 0,
           Stepper::direction_delay  = 0;
 
+#if ENABLED(INPUT_SHAPING)
+  ShaperTypeEnum  Stepper::shaping_type       = SHAPER_NONE;
+  float           Stepper::shaping_frequency  = 0.0,
+                  Stepper::shaping_damping    = 0.0;
+#endif
+
 /** Private Parameters */
 block_t* Stepper::current_block = NULL;  // A pointer to the block currently being traced
 
@@ -150,7 +156,31 @@ uint32_t  Stepper::advance_dividend[XYZE] = { 0 },
 uint32_t Stepper::nextMainISR = 0;
 
 #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+
   static uint8_t oversampling_factor = 0;
+
+  uint32_t          Stepper::smoothing_frequency  = ADAPTIVE_STEP_SMOOTHING_FREQ;
+  volatile uint32_t Stepper::isr_count            = 0,
+                    Stepper::isr_cycles_max       = 0,
+                    Stepper::isr_stats_ms         = 0;
+  volatile uint64_t Stepper::isr_cycles           = 0;
+  volatile uint8_t  Stepper::oversampling_max     = 0;
+
+  // The oversampling factor is at most 2^7, so the Bresenham counters can't overflow
+  constexpr uint8_t MAX_OVERSAMPLING = 7;
+
+  #if ENABLED(ARDUINO_ARCH_SAMD)
+    // SysTick is a down counter of CPU cycles with a 1ms period, far longer than an ISR
+    FORCE_INLINE static uint32_t isr_cycle_count() { return SysTick->VAL; }
+    FORCE_INLINE static uint32_t isr_cycles_since(const uint32_t start) {
+      const uint32_t now = SysTick->VAL;
+      return start >= now ? start - now : start + SysTick->LOAD + 1 - now;
+    }
+  #else
+    FORCE_INLINE static uint32_t isr_cycle_count() { return micros(); }
+    FORCE_INLINE static uint32_t isr_cycles_since(const uint32_t start) { return (micros() - start) * (F_CPU / 1000000UL); }
+  #endif
+
 #else
   constexpr uint8_t oversampling_factor = 0;
 #endif
@@ -171,6 +201,44 @@ uint32_t Stepper::nextMainISR = 0;
 
 #endif // LIN_ADVANCE
 
+#if ENABLED(INPUT_SHAPING)
+
+  constexpr uint32_t  SHAPING_NEVER         = 0xFFFFFFFF,
+                      SHAPING_ISR_TICKS     = (STEPPER_TIMER_RATE) / (INPUT_SHAPING_STEP_RATE);
+  constexpr uint8_t   SHAPING_SAMPLE_TICKS  = 1 << SHAPING_SAMPLE_SHIFT;
+
+  uint32_t  Stepper::nextShapingISR                       = SHAPING_NEVER;
+  int32_t   Stepper::shaping_input[2]                     = { 0 },
+            Stepper::shaping_output[2]                    = { 0 };
+  int16_t   Stepper::shaping_history[2][SHAPING_SIZE]     = { { 0 } };
+  uint16_t  Stepper::shaping_head                         = 0,
+            Stepper::shaping_still                        = SHAPING_SIZE,
+            Stepper::shaping_delay[3]                     = { 0 };
+  int16_t   Stepper::shaping_amp[3]                       = { 0 };
+  uint8_t   Stepper::shaping_impulses                     = 0,
+            Stepper::shaping_tick                         = 0;
+  int8_t    Stepper::shaping_dir[2]                       = { 1, 1 };
+  volatile bool Stepper::shaping_idle                     = true;
+  bool      Stepper::shaping_hold                         = false;
+
+#endif // INPUT_SHAPING
+
+#if ENABLED(Z_MOTION_CHANNEL)
+
+  constexpr uint32_t  Z_MOTION_ISR_TICKS    = (STEPPER_TIMER_RATE) / (Z_MOTION_STEP_RATE),
+                      Z_MOTION_IDLE_TICKS   = (STEPPER_TIMER_RATE) / 1000;
+
+  uint32_t  Stepper::nextZMotionISR         = 0;
+  zblock_t* Stepper::current_zblock         = NULL;
+  uint32_t  Stepper::z_phase                = 0,
+            Stepper::z_speed                = 0,
+            Stepper::z_steps_left           = 0,
+            Stepper::z_accel_steps          = 0;
+  volatile ZSyncEnum Stepper::z_sync        = Z_SYNC_NONE;
+  bool      Stepper::z_hold                 = false;
+
+#endif // Z_MOTION_CHANNEL
+
 int32_t Stepper::ticks_nominal = -1;
 #if DISABLED(BEZIER_JERK_CONTROL)
   uint32_t Stepper::acc_step_rate = 0; // needed for deceleration start point
@@ -457,6 +525,13 @@ void Stepper::factory_parameters() {
   direction_delay = DIRECTION_STEPPER_DELAY;
   minimum_pulse   = MINIMUM_STEPPER_PULSE;
   maximum_rate    = MAXIMUM_STEPPER_RATE;
+
+  #if ENABLED(INPUT_SHAPING)
+    shaping_type      = (ShaperTypeEnum)INPUT_SHAPING_TYPE;
+    shaping_frequency = INPUT_SHAPING_FREQ;
+    shaping_damping   = INPUT_SHAPING_DAMPING;
+    set_input_shaping();
+  #endif
 }
 
 /**
@@ -464,6 +539,10 @@ void Stepper::factory_parameters() {
  */
 void Stepper::Step() {
 
+  #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+    const uint32_t isr_start = isr_cycle_count();
+  #endif
+
   #if DISABLED(__AVR__)
     // Disable interrupts, to avoid ISR preemption while we reprogram the period
     // (AVR enters the ISR with global interrupts disabled, so no need to do it here)
@@ -500,12 +579,30 @@ void Stepper::Step() {
     // Run main stepping block phase ISR
     if (!nextMainISR) nextMainISR = block_phase_step();
 
+    #if ENABLED(INPUT_SHAPING)
+      // Run input shaping X/Y stepper ISR
+      if (!nextShapingISR) nextShapingISR = shaping_step();
+    #endif
+
+    #if ENABLED(Z_MOTION_CHANNEL)
+      // Run the Z motion channel ISR
+      if (!nextZMotionISR) nextZMotionISR = z_motion_step();
+    #endif
+
     #if ENABLED(LIN_ADVANCE)
       uint32_t interval = MIN(nextAdvanceISR, nextMainISR); // Nearest time interval
     #else
       uint32_t interval = nextMainISR;                      // Remaining stepper ISR time
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      NOMORE(interval, nextShapingISR);
+    #endif
+
+    #if ENABLED(Z_MOTION_CHANNEL)
+      NOMORE(interval, nextZMotionISR);
+    #endif
+
     // Limit the value to the maximum possible value of the timer
     NOMORE(interval, HAL_TIMER_TYPE_MAX);
 
@@ -517,6 +614,16 @@ void Stepper::Step() {
       if (nextAdvanceISR != LA_ADV_NEVER) nextAdvanceISR -= interval;
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      // Compute the time remaining for the shaping isr
+      if (nextShapingISR != SHAPING_NEVER) nextShapingISR -= interval;
+    #endif
+
+    #if ENABLED(Z_MOTION_CHANNEL)
+      // Compute the time remaining for the Z motion isr
+      nextZMotionISR -= interval;
+    #endif
+
     /**
      * This needs to avoid a race-condition caused by interleaving
      * of interrupts required by both the LA and Stepper algorithms.
@@ -575,11 +682,33 @@ void Stepper::Step() {
   // Schedule next interrupt
   HAL_timer_set_count(STEPPER_TIMER, hal_timer_t(next_isr_ticks));
 
+  #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+    // Cost of this ISR, with the serial interrupts served in the loop
+    const uint32_t cycles = isr_cycles_since(isr_start);
+    isr_count++;
+    isr_cycles += cycles;
+    if (cycles > isr_cycles_max) isr_cycles_max = cycles;
+  #endif
+
   // Don't forget to finally reenable interrupts
   ENABLE_ISRS();
 
 }
 
+#if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+
+  void Stepper::reset_isr_stats() {
+    const bool isr_enabled = STEPPER_ISR_ENABLED();
+    if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+    isr_count = isr_cycles_max = 0;
+    isr_cycles = 0;
+    oversampling_max = 0;
+    isr_stats_ms = millis();
+    if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+  }
+
+#endif
+
 /**
  * Check if the given block is busy or not - Must not be called from ISR contexts
  * The current_block could change in the middle of the read by an Stepper ISR, so
@@ -648,7 +777,7 @@ void Stepper::report_positions() {
   // Reenable Stepper ISR
   if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
 
-  #if CORE_IS_XY || CORE_IS_XZ || IS_SCARA
+  #if CORE_IS_XY || CORE_IS_XZ || IS_SCARA || MECH(POLARGRAPH)
     SERIAL_MSG(MSG_COUNT_A);
   #elif MECH(DELTA)
     SERIAL_MSG(MSG_COUNT_ALPHA);
@@ -657,7 +786,7 @@ void Stepper::report_positions() {
   #endif
   SERIAL_VAL(xpos);
 
-  #if CORE_IS_XY || CORE_IS_YZ || IS_SCARA
+  #if CORE_IS_XY || CORE_IS_YZ || IS_SCARA || MECH(POLARGRAPH)
     SERIAL_MSG(" B:");
   #elif MECH(DELTA)
     SERIAL_MSG(" Beta:");
@@ -688,35 +817,48 @@ void Stepper::report_positions() {
  */
 void Stepper::set_directions() {
 
+  #if ENABLED(INPUT_SHAPING)
+    // While shaping, X and Y directions are set by shaping_step
+    #define SHAPED_DIR(A,D) do{ if (!shaping_impulses) set_##A##_dir(D); }while(0)
+  #else
+    #define SHAPED_DIR(A,D) set_##A##_dir(D)
+  #endif
+
   #if HAS_X_DIR
     if (motor_direction(X_AXIS)) {
-      set_X_dir(isStepDir(X_AXIS));
+      SHAPED_DIR(X, isStepDir(X_AXIS));
       count_direction[X_AXIS] = -1;
     }
     else {
-      set_X_dir(!isStepDir(X_AXIS));
+      SHAPED_DIR(X, !isStepDir(X_AXIS));
       count_direction[X_AXIS] = 1;
     }
   #endif
 
   #if HAS_Y_DIR
     if (motor_direction(Y_AXIS)) {
-      set_Y_dir(isStepDir(Y_AXIS));
+      SHAPED_DIR(Y, isStepDir(Y_AXIS));
       count_direction[Y_AXIS] = -1;
     }
     else {
-      set_Y_dir(!isStepDir(Y_AXIS));
+      SHAPED_DIR(Y, !isStepDir(Y_AXIS));
       count_direction[Y_AXIS] = 1;
     }
   #endif
 
   #if HAS_Z_DIR
+    #if ENABLED(Z_MOTION_CHANNEL)
+      // While a Z move runs, the Z direction is set by z_motion_step
+      #define CHANNEL_Z_DIR(D) do{ if (!current_zblock) set_Z_dir(D); }while(0)
+    #else
+      #define CHANNEL_Z_DIR(D) set_Z_dir(D)
+    #endif
     if (motor_direction(Z_AXIS)) {
-      set_Z_dir(isStepDir(Z_AXIS));
+      CHANNEL_Z_DIR(isStepDir(Z_AXIS));
       count_direction[Z_AXIS] = -1;
     }
     else {
-      set_Z_dir(!isStepDir(Z_AXIS));
+      CHANNEL_Z_DIR(!isStepDir(Z_AXIS));
       count_direction[Z_AXIS] = 1;
     }
   #endif
@@ -1244,11 +1386,25 @@ void Stepper::pulse_phase_step() {
       current_block = NULL;
       planner.discard_current_block();
     }
+    #if ENABLED(INPUT_SHAPING)
+      shaping_abort();
+    #endif
+    #if ENABLED(Z_MOTION_CHANNEL)
+      // Planner::quick_stop dropped the Z moves too
+      if (!planner.has_blocks_queued() && !planner.has_zblocks_queued()) z_motion_abort();
+    #endif
   }
 
   // If there is no current block, do nothing
   if (!current_block) return;
 
+  #if ENABLED(INPUT_SHAPING)
+    if (shaping_hold) return;
+  #endif
+  #if ENABLED(Z_MOTION_CHANNEL)
+    if (z_hold) return;
+  #endif
+
   // Compute the count of pending loops
   const uint32_t pending_events = step_event_count - step_events_completed;
   uint8_t events_to_do = MIN(pending_events, steps_per_isr);
@@ -1332,6 +1488,22 @@ uint32_t Stepper::block_phase_step() {
   // If no queued movements, just wait 1ms for the next move
   uint32_t interval = (STEPPER_TIMER_RATE / 1000);
 
+  #if ENABLED(INPUT_SHAPING)
+    // A Z (pen) move waits for the shaped X/Y motion to settle
+    if (shaping_hold) {
+      if (!shaping_idle) return interval;
+      shaping_hold = false;
+    }
+  #endif
+
+  #if ENABLED(Z_MOTION_CHANNEL)
+    // A block with Z steps waits for the Z motion channel
+    if (z_hold) {
+      if (z_motion_active()) return interval;
+      z_hold = false;
+    }
+  #endif
+
   // If there is a current block
   if (current_block) {
 
@@ -1452,6 +1624,36 @@ uint32_t Stepper::block_phase_step() {
 
       // Sync block? Sync the stepper counts and return
       while (TEST(current_block->flag, BLOCK_BIT_SYNC_POSITION)) {
+
+        #if ENABLED(Z_MOTION_CHANNEL)
+          if (TEST(current_block->flag, BLOCK_BIT_SYNC_Z)) {
+            // Start the ordered Z move once X/Y stand still, then wait for it
+            if (z_sync != Z_SYNC_DONE
+              #if ENABLED(INPUT_SHAPING)
+                || !shaping_idle
+              #endif
+            ) {
+              if (z_sync == Z_SYNC_NONE
+                #if ENABLED(INPUT_SHAPING)
+                  && shaping_idle
+                #endif
+              ) z_sync = Z_SYNC_RELEASED;
+              current_block = NULL;
+              return interval;
+            }
+            z_sync = Z_SYNC_NONE;
+            planner.discard_current_block();
+            if (!(current_block = planner.get_current_block()))
+              return interval; // No more queued movements!
+            continue;
+          }
+          // Do not overwrite the Z count under a running Z move
+          if (z_motion_active()) {
+            current_block = NULL;
+            return interval;
+          }
+        #endif
+
         _set_position(
           current_block->position[A_AXIS], current_block->position[B_AXIS],
           current_block->position[C_AXIS], current_block->position[E_AXIS]
@@ -1538,14 +1740,14 @@ uint32_t Stepper::block_phase_step() {
       acceleration_time = deceleration_time = 0;
 
       #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+        // Raise the ISR rate of slow blocks up to smoothing_frequency, so the
+        // Bresenham steps of each axis fall closer to their ideal times.
+        // Fast blocks keep a factor of 0 and the CPU time they need.
         oversampling_factor = 0;
-        // At this point, we must decide if we can use Stepper movement axis smoothing.
-        uint32_t max_rate = current_block->nominal_rate;  // Get the maximum rate (maximum event speed)
-        while (max_rate < HAL_min_isr_frequency) {
-          max_rate <<= 1;
-          if (max_rate >= HAL_min_isr_frequency) break;
+        const uint32_t max_rate = MIN(smoothing_frequency, HAL_min_isr_frequency);
+        for (uint32_t rate = current_block->nominal_rate << 1; rate <= max_rate && oversampling_factor < MAX_OVERSAMPLING; rate <<= 1)
           ++oversampling_factor;
-        }
+        if (oversampling_factor > oversampling_max) oversampling_max = oversampling_factor;
       #endif
 
       // Based on the oversampling factor, do the calculations
@@ -1627,6 +1829,14 @@ uint32_t Stepper::block_phase_step() {
       // Mark the time_nominal as not calculated yet
       ticks_nominal = -1;
 
+      #if ENABLED(INPUT_SHAPING)
+        shaping_hold = shaping_impulses && current_block->steps[Z_AXIS] && !shaping_idle;
+      #endif
+
+      #if ENABLED(Z_MOTION_CHANNEL)
+        z_hold = current_block->steps[Z_AXIS] && z_motion_active();
+      #endif
+
       #if DISABLED(BEZIER_JERK_CONTROL)
         // Set as deceleration point the initial rate of the block
         acc_step_rate = current_block->initial_rate;
@@ -1683,10 +1893,17 @@ uint32_t Stepper::block_phase_step() {
 
 void Stepper::pulse_tick_start() {
 
+  #if ENABLED(INPUT_SHAPING)
+    // While shaping, X and Y steps are done by shaping_step
+    #define SHAPED_STEP(A) do{ if (shaping_impulses) shaping_input[A##_AXIS] += count_direction[A##_AXIS]; else start_##A##_step(); }while(0)
+  #else
+    #define SHAPED_STEP(A) start_##A##_step()
+  #endif
+
   #if HAS_X_STEP
     delta_error[X_AXIS] += advance_dividend[X_AXIS];
     if (delta_error[X_AXIS] >= 0) {
-      start_X_step();
+      SHAPED_STEP(X);
       count_position[X_AXIS] += count_direction[X_AXIS];
     }
   #endif
@@ -1694,7 +1911,7 @@ void Stepper::pulse_tick_start() {
   #if HAS_Y_STEP
     delta_error[Y_AXIS] += advance_dividend[Y_AXIS];
     if (delta_error[Y_AXIS] >= 0) {
-      start_Y_step();
+      SHAPED_STEP(Y);
       count_position[Y_AXIS] += count_direction[Y_AXIS];
     }
   #endif
@@ -2117,6 +2334,292 @@ void Stepper::_set_position(const int32_t &a, const int32_t &b, const int32_t &c
 
 #endif // ENABLED(LIN_ADVANCE)
 
+#if ENABLED(INPUT_SHAPING)
+
+  /**
+   * Input shaping
+   *
+   * The X/Y steps of the blocks only move shaping_input. Every
+   * shaping tick the motors step toward the sum of the input
+   * position delayed by each impulse, weighted by its amplitude:
+   *
+   *   output(t) = A0 * input(t) + A1 * input(t - T1) + A2 * input(t - T2)
+   *
+   * The delayed positions are interpolated from samples taken every
+   * SHAPING_SAMPLE_TICKS, kept as 16 bit differences from the input.
+   * The impulses cancel the swing at shaping_frequency, the motion
+   * is stretched by the last delay and corners are rounded by about
+   * the corner speed times that delay.
+   */
+  uint32_t Stepper::shaping_step() {
+
+    if (!shaping_impulses) return SHAPING_NEVER;
+
+    // Sample the input
+    if (++shaping_tick == SHAPING_SAMPLE_TICKS) {
+      shaping_tick = 0;
+      const uint16_t last = shaping_head;
+      if (++shaping_head == SHAPING_SIZE) shaping_head = 0;
+      bool moved = false;
+      LOOP_XY(i) {
+        shaping_history[i][shaping_head] = int16_t(shaping_input[i]);
+        if (shaping_history[i][shaping_head] != shaping_history[i][last]) moved = true;
+      }
+      if (moved) shaping_still = 0;
+      else if (shaping_still < SHAPING_SIZE) shaping_still++;
+    }
+
+    bool idle = shaping_still > shaping_delay[shaping_impulses - 1];
+    uint8_t step_bits = 0;
+
+    LOOP_XY(i) {
+
+      // Shaped position, as an offset from the input
+      const int16_t now = int16_t(shaping_input[i]);
+      int32_t offset = 0;
+      for (uint8_t j = 1; j < shaping_impulses; j++) {
+        const uint16_t  older = shaping_head >= shaping_delay[j] ? shaping_head - shaping_delay[j] : shaping_head + SHAPING_SIZE - shaping_delay[j],
+                        newer = older + 1 < SHAPING_SIZE ? older + 1 : 0;
+        const int32_t d0 = int16_t(shaping_history[i][older] - now),
+                      d1 = int16_t(shaping_history[i][newer] - now);
+        offset += (d0 + (((d1 - d0) * shaping_tick) >> SHAPING_SAMPLE_SHIFT)) * shaping_amp[j];
+      }
+      const int32_t target = shaping_input[i] + ((offset + 2048) >> 12);
+
+      if (target == shaping_output[i]) {
+        if (now != shaping_history[i][shaping_head]) idle = false;
+        continue;
+      }
+      idle = false;
+
+      // Step toward the target, a new direction is stepped on the next tick
+      const int8_t dir = target > shaping_output[i] ? 1 : -1;
+      if (dir == shaping_dir[i])
+        SBI(step_bits, i);
+      else {
+        shaping_dir[i] = dir;
+        if (i == X_AXIS)
+          set_X_dir(dir > 0 ? !isStepDir(X_AXIS) : isStepDir(X_AXIS));
+        else
+          set_Y_dir(dir > 0 ? !isStepDir(Y_AXIS) : isStepDir(Y_AXIS));
+      }
+    }
+
+    shaping_idle = idle;
+
+    if (step_bits) {
+
+      // Get the timer count and estimate the end of the pulse
+      hal_timer_t pulse_end = HAL_timer_get_current_count(STEPPER_TIMER) + HAL_min_pulse_tick;
+
+      if (TEST(step_bits, X_AXIS)) start_X_step();
+      if (TEST(step_bits, Y_AXIS)) start_Y_step();
+
+      if (minimum_pulse) {
+        // Just wait for the requested pulse time.
+        while (HAL_timer_get_current_count(STEPPER_TIMER) < pulse_end) { /* nada */ }
+      }
+
+      if (TEST(step_bits, X_AXIS)) {
+        stop_X_step();
+        shaping_output[X_AXIS] += shaping_dir[X_AXIS];
+      }
+      if (TEST(step_bits, Y_AXIS)) {
+        stop_Y_step();
+        shaping_output[Y_AXIS] += shaping_dir[Y_AXIS];
+      }
+    }
+
+    return SHAPING_ISR_TICKS;
+  }
+
+  /**
+   * Stop X/Y where the motors are, as on a quick stop.
+   * The positions are moved back to match the motors.
+   */
+  void Stepper::shaping_abort() {
+    LOOP_XY(i) {
+      count_position[i] += shaping_output[i] - shaping_input[i];
+      shaping_input[i] = shaping_output[i];
+      for (uint16_t h = 0; h < SHAPING_SIZE; h++) shaping_history[i][h] = int16_t(shaping_output[i]);
+    }
+    shaping_still = SHAPING_SIZE;
+    shaping_hold = false;
+    shaping_idle = true;
+  }
+
+  /**
+   * Set the impulses of shaping_type for shaping_frequency and shaping_damping.
+   *
+   *  ZV:  2 impulses over half a period, shortest
+   *  ZVD: 3 impulses over one period, tolerant of a wrong frequency
+   *  EI:  3 impulses over one period, 5% swing left, most tolerant
+   */
+  void Stepper::set_input_shaping() {
+
+    // The X/Y motors must be on their position before changing
+    planner.synchronize();
+
+    float amp[3] = { 1.0, 0.0, 0.0 };
+    uint8_t impulses = 0;
+    uint16_t delay[3] = { 0 };
+
+    if (shaping_type != SHAPER_NONE && shaping_frequency > 0) {
+
+      constexpr float vtol = 0.05,
+                      sample_rate = float(INPUT_SHAPING_STEP_RATE) / SHAPING_SAMPLE_TICKS;
+
+      const float df = SQRT(1.0 - sq(shaping_damping)),
+                  K = exp(-shaping_damping * M_PI / df),
+                  half_period = 0.5 / (shaping_frequency * df);
+
+      switch (shaping_type) {
+        case SHAPER_ZV:
+          impulses = 2;
+          amp[1] = K;
+          break;
+        case SHAPER_ZVD:
+          impulses = 3;
+          amp[1] = 2.0 * K;
+          amp[2] = sq(K);
+          break;
+        case SHAPER_EI:
+          impulses = 3;
+          amp[0] = 0.25 * (1.0 + vtol);
+          amp[1] = 0.5 * (1.0 - vtol) * K;
+          amp[2] = amp[0] * sq(K);
+          break;
+        default: break;
+      }
+
+      const float sum = amp[0] + amp[1] + amp[2];
+      for (uint8_t j = 1; j < impulses; j++) {
+        amp[j] /= sum;
+        delay[j] = constrain(LROUND(j * half_period * sample_rate), 1, SHAPING_SIZE - 2);
+      }
+    }
+
+    const bool isr_enabled = STEPPER_ISR_ENABLED();
+    if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+
+    const bool was_shaping = shaping_impulses;
+    for (uint8_t j = 0; j < 3; j++) {
+      shaping_amp[j] = LROUND(amp[j] * 4096.0);
+      shaping_delay[j] = delay[j];
+    }
+    shaping_impulses = impulses;
+
+    if (impulses && !was_shaping) {
+      // Take over the X/Y directions
+      LOOP_XY(i) shaping_dir[i] = 1;
+      set_X_dir(!isStepDir(X_AXIS));
+      set_Y_dir(!isStepDir(Y_AXIS));
+      nextShapingISR = 0;
+    }
+    else if (!impulses) {
+      nextShapingISR = SHAPING_NEVER;
+      if (was_shaping) set_directions();
+    }
+
+    if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+  }
+
+#endif // INPUT_SHAPING
+
+#if ENABLED(Z_MOTION_CHANNEL)
+
+  /**
+   * Z motion channel
+   *
+   * Runs the Z moves of Planner::buffer_z_line on its own time
+   * base, along with the blocks. Every tick the speed is added
+   * to a 32 bit phase and a step is done when it wraps. The speed
+   * goes up by the acceleration each tick up to the nominal speed,
+   * and down again when the steps left are as many as the steps
+   * done accelerating.
+   *
+   * An ordered move starts when its BLOCK_BIT_SYNC_Z block is
+   * reached, the others as soon as they are queued.
+   */
+  uint32_t Stepper::z_motion_step() {
+
+    if (!current_zblock) {
+
+      zblock_t * const zblock = planner.get_current_zblock();
+      if (!zblock || (zblock->ordered && z_sync != Z_SYNC_RELEASED)) return Z_MOTION_IDLE_TICKS;
+
+      // Start the move, stepping from the next tick
+      current_zblock = zblock;
+      z_steps_left = zblock->step_count;
+      z_accel_steps = 0;
+      z_phase = 0;
+      z_speed = zblock->initial_speed;
+      set_Z_dir(zblock->direction > 0 ? !isStepDir(Z_AXIS) : isStepDir(Z_AXIS));
+      return Z_MOTION_ISR_TICKS;
+    }
+
+    // Dropped by a quick stop
+    if (!planner.has_zblocks_queued()) {
+      z_motion_abort();
+      return Z_MOTION_IDLE_TICKS;
+    }
+
+    const uint32_t phase = z_phase + z_speed;
+    const bool accelerating = z_steps_left > z_accel_steps && z_speed < current_zblock->nominal_speed;
+
+    // The phase wrapped, step
+    if (phase < z_phase) {
+
+      // Get the timer count and estimate the end of the pulse
+      hal_timer_t pulse_end = HAL_timer_get_current_count(STEPPER_TIMER) + HAL_min_pulse_tick;
+
+      start_Z_step();
+
+      if (minimum_pulse) {
+        // Just wait for the requested pulse time.
+        while (HAL_timer_get_current_count(STEPPER_TIMER) < pulse_end) { /* nada */ }
+      }
+
+      stop_Z_step();
+      count_position[Z_AXIS] += current_zblock->direction;
+
+      if (!--z_steps_left) {
+        // Done, give the Z direction back to the blocks
+        set_Z_dir(motor_direction(Z_AXIS) ? isStepDir(Z_AXIS) : !isStepDir(Z_AXIS));
+        if (current_zblock->ordered) z_sync = Z_SYNC_DONE;
+        current_zblock = NULL;
+        planner.discard_current_zblock();
+        return Z_MOTION_ISR_TICKS;
+      }
+
+      if (accelerating) z_accel_steps++;
+    }
+    z_phase = phase;
+
+    // Speed for the next tick
+    if (z_steps_left <= z_accel_steps)
+      z_speed = z_speed > current_zblock->initial_speed + current_zblock->acceleration ? z_speed - current_zblock->acceleration : current_zblock->initial_speed;
+    else if (accelerating)
+      z_speed = MIN(z_speed + current_zblock->acceleration, current_zblock->nominal_speed);
+
+    return Z_MOTION_ISR_TICKS;
+  }
+
+  /**
+   * Forget the Z move once Planner::quick_stop dropped it.
+   * The Z count already follows the motor.
+   */
+  void Stepper::z_motion_abort() {
+    if (current_zblock) {
+      set_Z_dir(motor_direction(Z_AXIS) ? isStepDir(Z_AXIS) : !isStepDir(Z_AXIS));
+      current_zblock = NULL;
+    }
+    z_hold = false;
+    z_sync = Z_SYNC_NONE;
+  }
+
+#endif // Z_MOTION_CHANNEL
+
 #if ENABLED(BEZIER_JERK_CONTROL)
 
   /**
@@ -44,6 +44,12 @@
 
 #include "stepper_indirection.h"
 
+#if ENABLED(INPUT_SHAPING)
+  // X/Y input sampled every 2^SHAPING_SAMPLE_SHIFT shaping ticks, one swing period kept
+  #define SHAPING_SAMPLE_SHIFT  5
+  #define SHAPING_SIZE          (uint16_t((INPUT_SHAPING_STEP_RATE) * 1.05 / (INPUT_SHAPING_MIN_FREQ) / (1 << SHAPING_SAMPLE_SHIFT)) + 2)
+#endif
+
 class Stepper {
 
   public: /** Constructor */
@@ -62,6 +68,22 @@ class Stepper {
     static uint32_t maximum_rate,
                     direction_delay;
 
+    #if ENABLED(INPUT_SHAPING)
+      static ShaperTypeEnum shaping_type;
+      static float          shaping_frequency,  // (Hz) Swing frequency
+                            shaping_damping;    // Damping ratio
+    #endif
+
+    #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+      static uint32_t smoothing_frequency;      // (Hz) Oversample slower blocks up to this ISR rate, 0 for off
+      // Step ISR cost since reset_isr_stats()
+      static volatile uint32_t isr_count,
+                               isr_cycles_max,
+                               isr_stats_ms;    // millis() at the reset
+      static volatile uint64_t isr_cycles;
+      static volatile uint8_t  oversampling_max;
+    #endif
+
   private: /** Private Parameters */
 
     static block_t* current_block;          // A pointer to the block currently being traced
@@ -130,6 +152,33 @@ class Stepper {
       static bool     LA_use_advance_lead;
     #endif // !LIN_ADVANCE
 
+    #if ENABLED(INPUT_SHAPING)
+      static uint32_t nextShapingISR;
+      static int32_t  shaping_input[2],       // X/Y steps from the blocks
+                      shaping_output[2];      // X/Y steps done by the motors
+      static int16_t  shaping_history[2][SHAPING_SIZE];
+      static uint16_t shaping_head,           // Latest sample in shaping_history
+                      shaping_still,          // Samples since the input last moved
+                      shaping_delay[3];       // Impulse delays, in samples
+      static int16_t  shaping_amp[3];         // Impulse amplitudes, 1/4096
+      static uint8_t  shaping_impulses,       // 0 when shaping is off
+                      shaping_tick;           // Ticks since the latest sample
+      static int8_t   shaping_dir[2];         // Motor directions
+      static volatile bool shaping_idle;      // Output settled on the input
+      static bool     shaping_hold;           // Z block waiting for X/Y to settle
+    #endif
+
+    #if ENABLED(Z_MOTION_CHANNEL)
+      static uint32_t nextZMotionISR;
+      static zblock_t* current_zblock;        // The Z move being run
+      static uint32_t z_phase,                // Step phase, a step when it wraps
+                      z_speed,                // Steps per tick, 32 fractional bits
+                      z_steps_left,
+                      z_accel_steps;          // Steps done accelerating
+      static volatile ZSyncEnum z_sync;       // State of the BLOCK_BIT_SYNC_Z block
+      static bool     z_hold;                 // Z block waiting for the Z channel
+    #endif
+
     static int32_t ticks_nominal;
     #if DISABLED(BEZIER_JERK_CONTROL)
       static uint32_t acc_step_rate; // needed for deceleration start point
@@ -198,6 +247,25 @@ class Stepper {
      */
     static void set_directions();
 
+    #if ENABLED(INPUT_SHAPING)
+      /**
+       * Compute the impulses from type, frequency and damping
+       */
+      static void set_input_shaping();
+
+      /**
+       * X/Y still moving after the blocks are done
+       */
+      FORCE_INLINE static bool shaping_busy() { return !shaping_idle; }
+    #endif
+
+    #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+      /**
+       * Restart the Step ISR cost counters
+       */
+      static void reset_isr_stats();
+    #endif
+
     /**
      * The stepper subsystem goes to sleep when it runs out of things to execute. Call this
      * to notify the subsystem that it is time to go to work.
@@ -434,6 +502,23 @@ class Stepper {
       static uint32_t lin_advance_step();
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      // The Input shaping X/Y Step
+      static uint32_t shaping_step();
+      static void shaping_abort();
+    #endif
+
+    #if ENABLED(Z_MOTION_CHANNEL)
+      // The Z motion channel Step
+      static uint32_t z_motion_step();
+      static void z_motion_abort();
+      // A Z move is running or about to start
+      FORCE_INLINE static bool z_motion_active() {
+        const zblock_t * const zblock = planner.get_current_zblock();
+        return current_zblock || (zblock && (!zblock->ordered || z_sync == Z_SYNC_RELEASED));
+      }
+    #endif
+
     #if ENABLED(BEZIER_JERK_CONTROL)
       static void _calc_bezier_curve_coeffs(const int32_t v0, const int32_t v1, const uint32_t av);
       static int32_t _eval_bezier_curve(const uint32_t curr_step);
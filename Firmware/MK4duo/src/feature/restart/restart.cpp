@@ -118,11 +118,17 @@
       // Commands in the queue
       job_info.buffer_head = commands.buffer_ring.head();
       job_info.buffer_count = save_count ? commands.buffer_ring.count() : 0;
-      for (uint8_t index = 0; index < BUFSIZE; index++) {
-        gcode_t temp_cmd;
-        temp_cmd = commands.buffer_ring.peek(index);
-        strncpy(job_info.buffer_ring[index], temp_cmd.gcode, sizeof(job_info.buffer_ring[index]) - 1);
-      }
+      #if ENABLED(COMPACT_COMMAND_QUEUE)
+        // Only queued slots hold a command to rebuild
+        for (uint8_t h = job_info.buffer_head, c = job_info.buffer_count; c--; h = (h + 1) % BUFSIZE)
+          commands.buffer_ring.get_text(commands.buffer_ring.peek(h), job_info.buffer_ring[h]);
+      #else
+        for (uint8_t index = 0; index < BUFSIZE; index++) {
+          gcode_t temp_cmd;
+          temp_cmd = commands.buffer_ring.peek(index);
+          strncpy(job_info.buffer_ring[index], temp_cmd.gcode, sizeof(job_info.buffer_ring[index]) - 1);
+        }
+      #endif
 
       // Elapsed print job time
       job_info.print_job_counter_elapsed = print_job_counter.duration() * 1000UL;
@@ -130,7 +130,7 @@
 #endif // !MECH(DELTA)
 
 // Require 0,0 bed center for Delta and SCARA
-#if IS_KINEMATIC
+#if MECH(DELTA) || IS_SCARA
   #define BED_CENTER_AT_0_0
 #endif
 
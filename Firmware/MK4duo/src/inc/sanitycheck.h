@@ -155,6 +155,97 @@
 #if DISABLED(BUFSIZE)
   #error "DEPENDENCY ERROR: Missing setting BUFSIZE."
 #endif
+#if ENABLED(COMPACT_COMMAND_QUEUE)
+  #if BUFSIZE > 255
+    #error "DEPENDENCY ERROR: BUFSIZE must be 255 or less with COMPACT_COMMAND_QUEUE."
+  #endif
+  #if ENABLED(COMMAND_VALUES) && (COMMAND_VALUES < 1 || COMMAND_VALUES > 6)
+    #error "DEPENDENCY ERROR: COMMAND_VALUES must be between 1 and 6."
+  #endif
+  #if ENABLED(COMMAND_TEXT_SIZE) && COMMAND_TEXT_SIZE < MAX_CMD_SIZE
+    #error "DEPENDENCY ERROR: COMMAND_TEXT_SIZE must be MAX_CMD_SIZE or more."
+  #endif
+#endif
+#if ENABLED(FASTER_GCODE_PARSER)
+  #if ENABLED(FASTER_GCODE_PARAMS) && (FASTER_GCODE_PARAMS < 1 || FASTER_GCODE_PARAMS > 26)
+    #error "DEPENDENCY ERROR: FASTER_GCODE_PARAMS must be between 1 and 26."
+  #endif
+  #if MAX_CMD_SIZE > 256
+    #error "DEPENDENCY ERROR: MAX_CMD_SIZE must be 256 or less with FASTER_GCODE_PARSER."
+  #endif
+#endif
+#if ENABLED(COMPACT_BLOCK_BUFFER)
+  #if EXTRUDERS > 1 || ENABLED(COLOR_MIXING_EXTRUDER)
+    #error "DEPENDENCY ERROR: COMPACT_BLOCK_BUFFER requires a single extruder."
+  #elif ENABLED(LASER) || ENABLED(LIN_ADVANCE) || ENABLED(BEZIER_JERK_CONTROL) || ENABLED(BARICUDA) || ENABLED(HYSTERESIS_FEATURE)
+    #error "DEPENDENCY ERROR: COMPACT_BLOCK_BUFFER is not compatible with LASER, LIN_ADVANCE, BEZIER_JERK_CONTROL, BARICUDA or HYSTERESIS_FEATURE."
+  #endif
+#endif
+#if ENABLED(FIXED_POINT_PLANNER)
+  #if DISABLED(COMPACT_BLOCK_BUFFER)
+    #error "DEPENDENCY ERROR: FIXED_POINT_PLANNER requires COMPACT_BLOCK_BUFFER."
+  #elif ENABLED(AUTOTEMP)
+    #error "DEPENDENCY ERROR: FIXED_POINT_PLANNER is not compatible with AUTOTEMP."
+  #endif
+#endif
+#if ENABLED(SEGMENT_MERGE)
+  #if IS_KINEMATIC && ENABLED(JUNCTION_DEVIATION)
+    #error "DEPENDENCY ERROR: SEGMENT_MERGE is not compatible with JUNCTION_DEVIATION on kinematic machines."
+  #elif DISABLED(SEGMENT_MERGE_TOLERANCE) || DISABLED(SEGMENT_MERGE_MAX) || DISABLED(SEGMENT_MERGE_MIN_BLOCKS)
+    #error "DEPENDENCY ERROR: Missing setting SEGMENT_MERGE_TOLERANCE, SEGMENT_MERGE_MAX or SEGMENT_MERGE_MIN_BLOCKS."
+  #elif SEGMENT_MERGE_MAX < 2 || SEGMENT_MERGE_MAX > 255
+    #error "DEPENDENCY ERROR: SEGMENT_MERGE_MAX must be between 2 and 255."
+  #elif SEGMENT_MERGE_MIN_BLOCKS < 1 || SEGMENT_MERGE_MIN_BLOCKS >= BLOCK_BUFFER_SIZE
+    #error "DEPENDENCY ERROR: SEGMENT_MERGE_MIN_BLOCKS must be between 1 and BLOCK_BUFFER_SIZE - 1."
+  #endif
+#endif
+#if ENABLED(PATH_BLENDING)
+  #if IS_KINEMATIC
+    #error "DEPENDENCY ERROR: PATH_BLENDING is not compatible with kinematic machines."
+  #elif DISABLED(PATH_BLENDING_TOLERANCE) || DISABLED(PATH_BLENDING_SEGMENTS) || DISABLED(PATH_BLENDING_MIN_BLOCKS)
+    #error "DEPENDENCY ERROR: Missing setting PATH_BLENDING_TOLERANCE, PATH_BLENDING_SEGMENTS or PATH_BLENDING_MIN_BLOCKS."
+  #elif PATH_BLENDING_SEGMENTS < 1 || PATH_BLENDING_SEGMENTS > 16
+    #error "DEPENDENCY ERROR: PATH_BLENDING_SEGMENTS must be between 1 and 16."
+  #elif PATH_BLENDING_MIN_BLOCKS < 1 || PATH_BLENDING_MIN_BLOCKS >= BLOCK_BUFFER_SIZE
+    #error "DEPENDENCY ERROR: PATH_BLENDING_MIN_BLOCKS must be between 1 and BLOCK_BUFFER_SIZE - 1."
+  #endif
+#endif
+#if ENABLED(CABLE_TENSION_LIMITS)
+  #if !MECH(CARTESIAN) && !MECH(POLARGRAPH)
+    #error "DEPENDENCY ERROR: CABLE_TENSION_LIMITS requires MECH_CARTESIAN (cord lengths as X/Y) or MECH_POLARGRAPH."
+  #elif DISABLED(POLARGRAPH_NAIL_DISTANCE)
+    #error "DEPENDENCY ERROR: CABLE_TENSION_LIMITS requires POLARGRAPH_NAIL_DISTANCE."
+  #elif DISABLED(CABLE_TENSION_LOW) || DISABLED(CABLE_TENSION_HIGH) || DISABLED(CABLE_ACCELERATION_GAIN) || DISABLED(CABLE_FEEDRATE_GAIN)
+    #error "DEPENDENCY ERROR: Missing setting CABLE_TENSION_LOW, CABLE_TENSION_HIGH, CABLE_ACCELERATION_GAIN or CABLE_FEEDRATE_GAIN."
+  #endif
+#endif
+#if ENABLED(INPUT_SHAPING)
+  #if DISABLED(INPUT_SHAPING_TYPE) || DISABLED(INPUT_SHAPING_FREQ) || DISABLED(INPUT_SHAPING_DAMPING) || DISABLED(INPUT_SHAPING_MIN_FREQ) || DISABLED(INPUT_SHAPING_STEP_RATE)
+    #error "DEPENDENCY ERROR: Missing setting INPUT_SHAPING_TYPE, INPUT_SHAPING_FREQ, INPUT_SHAPING_DAMPING, INPUT_SHAPING_MIN_FREQ or INPUT_SHAPING_STEP_RATE."
+  #elif INPUT_SHAPING_TYPE > 3
+    #error "DEPENDENCY ERROR: INPUT_SHAPING_TYPE must be between 0 and 3."
+  #elif INPUT_SHAPING_STEP_RATE < 1000 || INPUT_SHAPING_STEP_RATE > 20000
+    #error "DEPENDENCY ERROR: INPUT_SHAPING_STEP_RATE must be between 1000 and 20000."
+  #elif ENABLED(BABYSTEPPING)
+    #error "DEPENDENCY ERROR: INPUT_SHAPING is not compatible with BABYSTEPPING."
+  #endif
+#endif
+#if ENABLED(ADAPTIVE_STEP_SMOOTHING) && DISABLED(ADAPTIVE_STEP_SMOOTHING_FREQ)
+  #error "DEPENDENCY ERROR: Missing setting ADAPTIVE_STEP_SMOOTHING_FREQ."
+#endif
+#if ENABLED(Z_MOTION_CHANNEL)
+  #if !MECH(CARTESIAN) && !MECH(POLARGRAPH)
+    #error "DEPENDENCY ERROR: Z_MOTION_CHANNEL requires MECH_CARTESIAN or MECH_POLARGRAPH."
+  #elif HAS_LEVELING || ENABLED(FWRETRACT) || ENABLED(BABYSTEPPING)
+    #error "DEPENDENCY ERROR: Z_MOTION_CHANNEL is not compatible with bed leveling, FWRETRACT or BABYSTEPPING."
+  #elif DISABLED(Z_MOTION_BUFFER_SIZE) || DISABLED(Z_MOTION_STEP_RATE)
+    #error "DEPENDENCY ERROR: Missing setting Z_MOTION_BUFFER_SIZE or Z_MOTION_STEP_RATE."
+  #elif Z_MOTION_BUFFER_SIZE < 2 || Z_MOTION_BUFFER_SIZE > 16 || (Z_MOTION_BUFFER_SIZE & (Z_MOTION_BUFFER_SIZE - 1))
+    #error "DEPENDENCY ERROR: Z_MOTION_BUFFER_SIZE must be a power of 2 between 2 and 16."
+  #elif Z_MOTION_STEP_RATE < 1000 || Z_MOTION_STEP_RATE > 20000
+    #error "DEPENDENCY ERROR: Z_MOTION_STEP_RATE must be between 1000 and 20000."
+  #endif
+#endif
 #if ENABLED(SERIAL_XON_XOFF) && RX_BUFFER_SIZE < 1024
   #error "DEPENDENCY ERROR: For SERIAL_XON_XOFF set RX_BUFFER_SIZE to 1024 or more."
 #endif
@@ -113,13 +113,27 @@ enum BlockFlagBitEnum : uint8_t {
   BLOCK_BIT_NOMINAL_LENGTH,
 
   // Sync the stepper counts from the block
-  BLOCK_BIT_SYNC_POSITION
+  BLOCK_BIT_SYNC_POSITION,
+
+  // With BLOCK_BIT_SYNC_POSITION, start the next ordered Z channel move
+  // and wait for it, instead of syncing the stepper counts
+  BLOCK_BIT_SYNC_Z
 };
 
 enum BlockFlagEnum : uint8_t {
   BLOCK_FLAG_RECALCULATE          = _BV(BLOCK_BIT_RECALCULATE),
   BLOCK_FLAG_NOMINAL_LENGTH       = _BV(BLOCK_BIT_NOMINAL_LENGTH),
-  BLOCK_FLAG_SYNC_POSITION        = _BV(BLOCK_BIT_SYNC_POSITION)
+  BLOCK_FLAG_SYNC_POSITION        = _BV(BLOCK_BIT_SYNC_POSITION),
+  BLOCK_FLAG_SYNC_Z               = _BV(BLOCK_BIT_SYNC_Z)
+};
+
+/**
+ * Z motion channel, ordered move started by a planner block
+ */
+enum ZSyncEnum : uint8_t {
+  Z_SYNC_NONE,      // No ordered move may start
+  Z_SYNC_RELEASED,  // The planner reached the move, it may start
+  Z_SYNC_DONE       // The move is done, the planner may go on
 };
 
 /**
@@ -141,6 +155,16 @@ enum WorkspacePlaneEnum : uint8_t {
   PLANE_YZ
 };
 
+/**
+ * Input shaper
+ */
+enum ShaperTypeEnum : uint8_t {
+  SHAPER_NONE,
+  SHAPER_ZV,
+  SHAPER_ZVD,
+  SHAPER_EI
+};
+
 /**
  * Endstop
  */
@@ -76,6 +76,7 @@
 #define MECH_DELTA           3
 #define MECH_MORGAN_SCARA    4
 #define MECH_MAKERARM_SCARA  5
+#define MECH_POLARGRAPH      6
 #define MECH_COREXZ          8
 #define MECH_COREZX          9
 #define MECH_COREYZ         10
@@ -86,7 +87,7 @@
 #define NOMECH(mech)  (MECHANISM != MECH_##mech)
 
 #define IS_SCARA      (MECH(MORGAN_SCARA) || MECH(MAKERARM_SCARA))
-#define IS_KINEMATIC  (MECH(DELTA)  || IS_SCARA)
+#define IS_KINEMATIC  (MECH(DELTA)  || IS_SCARA || MECH(POLARGRAPH))
 #define CORE_IS_XY    (MECH(COREXY) || MECH(COREYX))
 #define CORE_IS_XZ    (MECH(COREXZ) || MECH(COREZX))
 #define CORE_IS_YZ    (MECH(COREYZ) || MECH(COREZY))
@@ -341,6 +341,11 @@ void HAL::Tick() {
   static millis_t cycle_check_temp = 0;
 	millis_t now = millis();
 
+  #if ENABLED(SERIAL_ESP_RX_DMA)
+    // Publish the receive ring write index, also while stopped
+    serialDmaRx.publish();
+  #endif
+
   if (printer.isStopped()) return;
 
   #if HEATER_COUNT > 0
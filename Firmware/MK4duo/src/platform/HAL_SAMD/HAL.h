@@ -22,6 +22,7 @@ typedef uint32_t  ptr_int_t;
 #include "fastio.h"
 #include "watchdog.h"
 #include "HAL_timers.h"
+#include "HAL_serial_dma.h"
 #include "math.h"
 #include "delay.h"
 /*
@@ -115,6 +116,10 @@ char *dtostrf (double val, signed char width, unsigned char prec, char *sout) ;
   #define NUM_SERIAL 1
 #endif
 
+#if (ENABLED(SERIAL_ESP_RX_DMA) || ENABLED(SERIAL_ESP_TX_DMA)) && SERIAL_PORT_1 != 1
+  #error "SERIAL_ESP_RX_DMA and SERIAL_ESP_TX_DMA require SERIAL_PORT_1 1 (SerialEsp)"
+#endif
+
 // EEPROM START
 #define EEPROM_OFFSET 10
 
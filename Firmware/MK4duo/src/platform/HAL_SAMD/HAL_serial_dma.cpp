@@ -0,0 +1,335 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * DMA rings for the SERCOM used by SerialEsp
+ *
+ * ARDUINO_ARCH_SAMD
+ */
+
+#include "../../../MK4duo.h"
+
+#if ENABLED(ARDUINO_ARCH_SAMD) && (ENABLED(SERIAL_ESP_RX_DMA) || ENABLED(SERIAL_ESP_TX_DMA))
+
+// --------------------------------------------------------------------------
+// Private Variables
+// --------------------------------------------------------------------------
+
+// The DMAC fetches descriptors from a table indexed by channel
+__attribute__((__aligned__(16))) static DmacDescriptor dma_descriptor[SERIAL_DMA_TX_CHANNEL + 1],
+                                                       dma_writeback[SERIAL_DMA_TX_CHANNEL + 1];
+
+/** Protected Parameters */
+Sercom* SerialDma::sercom       = NULL;
+uint8_t SerialDma::sercom_index = 0;
+
+/** Protected Function */
+bool SerialDma::init(const uint32_t baudrate) {
+
+  static Sercom* const sercom_list[] = SERCOM_INSTS;
+
+  // Uart::begin() uses the internal clock with fractional baudrate, x16 or x8 sampling
+  const uint32_t  times8_x16  = (SystemCoreClock * 8) / (16 * baudrate),
+                  times8_x8   = (SystemCoreClock * 8) / (8 * baudrate);
+
+  sercom = NULL;
+  for (uint8_t index = 0; index < COUNT(sercom_list); index++) {
+    SercomUsart &usart = sercom_list[index]->USART;
+    if (!usart.CTRLA.bit.ENABLE || usart.CTRLA.bit.MODE != SERCOM_USART_CTRLA_MODE_USART_INT_CLK_Val || !usart.CTRLB.bit.RXEN)
+      continue;
+    const uint32_t times8 = usart.CTRLA.bit.SAMPR == 3 ? times8_x8 : times8_x16;
+    if (usart.BAUD.FRAC.BAUD == times8 / 8 && usart.BAUD.FRAC.FP == times8 % 8) {
+      sercom = sercom_list[index];
+      sercom_index = index;
+      break;
+    }
+  }
+  if (!sercom) return false;
+
+  // DMAC is shared by all channels, do not take it from someone else
+  if (DMAC->CTRL.bit.DMAENABLE) return DMAC->BASEADDR.reg == (uint32_t)dma_descriptor;
+
+  PM->AHBMASK.reg |= PM_AHBMASK_DMAC;
+  PM->APBBMASK.reg |= PM_APBBMASK_DMAC;
+
+  DMAC->CTRL.reg = DMAC_CTRL_SWRST;
+  while (DMAC->CTRL.bit.SWRST);
+
+  DMAC->BASEADDR.reg = (uint32_t)dma_descriptor;
+  DMAC->WRBADDR.reg  = (uint32_t)dma_writeback;
+  DMAC->CTRL.reg = DMAC_CTRL_DMAENABLE | DMAC_CTRL_LVLEN(0xF);
+
+  NVIC_SetPriority(DMAC_IRQn, NvicPriorityUart);
+  NVIC_EnableIRQ(DMAC_IRQn);
+
+  return true;
+}
+
+void SerialDma::release() {
+  #if ENABLED(SERIAL_ESP_RX_DMA)
+    if (SerialDmaRx::isActive()) return;
+  #endif
+  #if ENABLED(SERIAL_ESP_TX_DMA)
+    if (SerialDmaTx::isActive()) return;
+  #endif
+  NVIC_DisableIRQ(DMAC_IRQn);
+  DMAC->CTRL.reg = 0;
+}
+
+#if ENABLED(SERIAL_ESP_RX_DMA)
+
+  SerialDmaRx serialDmaRx;
+
+  static char rx_ring[SERIAL_ESP_RX_DMA_SIZE];
+
+  /** Private Parameters */
+  volatile uint32_t SerialDmaRx::head       = 0;
+  volatile uint16_t SerialDmaRx::last_index = 0;
+  uint32_t          SerialDmaRx::tail       = 0,
+                    SerialDmaRx::overruns   = 0;
+  bool              SerialDmaRx::active     = false;
+
+  /** Public Function */
+  bool SerialDmaRx::begin(const uint32_t baudrate) {
+
+    if (active) end();
+
+    if (!init(baudrate)) return false;
+
+    DmacDescriptor &desc = dma_descriptor[SERIAL_DMA_RX_CHANNEL];
+    desc.BTCTRL.reg   = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_DSTINC;
+    desc.BTCNT.reg    = SERIAL_ESP_RX_DMA_SIZE;
+    desc.SRCADDR.reg  = (uint32_t)&sercom->USART.DATA.reg;
+    desc.DSTADDR.reg  = (uint32_t)rx_ring + SERIAL_ESP_RX_DMA_SIZE;  // End address when incrementing
+    desc.DESCADDR.reg = (uint32_t)&desc;                             // Linked to itself: circular
+    dma_writeback[SERIAL_DMA_RX_CHANNEL].BTCNT.reg = 0;
+
+    head = tail = 0;
+    last_index = 0;
+
+    // The Uart interrupt must not read DATA anymore (see ExtraFile/SERCOM.cpp)
+    CRITICAL_SECTION_START
+      DMAC->CHID.reg = DMAC_CHID_ID(SERIAL_DMA_RX_CHANNEL);
+      DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+      while (DMAC->CHCTRLA.bit.SWRST);
+      DMAC->CHCTRLB.reg = DMAC_CHCTRLB_LVL(0) |
+                          DMAC_CHCTRLB_TRIGSRC(SERCOM0_DMAC_ID_RX + 2 * sercom_index) |
+                          DMAC_CHCTRLB_TRIGACT_BEAT;
+      sercom->USART.INTENCLR.reg = SERCOM_USART_INTENCLR_RXC;
+      DMAC->CHCTRLA.reg = DMAC_CHCTRLA_ENABLE;
+      active = true;
+    CRITICAL_SECTION_END
+
+    return true;
+  }
+
+  void SerialDmaRx::end() {
+    if (!active) return;
+
+    CRITICAL_SECTION_START
+      DMAC->CHID.reg = DMAC_CHID_ID(SERIAL_DMA_RX_CHANNEL);
+      DMAC->CHCTRLA.reg = 0;
+      sercom->USART.INTENSET.reg = SERCOM_USART_INTENSET_RXC;
+      active = false;
+    CRITICAL_SECTION_END
+
+    release();
+  }
+
+  void SerialDmaRx::publish() {
+    if (!active) return;
+
+    CRITICAL_SECTION_START
+      // The block counter is live in ACTIVE while the channel moves a beat, in the write-back descriptor otherwise
+      uint16_t remaining;
+      if (DMAC->ACTIVE.bit.ABUSY && DMAC->ACTIVE.bit.ID == SERIAL_DMA_RX_CHANNEL)
+        remaining = DMAC->ACTIVE.bit.BTCNT;
+      else
+        remaining = dma_writeback[SERIAL_DMA_RX_CHANNEL].BTCNT.reg;
+
+      const uint16_t index = (SERIAL_ESP_RX_DMA_SIZE - remaining) & (SERIAL_ESP_RX_DMA_SIZE - 1);
+      head += (uint16_t)(index - last_index) & (SERIAL_ESP_RX_DMA_SIZE - 1);
+      last_index = index;
+    CRITICAL_SECTION_END
+  }
+
+  uint16_t SerialDmaRx::available() {
+    publish();
+    check_overrun();
+    return head - tail;
+  }
+
+  int SerialDmaRx::read() {
+    if (!available()) return -1;
+    return (uint8_t)rx_ring[tail++ & (SERIAL_ESP_RX_DMA_SIZE - 1)];
+  }
+
+  uint16_t SerialDmaRx::span(const char* &data) {
+    const uint16_t count = available(),
+                   index = tail & (SERIAL_ESP_RX_DMA_SIZE - 1);
+    data = rx_ring + index;
+    return MIN(count, SERIAL_ESP_RX_DMA_SIZE - index);
+  }
+
+  void SerialDmaRx::consume(const uint16_t count) {
+    tail += count;
+  }
+
+  /** Private Function */
+
+  // If the DMAC lapped the reader the ring content is lost: skip it, line checksum
+  // and line number make the host resend the broken line.
+  void SerialDmaRx::check_overrun() {
+    if (head - tail > SERIAL_ESP_RX_DMA_SIZE) {
+      tail = head;
+      overruns++;
+    }
+  }
+
+#endif // ENABLED(SERIAL_ESP_RX_DMA)
+
+#if ENABLED(SERIAL_ESP_TX_DMA)
+
+  SerialDmaTx serialDmaTx;
+
+  static char tx_ring[SERIAL_ESP_TX_DMA_SIZE];
+
+  /** Private Parameters */
+  volatile uint32_t SerialDmaTx::head       = 0,
+                    SerialDmaTx::tail       = 0;
+  volatile uint16_t SerialDmaTx::sending    = 0;
+  uint32_t          SerialDmaTx::stalls     = 0;
+  uint16_t          SerialDmaTx::max_queued = 0;
+  bool              SerialDmaTx::active     = false;
+
+  /** Public Function */
+  bool SerialDmaTx::begin(const uint32_t baudrate) {
+
+    if (active) end();
+
+    if (!init(baudrate)) return false;
+
+    // Bytes already in the Uart buffer go out first
+    MKSERIAL1.flush();
+
+    head = tail = 0;
+    sending = 0;
+
+    CRITICAL_SECTION_START
+      DMAC->CHID.reg = DMAC_CHID_ID(SERIAL_DMA_TX_CHANNEL);
+      DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+      while (DMAC->CHCTRLA.bit.SWRST);
+      DMAC->CHCTRLB.reg = DMAC_CHCTRLB_LVL(0) |
+                          DMAC_CHCTRLB_TRIGSRC(SERCOM0_DMAC_ID_TX + 2 * sercom_index) |
+                          DMAC_CHCTRLB_TRIGACT_BEAT;
+      DMAC->CHINTENSET.reg = DMAC_CHINTENSET_TCMPL | DMAC_CHINTENSET_TERR;
+      active = true;
+    CRITICAL_SECTION_END
+
+    return true;
+  }
+
+  void SerialDmaTx::end() {
+    if (!active) return;
+
+    flush();
+
+    CRITICAL_SECTION_START
+      DMAC->CHID.reg = DMAC_CHID_ID(SERIAL_DMA_TX_CHANNEL);
+      DMAC->CHINTENCLR.reg = DMAC_CHINTENCLR_TCMPL | DMAC_CHINTENCLR_TERR;
+      DMAC->CHCTRLA.reg = 0;
+      active = false;
+    CRITICAL_SECTION_END
+
+    release();
+  }
+
+  void SerialDmaTx::write(const uint8_t c) {
+    if (!active) {
+      MKSERIAL1.write(c);
+      return;
+    }
+
+    if (head - tail >= SERIAL_ESP_TX_DMA_SIZE) {
+      stalls++;
+      // Polled, so it works also with interrupts disabled
+      while (head - tail >= SERIAL_ESP_TX_DMA_SIZE) service();
+    }
+
+    tx_ring[head & (SERIAL_ESP_TX_DMA_SIZE - 1)] = c;
+    // The byte must be in SRAM before head makes it visible to service() (maybe from an ISR) and the DMAC
+    __DMB();
+    head++;
+
+    const uint16_t queued = head - tail;
+    if (queued > max_queued) max_queued = queued;
+
+    if (!sending) service();
+  }
+
+  void SerialDmaTx::flush() {
+    if (active) while (head != tail) service();
+    MKSERIAL1.flush();
+  }
+
+  void SerialDmaTx::service() {
+    CRITICAL_SECTION_START
+      DMAC->CHID.reg = DMAC_CHID_ID(SERIAL_DMA_TX_CHANNEL);
+      const uint8_t flags = DMAC->CHINTFLAG.reg & (DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR);
+      if (flags) {
+        // On a transfer error the span is dropped, the ESP will time out and resend
+        DMAC->CHINTFLAG.reg = flags;
+        tail += sending;
+        sending = 0;
+      }
+      if (!sending) start_transfer();
+    CRITICAL_SECTION_END
+  }
+
+  /** Private Function */
+
+  // Called with interrupts disabled and the TX channel selected
+  void SerialDmaTx::start_transfer() {
+    const uint32_t count = head - tail;
+    if (!count) return;
+
+    const uint16_t  index = tail & (SERIAL_ESP_TX_DMA_SIZE - 1),
+                    len   = MIN(count, (uint32_t)(SERIAL_ESP_TX_DMA_SIZE - index));
+
+    DmacDescriptor &desc = dma_descriptor[SERIAL_DMA_TX_CHANNEL];
+    desc.BTCTRL.reg   = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_SRCINC;
+    desc.BTCNT.reg    = len;
+    desc.SRCADDR.reg  = (uint32_t)tx_ring + index + len;  // End address when incrementing
+    desc.DSTADDR.reg  = (uint32_t)&sercom->USART.DATA.reg;
+    desc.DESCADDR.reg = 0;                                // Single block, channel stops at the end
+
+    sending = len;
+    DMAC->CHCTRLA.reg = DMAC_CHCTRLA_ENABLE;
+  }
+
+  void DMAC_Handler() {
+    serialDmaTx.service();
+  }
+
+#endif // ENABLED(SERIAL_ESP_TX_DMA)
+
+#endif // ENABLED(ARDUINO_ARCH_SAMD) && (ENABLED(SERIAL_ESP_RX_DMA) || ENABLED(SERIAL_ESP_TX_DMA))
@@ -0,0 +1,219 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * DMA rings for the SERCOM used by SerialEsp
+ *
+ * Receive: one DMAC channel moves every received byte from the SERCOM DATA
+ * register into a circular buffer (the descriptor links to itself), so the
+ * CPU is not interrupted per byte. The write index is sampled from the
+ * channel block counter: HAL::Tick() publishes it every millisecond (the
+ * SAMD21 SERCOM has no idle-line detection) and the reader refreshes it on
+ * demand. The reader walks contiguous spans of the ring instead of single bytes.
+ *
+ * Transmit: replies are copied into a ring and a second channel shifts out
+ * the contiguous span, restarted from the transfer complete interrupt, so
+ * the main loop only waits when the ring is full.
+ *
+ * ARDUINO_ARCH_SAMD
+ */
+
+#ifndef _HAL_SERIAL_DMA_SAMD_H_
+#define _HAL_SERIAL_DMA_SAMD_H_
+
+#if ENABLED(SERIAL_ESP_RX_DMA) || ENABLED(SERIAL_ESP_TX_DMA)
+
+// --------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------
+
+#ifndef SERIAL_ESP_RX_DMA_SIZE
+  #define SERIAL_ESP_RX_DMA_SIZE 256
+#endif
+#ifndef SERIAL_ESP_TX_DMA_SIZE
+  #define SERIAL_ESP_TX_DMA_SIZE 256
+#endif
+
+#if !IS_POWER_OF_2(SERIAL_ESP_RX_DMA_SIZE) || SERIAL_ESP_RX_DMA_SIZE < MAX_CMD_SIZE
+  #error "SERIAL_ESP_RX_DMA_SIZE must be a power of 2 not smaller than MAX_CMD_SIZE."
+#endif
+#if !IS_POWER_OF_2(SERIAL_ESP_TX_DMA_SIZE) || SERIAL_ESP_TX_DMA_SIZE > 32768
+  #error "SERIAL_ESP_TX_DMA_SIZE must be a power of 2 up to 32768."
+#endif
+
+#define SERIAL_DMA_RX_CHANNEL 0
+#define SERIAL_DMA_TX_CHANNEL 1
+
+class SerialDma {
+
+  public: /** Constructor */
+
+    SerialDma() {}
+
+  protected: /** Protected Parameters */
+
+    static Sercom*  sercom;
+    static uint8_t  sercom_index;
+
+  protected: /** Protected Function */
+
+    /**
+     * Look for the SERCOM running as USART at the given baudrate
+     * and take the DMAC. Return false if no SERCOM matches or the
+     * DMAC is already in use by someone else.
+     */
+    static bool init(const uint32_t baudrate);
+
+    // Release the DMAC when no ring is left active
+    static void release();
+
+};
+
+#if ENABLED(SERIAL_ESP_RX_DMA)
+
+  class SerialDmaRx : public SerialDma {
+
+    public: /** Constructor */
+
+      SerialDmaRx() {}
+
+    private: /** Private Parameters */
+
+      static volatile uint32_t  head;       // Bytes written by the DMAC since begin()
+      static volatile uint16_t  last_index; // Ring index at last publish
+      static uint32_t           tail,       // Bytes consumed since begin()
+                                overruns;   // Times the reader was overtaken
+      static bool               active;
+
+    public: /** Public Function */
+
+      /**
+       * Move the receiver of the SERCOM running at baudrate to DMA.
+       * Return false, keeping the interrupt driven Uart, if not possible.
+       */
+      static bool begin(const uint32_t baudrate);
+
+      /**
+       * Stop the DMA channel and give the receiver back to the Uart interrupt.
+       * Must be called before the Uart is restarted.
+       */
+      static void end();
+
+      /**
+       * Sample the channel block counter and advance the write index.
+       * Called from HAL::Tick(), it must run at least once per ring lap.
+       */
+      static void publish();
+
+      static uint16_t available();
+      static int read();
+
+      /**
+       * Get the contiguous received bytes starting at the read index.
+       * Return the span length, 0 if none.
+       */
+      static uint16_t span(const char* &data);
+
+      /**
+       * Release bytes returned by span()
+       */
+      static void consume(const uint16_t count);
+
+      FORCE_INLINE static bool isActive() { return active; }
+      FORCE_INLINE static uint32_t dropped() { return overruns; }
+
+    private: /** Private Function */
+
+      static void check_overrun();
+
+  };
+
+  extern SerialDmaRx serialDmaRx;
+
+#endif // ENABLED(SERIAL_ESP_RX_DMA)
+
+#if ENABLED(SERIAL_ESP_TX_DMA)
+
+  class SerialDmaTx : public SerialDma {
+
+    public: /** Constructor */
+
+      SerialDmaTx() {}
+
+    private: /** Private Parameters */
+
+      static volatile uint32_t  head,       // Bytes queued since begin()
+                                tail;       // Bytes shifted out since begin()
+      static volatile uint16_t  sending;    // Length of the span the channel is moving, 0 if idle
+      static uint32_t           stalls;     // Writes that waited for room
+      static uint16_t           max_queued; // High-water mark
+      static bool               active;
+
+    public: /** Public Function */
+
+      /**
+       * Move the transmitter of the SERCOM running at baudrate to DMA.
+       * After that all SerialEsp output must go through write().
+       */
+      static bool begin(const uint32_t baudrate);
+
+      /**
+       * Wait the ring to drain and stop the DMA channel.
+       * Must be called before the Uart is restarted.
+       */
+      static void end();
+
+      /**
+       * Queue a byte, waiting only if the ring is full.
+       * Falls back to the Uart when not active.
+       */
+      static void write(const uint8_t c);
+
+      /**
+       * Wait until all queued bytes have been shifted out
+       */
+      static void flush();
+
+      /**
+       * Handle a completed transfer and start the next span.
+       * Called by DMAC_Handler and by writers waiting for room.
+       */
+      static void service();
+
+      FORCE_INLINE static bool isActive() { return active; }
+      FORCE_INLINE static uint16_t maxQueued() { return max_queued; }
+      FORCE_INLINE static uint32_t stalled() { return stalls; }
+      FORCE_INLINE static void resetStats() { max_queued = 0; stalls = 0; }
+
+    private: /** Private Function */
+
+      static void start_transfer();
+
+  };
+
+  extern SerialDmaTx serialDmaTx;
+
+#endif // ENABLED(SERIAL_ESP_TX_DMA)
+
+#endif // ENABLED(SERIAL_ESP_RX_DMA) || ENABLED(SERIAL_ESP_TX_DMA)
+
+#endif // _HAL_SERIAL_DMA_SAMD_H_
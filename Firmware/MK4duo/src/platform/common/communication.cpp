@@ -45,6 +45,19 @@ FSTRINGVALUE(REQUESTPAUSE, "RequestPause:");
 /** Public Parameters */
 int8_t Com::serial_port = -1;
 
+uint32_t g_linkBaudrate = BAUDRATE_1;
+
+/** Private Function */
+
+// First serial output, through the DMA transmit ring when enabled
+FORCE_INLINE static void serial1_write(const uint8_t c) {
+  #if ENABLED(SERIAL_ESP_TX_DMA)
+    serialDmaTx.write(c);
+  #else
+    MKSERIAL1.write(c);
+  #endif
+}
+
 /** Public Function */
 void Com::setBaudrate() {
   MKSERIAL1.begin(BAUDRATE_1);
@@ -57,8 +70,32 @@ void Com::setBaudrate() {
   SERIAL_EOL();
 }
 
+void Com::changeBaudrate(const uint32_t baudrate) {
+  #if ENABLED(SERIAL_ESP_TX_DMA)
+    serialDmaTx.end();
+  #endif
+  #if ENABLED(SERIAL_ESP_RX_DMA)
+    serialDmaRx.end();
+  #endif
+  MKSERIAL1.flush();
+  MKSERIAL1.end();
+  MKSERIAL1.begin(baudrate);
+  #if ENABLED(SERIAL_ESP_RX_DMA)
+    serialDmaRx.begin(baudrate);
+  #endif
+  #if ENABLED(SERIAL_ESP_TX_DMA)
+    serialDmaTx.begin(baudrate);
+  #endif
+}
+
 void Com::serialFlush() {
-  if (serial_port == -1 || serial_port == 0) MKSERIAL1.flush();
+  if (serial_port == -1 || serial_port == 0) {
+    #if ENABLED(SERIAL_ESP_TX_DMA)
+      serialDmaTx.flush();
+    #else
+      MKSERIAL1.flush();
+    #endif
+  }
   #if NUM_SERIAL > 1
     if (serial_port == -1 || serial_port == 1) MKSERIAL2.flush();
   #endif
@@ -66,7 +103,12 @@ void Com::serialFlush() {
 
 int Com::serialRead(const uint8_t index) {
   switch (index) {
-    case 0: return MKSERIAL1.read();
+    case 0:
+      #if ENABLED(SERIAL_ESP_RX_DMA)
+        // Bytes left in the Uart buffer from before DMA start go first
+        if (serialDmaRx.isActive() && !MKSERIAL1.available()) return serialDmaRx.read();
+      #endif
+      return MKSERIAL1.read();
     #if NUM_SERIAL > 1
       case 1: return MKSERIAL2.read();
     #endif
@@ -76,6 +118,9 @@ int Com::serialRead(const uint8_t index) {
 
 bool Com::serialDataAvailable() {
   return (MKSERIAL1.available() ? true :
+    #if ENABLED(SERIAL_ESP_RX_DMA)
+      serialDmaRx.available() ? true :
+    #endif
     #if NUM_SERIAL > 1
       MKSERIAL2.available() ? true :
     #endif
@@ -84,7 +129,11 @@ bool Com::serialDataAvailable() {
 
 bool Com::serialDataAvailable(const uint8_t index) {
   switch (index) {
-    case 0: return MKSERIAL1.available();
+    case 0:
+      #if ENABLED(SERIAL_ESP_RX_DMA)
+        if (serialDmaRx.available()) return true;
+      #endif
+      return MKSERIAL1.available();
     #if NUM_SERIAL > 1
       case 1: MKSERIAL2.available();
     #endif
@@ -92,10 +141,29 @@ bool Com::serialDataAvailable(const uint8_t index) {
   }
 }
 
+uint16_t Com::serialSpan(const uint8_t index, const char* &data) {
+  #if ENABLED(SERIAL_ESP_RX_DMA)
+    if (index == 0 && serialDmaRx.isActive() && !MKSERIAL1.available()) return serialDmaRx.span(data);
+  #else
+    UNUSED(index);
+    UNUSED(data);
+  #endif
+  return 0;
+}
+
+void Com::serialConsume(const uint8_t index, const uint16_t count) {
+  #if ENABLED(SERIAL_ESP_RX_DMA)
+    if (index == 0) serialDmaRx.consume(count);
+  #else
+    UNUSED(index);
+    UNUSED(count);
+  #endif
+}
+
 // Functions for serial printing from PROGMEM. (Saves loads of SRAM.)
 void Com::printPGM(PGM_P str) {
   while (char c = pgm_read_byte(str++)) {
-    if (serial_port == -1 || serial_port == 0) MKSERIAL1.write(c);
+    if (serial_port == -1 || serial_port == 0) serial1_write(c);
     #if NUM_SERIAL > 1
       if (serial_port == -1 || serial_port == 1) MKSERIAL2.write(c);
     #endif
@@ -103,7 +171,7 @@ void Com::printPGM(PGM_P str) {
 }
 
 void Com::write(const uint8_t c) {
-  if (serial_port == -1 || serial_port == 0) MKSERIAL1.write(c);
+  if (serial_port == -1 || serial_port == 0) serial1_write(c);
   #if NUM_SERIAL > 1
     if (serial_port == -1 || serial_port == 1) MKSERIAL2.write(c);
   #endif
@@ -111,7 +179,7 @@ void Com::write(const uint8_t c) {
 
 void Com::write(const char* str) {
   while (*str) {
-    if (serial_port == -1 || serial_port == 0) MKSERIAL1.write(*str);
+    if (serial_port == -1 || serial_port == 0) serial1_write(*str);
     #if NUM_SERIAL > 1
     if (serial_port == -1 || serial_port == 1) MKSERIAL2.write(*str);
     #endif
@@ -121,7 +189,7 @@ void Com::write(const char* str) {
 
 void Com::write(const uint8_t* buffer, size_t size) {
   while (size--) {
-    if (serial_port == -1 || serial_port == 0) MKSERIAL1.write(*buffer);
+    if (serial_port == -1 || serial_port == 0) serial1_write(*buffer);
     #if NUM_SERIAL > 1
       if (serial_port == -1 || serial_port == 1) MKSERIAL2.write(*buffer);
     #endif
@@ -131,7 +199,7 @@ void Com::write(const uint8_t* buffer, size_t size) {
 
 void Com::print(const String& s) {
   for (int i = 0; i < (int)s.length(); i++) {
-    if (serial_port == -1 || serial_port == 0) MKSERIAL1.write(s[i]);
+    if (serial_port == -1 || serial_port == 0) serial1_write(s[i]);
     #if NUM_SERIAL > 1
       if (serial_port == -1 || serial_port == 1) MKSERIAL2.write(s[i]);
     #endif
@@ -185,7 +253,7 @@ void Com::println(void) {
 void Com::print_spaces(uint8_t count) {
   count *= (PROPORTIONAL_FONT_RATIO);
   while (count--) {
-    if (serial_port == -1 || serial_port == 0) MKSERIAL1.write(' ');
+    if (serial_port == -1 || serial_port == 0) serial1_write(' ');
     #if NUM_SERIAL > 1
       if (serial_port == -1 || serial_port == 1) MKSERIAL2.write(' ');
     #endif
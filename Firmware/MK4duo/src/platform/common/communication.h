@@ -58,6 +58,9 @@ class Com {
 
     static void setBaudrate();
 
+    // Restart first serial at a new baudrate, after all pending output is sent
+    static void changeBaudrate(const uint32_t baudrate);
+
     static void serialFlush();
 
     static int serialRead(const uint8_t index);
@@ -65,6 +68,10 @@ class Com {
     static bool serialDataAvailable();
     static bool serialDataAvailable(const uint8_t index);
 
+    // Contiguous received bytes, only for ports read through a DMA ring
+    static uint16_t serialSpan(const uint8_t index, const char* &data);
+    static void serialConsume(const uint8_t index, const uint16_t count);
+
     // Functions for serial printing from PROGMEM. (Saves loads of SRAM.)
     static void printPGM(PGM_P);
 
@@ -107,6 +114,9 @@ class Com {
 
 };
 
+// Current ESP link baudrate, set by M575
+extern uint32_t g_linkBaudrate;
+
 // MACRO FOR SERIAL
 #define SERIAL_PORT(p)                      (Com::serial_port = p)
 
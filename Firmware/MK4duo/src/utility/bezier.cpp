@@ -30,67 +30,65 @@
 
 #if ENABLED(G5_BEZIER)
 
-  // See the meaning in the documentation of cubic_b_spline().
-  #define MIN_STEP 0.002
-  #define MAX_STEP 0.1
-  #define SIGMA 0.1
+  // Fixed point of the curve state, in 1/2^40 mm
+  #define BEZIER_FRACT  40
+  // Control points are rounded to 1/2^10 mm, so the steps can be halved
+  // BEZIER_MAX_DEPTH times with no bit lost (3 bits each for c)
+  #define BEZIER_ROUND  10
+  #define BEZIER_MAX_DEPTH 10 // At most 1024 segments
 
   /**
-   * The algorithm for computing the step is loosely based on the one in Kig
-   * (See https://sources.debian.net/src/kig/4:15.08.3-1/misc/kigpainter.cpp/#L759)
-   * However, we do not use the stack.
+   * The curve is walked by adaptive forward differencing. For a step h
+   * of the parameter t the curve from the current point is
    *
-   * The algorithm goes as it follows: the parameters t runs from 0.0 to
-   * 1.0 describing the curve, which is evaluated by eval_bezier(). At
-   * each iteration we have to choose a step, i.e., the increment of the
-   * t variable. By default the step of the previous iteration is taken,
-   * and then it is enlarged or reduced depending on how straight the
-   * curve locally is. The step is always clamped between MIN_STEP/2 and
-   * 2*MAX_STEP. MAX_STEP is taken at the first iteration.
+   *   f(t + s * h) = f + a * s + b * s^2 + c * s^3,  s in [0, 1]
    *
-   * For some t, the step value is considered acceptable if the curve in
-   * the interval [t, t+step] is sufficiently straight, i.e.,
-   * sufficiently close to linear interpolation. In practice the
-   * following test is performed: the distance between eval_bezier(...,
-   * t+step/2) is evaluated and compared with 0.5*(eval_bezier(...,
-   * t)+eval_bezier(..., t+step)). If it is smaller than SIGMA, then the
-   * step value is considered acceptable, otherwise it is not. The code
-   * seeks to find the larger step value which is considered acceptable.
+   * so the next point is f + a + b + c, and moving to it only takes
+   * additions:
    *
-   * At every iteration the recorded step value is considered and then
-   * iteratively halved until it becomes acceptable. If it was already
-   * acceptable in the beginning (i.e., no halving were done), then
-   * maybe it was necessary to enlarge it; then it is iteratively
-   * doubled while it remains acceptable. The last acceptable value
-   * found is taken, provided that it is between MIN_STEP and MAX_STEP
-   * and does not bring t over 1.0.
+   *   f += a + b + c;  a += 2b + 3c;  b += 3c;
    *
-   * Caveat: this algorithm is not perfect, since it can happen that a
-   * step is considered acceptable even when the curve is not linear at
-   * all in the interval [t, t+step] (but its mid point coincides "by
-   * chance" with the midpoint according to the parametrization). This
-   * kind of glitches can be eliminated with proper first derivative
-   * estimates; however, given the improbability of such configurations,
-   * the mitigation offered by MIN_STEP and the small computational
-   * power available on Arduino, I think it is not wise to implement it.
+   * Halving the step is a >>= 1, b >>= 2, c >>= 3 and doubling it the
+   * shifts the other way, so everything is integer, and exact: there
+   * is no error building up along the curve, whatever its length.
+   *
+   * The step is halved until the chord is within G5_BEZIER_TOLERANCE
+   * from the curve (see is_flat()), and doubled again where the curve
+   * gets straighter. Doubling only happens when t is a multiple of the
+   * new step, so the last segment ends exactly at t = 1. A straight
+   * curve is a single segment.
    */
   void Bezier::cubic_b_spline(const float position[NUM_AXIS], const float target[NUM_AXIS], const float offset[4], float fr_mm_s, uint8_t extruder) {
 
-    // Absolute first and second control points are recovered.
-    const float first0 = position[X_AXIS] + offset[0],
-                first1 = position[Y_AXIS] + offset[1],
-                second0 = target[X_AXIS] + offset[2],
-                second1 = target[Y_AXIS] + offset[3];
-    float t = 0.0;
+    // Control points relative to the start point, rounded to 1/2^10 mm
+    int64_t p1[2], p2[2], p3[2];
+    for (uint8_t i = 0; i < 2; i++) {
+      p1[i] = (int64_t)LROUND(offset[i] * float(_BV32(BEZIER_ROUND)));
+      p3[i] = (int64_t)LROUND((target[i] - position[i]) * float(_BV32(BEZIER_ROUND)));
+      p2[i] = p3[i] + (int64_t)LROUND(offset[i + 2] * float(_BV32(BEZIER_ROUND)));
+    }
+
+    // Power basis for the whole curve, step h = 1
+    constexpr int64_t scale = _BV32(BEZIER_FRACT - BEZIER_ROUND);
+    int64_t f[2], a[2], b[2], c[2];
+    for (uint8_t i = 0; i < 2; i++) {
+      f[i] = 0;
+      a[i] = 3 * p1[i] * scale;
+      b[i] = 3 * (p2[i] - 2 * p1[i]) * scale;
+      c[i] = (p3[i] - 3 * (p2[i] - p1[i])) * scale;
+    }
+
+    // Tolerance for is_flat(), in 1/2^12 mm
+    const int64_t tolerance = LROUND((G5_BEZIER_TOLERANCE) * float(_BV32(BEZIER_FRACT - 28)));
 
-    float bez_target[4];
-    bez_target[X_AXIS] = position[X_AXIS];
-    bez_target[Y_AXIS] = position[Y_AXIS];
-    float step = MAX_STEP;
+    constexpr uint16_t t_end = _BV(BEZIER_MAX_DEPTH);
+    uint16_t t = 0, step = t_end;
+
+    float bez_target[XYZE];
 
     millis_t next_idle_ms = millis() + 200UL;
 
-    while (t < 1.0) {
+    while (t < t_end) {
 
       millis_t now = millis();
       if (ELAPSED(now, next_idle_ms)) {
@@ -98,52 +96,50 @@
         printer.idle();
       }
 
-      // First try to reduce the step in order to make it sufficiently
-      // close to a linear interpolation.
+      // Halve the step until the chord is close enough to the curve
       bool did_reduce = false;
-      float new_t = t + step;
-      NOMORE(new_t, 1.0);
-      float new_pos0 = eval_bezier(position[X_AXIS], first0, second0, target[X_AXIS], new_t);
-      float new_pos1 = eval_bezier(position[Y_AXIS], first1, second1, target[Y_AXIS], new_t);
-      for (;;) {
-        if (new_t - t < (MIN_STEP)) break;
-        const float candidate_t = 0.5 * (t + new_t),
-                    candidate_pos0 = eval_bezier(position[X_AXIS], first0, second0, target[X_AXIS], candidate_t),
-                    candidate_pos1 = eval_bezier(position[Y_AXIS], first1, second1, target[Y_AXIS], candidate_t),
-                    interp_pos0 = 0.5 * (bez_target[X_AXIS] + new_pos0),
-                    interp_pos1 = 0.5 * (bez_target[Y_AXIS] + new_pos1);
-        if (dist1(candidate_pos0, candidate_pos1, interp_pos0, interp_pos1) <= (SIGMA)) break;
-        new_t = candidate_t;
-        new_pos0 = candidate_pos0;
-        new_pos1 = candidate_pos1;
+      while (step > 1 && !is_flat(a, b, c, tolerance)) {
+        for (uint8_t i = 0; i < 2; i++) { a[i] >>= 1; b[i] >>= 2; c[i] >>= 3; }
+        step >>= 1;
         did_reduce = true;
       }
 
-      // If we did not reduce the step, maybe we should enlarge it.
+      // If we did not reduce the step, maybe we should enlarge it
+      // (never past t = 1, a straight curve would double it for ever)
       if (!did_reduce) for (;;) {
-        if (new_t - t > MAX_STEP) break;
-        const float candidate_t = t + 2.0 * (new_t - t);
-        if (candidate_t >= 1.0) break;
-        const float candidate_pos0 = eval_bezier(position[X_AXIS], first0, second0, target[X_AXIS], candidate_t),
-                    candidate_pos1 = eval_bezier(position[Y_AXIS], first1, second1, target[Y_AXIS], candidate_t),
-                    interp_pos0 = 0.5 * (bez_target[X_AXIS] + candidate_pos0),
-                    interp_pos1 = 0.5 * (bez_target[Y_AXIS] + candidate_pos1);
-        if (dist1(new_pos0, new_pos1, interp_pos0, interp_pos1) > (SIGMA)) break;
-        new_t = candidate_t;
-        new_pos0 = candidate_pos0;
-        new_pos1 = candidate_pos1;
+        if (step >= t_end - t || (t & ((step << 1) - 1))) break;
+        const int64_t a2[2] = { a[0] * 2, a[1] * 2 },
+                      b2[2] = { b[0] * 4, b[1] * 4 },
+                      c2[2] = { c[0] * 8, c[1] * 8 };
+        if (!is_flat(a2, b2, c2, tolerance)) break;
+        COPY_ARRAY(a, a2);
+        COPY_ARRAY(b, b2);
+        COPY_ARRAY(c, c2);
+        step <<= 1;
       }
 
-      step = new_t - t;
-      t = new_t;
+      // Move to the end of the step
+      for (uint8_t i = 0; i < 2; i++) {
+        f[i] += a[i] + b[i] + c[i];
+        a[i] += 2 * b[i] + 3 * c[i];
+        b[i] += 3 * c[i];
+      }
+      t += step;
 
       // Compute and send new position
-      bez_target[X_AXIS] = new_pos0;
-      bez_target[Y_AXIS] = new_pos1;
+      const float t_float = t * (1.0f / t_end);
+      if (t < t_end) {
+        bez_target[X_AXIS] = position[X_AXIS] + f[X_AXIS] * (1.0f / float(1ULL << BEZIER_FRACT));
+        bez_target[Y_AXIS] = position[Y_AXIS] + f[Y_AXIS] * (1.0f / float(1ULL << BEZIER_FRACT));
+      }
+      else {
+        bez_target[X_AXIS] = target[X_AXIS];
+        bez_target[Y_AXIS] = target[Y_AXIS];
+      }
       // FIXME. The following two are wrong, since the parameter t is
       // not linear in the distance.
-      bez_target[Z_AXIS] = interp(position[Z_AXIS], target[Z_AXIS], t);
-      bez_target[E_AXIS] = interp(position[E_AXIS], target[E_AXIS], t);
+      bez_target[Z_AXIS] = interp(position[Z_AXIS], target[Z_AXIS], t_float);
+      bez_target[E_AXIS] = interp(position[E_AXIS], target[E_AXIS], t_float);
       endstops.clamp_to_software(bez_target);
 
       #if HAS_LEVELING && !PLANNER_LEVELING
@@ -54,21 +54,42 @@
       */
       static inline float interp(float a, float b, float t) { return (1.0 - t) * a + t * b; }
 
-      static inline float eval_bezier(float a, float b, float c, float d, float t) {
-        float iab = interp(a, b, t);
-        float ibc = interp(b, c, t);
-        float icd = interp(c, d, t);
-        float iabc = interp(iab, ibc, t);
-        float ibcd = interp(ibc, icd, t);
-        float iabcd = interp(iabc, ibcd, t);
-        return iabcd;
+      /**
+       * We approximate Euclidean length with the larger coordinate plus
+       * half the smaller one. It is never shorter than the real length
+       * and at most 12% longer, with no multiply.
+       */
+      static inline int64_t length(int64_t x, int64_t y) {
+        if (x < 0) x = -x;
+        if (y < 0) y = -y;
+        return x > y ? x + (y >> 1) : y + (x >> 1);
       }
 
       /**
-       * We approximate Euclidean distance with the sum of the coordinates
-       * offset (so-called "norm 1"), which is quicker to compute.
+       * Check the chord of the step with polynomial f + a*s + b*s^2 + c*s^3,
+       * s in [0, 1], against the tolerance, all in 1/2^12 mm.
+       *
+       * Seen from f, the inner control points of the step are a/3 and
+       * (2a + b)/3, and the chord is d = a + b + c. When both project
+       * inside the chord, the curve is no farther from it than 3/4 of
+       * their distance from the chord line, i.e. |a x d| / (4 |d|) for the
+       * first one, taking |d| as 7/8 of length().
        */
-      static inline float dist1(float x1, float y1, float x2, float y2) { return ABS(x1 - x2) + ABS(y1 - y2); }
+      static inline bool is_flat(const int64_t a[2], const int64_t b[2], const int64_t c[2], const int64_t &tolerance) {
+        const int64_t d[2] = { (a[0] + b[0] + c[0]) >> 28, (a[1] + b[1] + c[1]) >> 28 },
+                      a1[2] = { a[0] >> 28, a[1] >> 28 },
+                      a2[2] = { (2 * a[0] + b[0]) >> 28, (2 * a[1] + b[1]) >> 28 },
+                      dd = 3 * (d[0] * d[0] + d[1] * d[1]),
+                      dot1 = a1[0] * d[0] + a1[1] * d[1],
+                      dot2 = a2[0] * d[0] + a2[1] * d[1];
+        if (dot1 < 0 || dot1 > dd || dot2 < 0 || dot2 > dd) return false;
+        const int64_t limit = 7 * tolerance * length(d[0], d[1]);
+        int64_t cross1 = a1[0] * d[1] - a1[1] * d[0],
+                cross2 = a2[0] * d[1] - a2[1] * d[0];
+        if (cross1 < 0) cross1 = -cross1;
+        if (cross2 < 0) cross2 = -cross2;
+        return 2 * cross1 <= limit && 2 * cross2 <= limit;
+      }
   };
 
 #endif // ENABLED(G5_BEZIER)
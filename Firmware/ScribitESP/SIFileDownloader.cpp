@@ -2,188 +2,259 @@
 
 #include <Arduino.h>
 #include <SPIFFS.h>
-#include <MD5Builder.h>
 #include "SIMQTT.hpp"
 
 #include "SIFileDownloader.hpp"
 #include "SIConfig.hpp"
 
 #define SI_SERVER_MD5_HEADER "x-goog-hash: md5"
-#define SI_MD5_LEN 16 + 1 //One more for string termnator
 #define TAG "SIFileDownloader"
 #define SI_DOWNLOADER_CHUNK_LEN 1024
 
 
-bool SIFileDownloader::download(String target, bool forcemd5Check)
+bool SIFileDownloader::download(String target, bool forcemd5Check, String fileName, std::function<void()> onIdle,
+                                std::function<void(const uint8_t *, uint16_t)> onFirstChunk)
 {
-    WiFiClient *client;
-    char serverMd5[SI_MD5_LEN] = {}; //Md5 got from server
-    MD5Builder localMd5;             //Md5 to be calculated locally
-    uint8_t buffer[SI_DOWNLOADER_CHUNK_LEN];
+    if (!startDownload(target, forcemd5Check, fileName, onFirstChunk))
+        return false;
 
-    bool md5Present = false; //Flag to check Md5 if in header
-    uint32_t len = 0;
+    //Download keeping caller alive between chunks
+    SIDownloadStatus status;
+    while ((status = downloadStep()) == SI_DOWNLOAD_RUNNING)
+    {
+        if (onIdle)
+            onIdle();
+    }
 
-#ifdef SI_DEBUG_BUILD
-    uint8_t percentage = 0; //Download percentage
-#endif
+    return status == SI_DOWNLOAD_DONE;
+}
 
-    localMd5.begin();
+bool SIFileDownloader::startDownload(String target, bool forcemd5Check, String fileName,
+                                     std::function<void(const uint8_t *, uint16_t)> onFirstChunk)
+{
+    //One download at a time
+    abortDownload();
 
-    client = parseTarget(target);
+    m_client = parseTarget(target);
+    if (m_client == nullptr)
+        return false;
 
     //Connect to server---------------------------------
-    if (!client->connect(m_host.c_str(), m_httpPort))
+    if (!m_client->connect(m_host.c_str(), m_httpPort))
     {
         SIMQTT.error(String("Connection failed to: ") + target, SIMQTT_ERROR_DOWNLOAD_CONNECTION_FAILED);
+        closeDownload();
         return false;
     }
-    else
-    {
-        SIMQTT.debug(TAG, String("Requesting URL: ") + m_url);
 
-        String s = String("GET ") + m_url + " HTTP/1.1\r\n" +
-                   "Host: " + m_host + "\r\n" +
-                   //"Range: bytes=" + readStart + "-" + (readStart + byteToDownload) + "\r\n" +
-                   "Connection: close\r\n\r\n";
+    SIMQTT.debug(TAG, String("Requesting URL: ") + m_url);
+
+    String s = String("GET ") + m_url + " HTTP/1.1\r\n" +
+               "Host: " + m_host + "\r\n" +
+               //"Range: bytes=" + readStart + "-" + (readStart + byteToDownload) + "\r\n" +
+               "Connection: close\r\n\r\n";
+
+    // This will send the request to the server
+    m_client->print(s);
+
+    m_fileName = fileName;
+    m_forceMd5 = forcemd5Check;
+    m_md5Present = false;
+    memset(m_serverMd5, 0, SI_MD5_LEN);
+    m_headerRead = false;
+    m_len = 0;
+    m_downloadedBytes = 0;
+    m_lastDataT = millis();
+    m_onFirstChunk = onFirstChunk;
+#ifdef SI_DEBUG_BUILD
+    m_percentage = 0;
+#endif
+
+    return true;
+}
+
+SIDownloadStatus SIFileDownloader::downloadStep()
+{
+    uint8_t buffer[SI_DOWNLOADER_CHUNK_LEN];
+
+    if (m_client == nullptr)
+        return SI_DOWNLOAD_FAILED;
 
-        // This will send the request to the server
-        client->print(s);
+    //First chunk is handed whole to onFirstChunk
+    uint32_t needed = 1;
+    if (m_headerRead && m_downloadedBytes == 0 && m_onFirstChunk)
+        needed = min(m_len, (uint32_t)SI_DOWNLOADER_CHUNK_LEN);
 
-        unsigned long timeout = millis();
-        while (client->available() == 0)
+    //Wait for data
+    uint32_t available = m_client->available();
+    if (available < needed)
+    {
+        if (millis() - m_lastDataT > SI_DOWNLOAD_TIMEOUT)
         {
-            if (millis() - timeout > SI_DOWNLOAD_TIMEOUT)
-            {
-                SIMQTT.error("Timeout downloading data", SIMQTT_ERROR_DOWNLOAD_TIMEOUT);
-                client->stop();
-                delete client;
-                return false;
-            }
+            SIMQTT.error("Timeout downloading data", SIMQTT_ERROR_DOWNLOAD_TIMEOUT);
+            closeDownload();
+            return SI_DOWNLOAD_FAILED;
         }
+        return SI_DOWNLOAD_RUNNING;
+    }
+    m_lastDataT = millis();
 
-        String line;
-        //Read response code--------------------------------
-        line = client->readStringUntil(0x0A);
-        uint16_t ti = line.indexOf(" ") + 1;
-        String code = line.substring(ti, line.indexOf(" ", ti));
-
-        //Evaluate response code----------------------------
-        if (code.equals("200")) //OK
+    if (!m_headerRead)
+    {
+        //Header------------------------------------------------------------------------------
+        if (!readHeader())
         {
-            //Delete old temp file
-            if (!SPIFFS.remove(SI_TEMPORARY_GCODE_PATH))
-            {
-                SIMQTT.debug(TAG, String("Unable to remove file ") + SI_TEMPORARY_GCODE_PATH);
-            }
-            //Open file
-            File file = SPIFFS.open(SI_TEMPORARY_GCODE_PATH, FILE_WRITE);
-            if (!file)
-            {
-                SIMQTT.error("Unable to open file to store gcode", SIMQTT_ERROR_DOWNLOAD_FILE_IO_ERROR);
-                client->stop();
-                delete client;
-                return false;
-            }
-            //Header------------------------------------------------------------------------------
-            do
-            {
-                line = client->readStringUntil(0x0A);
-
-                if (line.startsWith("Content-Length:") || line.startsWith("content-length:")) //Find length
-                {
-                    //Length---------------------------------------------------
-                    len = atoll(line.substring(15).c_str());
-
-                    if (len > SPIFFS.totalBytes() - SPIFFS.usedBytes())
-                    {
-                        SIMQTT.error("File too big for SPIFFS space", SIMQTT_ERROR_DOWNLOAD_FILE_TOO_BIG);
-                        client->stop();
-                        delete client;
-                        return false;
-                    }
-                }
-                else if (line.indexOf(SI_SERVER_MD5_HEADER) >= 0) //Check for md5
-                {
-                    //MD5---------------------------------------------------
-                    ti = line.indexOf("md5") + 3;
-                    String base64md5 = line.substring(ti, line.indexOf(" ", ti));
-                    base64_decodestate md5State;
-                    base64_init_decodestate(&md5State);
-                    base64_decode_block(base64md5.c_str(), base64md5.length(), serverMd5, &md5State);
-                    md5Present = true;
-                }
-
-            } while (client->available() && line.length() != 1);
-            uint32_t downloadedBytes = 0;
-            //Read data and fill buffer
-            while (downloadedBytes < len)
-            {
-                //Evaluate bytes to download in next chunk
-                uint16_t bytesToDownload = (len - downloadedBytes) > SI_DOWNLOADER_CHUNK_LEN ? SI_DOWNLOADER_CHUNK_LEN : (len - downloadedBytes);
+            closeDownload();
+            return SI_DOWNLOAD_FAILED;
+        }
+        m_headerRead = true;
+    }
+    else
+    {
+        //Read data already received, one chunk at most
+        uint32_t bytesToDownload = min(m_len - m_downloadedBytes, available);
+        if (bytesToDownload > SI_DOWNLOADER_CHUNK_LEN)
+            bytesToDownload = SI_DOWNLOADER_CHUNK_LEN;
 
-                uint16_t chunkLen = client->readBytes(buffer, bytesToDownload);
-                downloadedBytes += chunkLen;
+        uint16_t chunkLen = m_client->readBytes(buffer, bytesToDownload);
 
-                if (file.write(buffer, chunkLen) != chunkLen)
-                {
-                    SIMQTT.error("Write failed, is space over?", SIMQTT_ERROR_DOWNLOAD_FILE_IO_ERROR);
-                    file.close();
-                    client->stop();
-                    delete client;
-                    return false;
-                }
+        //Header of file available
+        if (m_downloadedBytes == 0 && m_onFirstChunk)
+            m_onFirstChunk(buffer, chunkLen);
+        m_downloadedBytes += chunkLen;
+
+        if (m_file.write(buffer, chunkLen) != chunkLen)
+        {
+            SIMQTT.error("Write failed, is space over?", SIMQTT_ERROR_DOWNLOAD_FILE_IO_ERROR);
+            closeDownload();
+            return SI_DOWNLOAD_FAILED;
+        }
 
 #ifdef SI_DEBUG_BUILD
-                //Evaluate percentage and send to debug
-                uint8_t newPerc = ((uint32_t)100 * downloadedBytes / len);
-                if (newPerc > percentage)
-                {
-                    percentage = newPerc;
-                    SIMQTT.debug(TAG, String("Downloading: ") + newPerc + "%");
-                }
+        //Evaluate percentage and send to debug
+        uint8_t newPerc = ((uint32_t)100 * m_downloadedBytes / m_len);
+        if (newPerc > m_percentage)
+        {
+            m_percentage = newPerc;
+            SIMQTT.debug(TAG, String("Downloading: ") + newPerc + "%");
+        }
 #endif
-            }
+    }
 
-            SIMQTT.debug(TAG, "File ended");
-            file.close();
-        }
-        else if (code.equals("404"))
+    if (m_downloadedBytes < m_len)
+        return SI_DOWNLOAD_RUNNING;
+
+    SIMQTT.debug(TAG, "File ended");
+    closeDownload();
+
+    return checkMd5() ? SI_DOWNLOAD_DONE : SI_DOWNLOAD_FAILED;
+}
+
+void SIFileDownloader::abortDownload()
+{
+    if (m_client == nullptr)
+        return;
+
+    SIMQTT.debug(TAG, String("Download aborted: ") + m_fileName);
+    closeDownload();
+}
+
+bool SIFileDownloader::readHeader()
+{
+    String line;
+    //Read response code--------------------------------
+    line = m_client->readStringUntil(0x0A);
+    uint16_t ti = line.indexOf(" ") + 1;
+    String code = line.substring(ti, line.indexOf(" ", ti));
+
+    //Evaluate response code----------------------------
+    if (code.equals("404"))
+    {
+        SIMQTT.error("Error 404", SIMQTT_ERROR_DOWNLOAD_404);
+        return false;
+    }
+    else if (!code.equals("200")) //Not OK
+    {
+        SIMQTT.error("Client replied with Unknown code: " + code, SIMQTT_ERROR_DOWNLOAD_UNKNOWN);
+        return false;
+    }
+
+    //Delete old file
+    if (!SPIFFS.remove(m_fileName))
+    {
+        SIMQTT.debug(TAG, String("Unable to remove file ") + m_fileName);
+    }
+    //Open file
+    m_file = SPIFFS.open(m_fileName, FILE_WRITE);
+    if (!m_file)
+    {
+        SIMQTT.error("Unable to open file to store gcode", SIMQTT_ERROR_DOWNLOAD_FILE_IO_ERROR);
+        return false;
+    }
+    do
+    {
+        line = m_client->readStringUntil(0x0A);
+
+        if (line.startsWith("Content-Length:") || line.startsWith("content-length:")) //Find length
         {
-            SIMQTT.error("Error 404", SIMQTT_ERROR_DOWNLOAD_404);
-            client->stop();
-            delete client;
-            return false;
+            //Length---------------------------------------------------
+            m_len = atoll(line.substring(15).c_str());
+
+            if (m_len > SPIFFS.totalBytes() - SPIFFS.usedBytes())
+            {
+                SIMQTT.error("File too big for SPIFFS space", SIMQTT_ERROR_DOWNLOAD_FILE_TOO_BIG);
+                return false;
+            }
         }
-        else
+        else if (line.indexOf(SI_SERVER_MD5_HEADER) >= 0) //Check for md5
         {
-            SIMQTT.error("Client replied with Unknown code: " + code, SIMQTT_ERROR_DOWNLOAD_UNKNOWN);
-            client->stop();
-            delete client;
-            return false;
+            //MD5---------------------------------------------------
+            ti = line.indexOf("md5") + 3;
+            String base64md5 = line.substring(ti, line.indexOf(" ", ti));
+            base64_decodestate md5State;
+            base64_init_decodestate(&md5State);
+            base64_decode_block(base64md5.c_str(), base64md5.length(), m_serverMd5, &md5State);
+            m_md5Present = true;
         }
+
+    } while (m_client->available() && line.length() != 1);
+
+    return true;
+}
+
+void SIFileDownloader::closeDownload()
+{
+    if (m_file)
+        m_file.close();
+    if (m_client != nullptr)
+    {
+        m_client->stop();
+        delete m_client;
+        m_client = nullptr;
     }
-    client->stop();
-    delete client;
+}
 
-    //Check md5----------------------------------------------
-    if (md5Present)
+bool SIFileDownloader::checkMd5()
+{
+    if (m_md5Present)
     {
         char calculatedMd5[SI_MD5_LEN] = {};
+        MD5Builder localMd5; //Md5 to be calculated locally
 
-        File file = SPIFFS.open(SI_TEMPORARY_GCODE_PATH, FILE_READ);
+        File file = SPIFFS.open(m_fileName, FILE_READ);
         if (!file)
         {
-            SIMQTT.error("Unable to open temporary gcode file in read mode", SIMQTT_ERROR_DOWNLOAD_FILE_IO_ERROR);
+            SIMQTT.error("Unable to open downloaded gcode file in read mode", SIMQTT_ERROR_DOWNLOAD_FILE_IO_ERROR);
             return false;
         }
         //Check size
-        if (file.size() != len)
+        if (file.size() != m_len)
         {
             SIMQTT.error("File dimension mismatch ", SIMQTT_ERROR_DOWNLOAD_FILE_IO_ERROR);
         }
         //Evaluate md5
-        localMd5.addStream(file, len);
+        localMd5.begin();
+        localMd5.addStream(file, m_len);
         localMd5.calculate(); //Evaluate md5
         localMd5.getBytes((uint8_t *)calculatedMd5);
         file.close();
@@ -192,14 +263,14 @@ bool SIFileDownloader::download(String target, bool forcemd5Check)
         for (int i = 0; i < SI_MD5_LEN; i++)
         {
 
-            if (calculatedMd5[i] != serverMd5[i])
+            if (calculatedMd5[i] != m_serverMd5[i])
             {
                 SIMQTT.error("Md5 mismatch", SIMQTT_ERROR_DOWNLOAD_FILE_IO_ERROR);
                 return false;
             }
         }
     }
-    else if (forcemd5Check)
+    else if (m_forceMd5)
     {
         SIMQTT.error("Missing md5 but control forced. Cannot download", SIMQTT_ERROR_DOWNLOAD_FILE_IO_ERROR);
         return false;
@@ -1,10 +1,59 @@
 #pragma once
+#include <functional>
+#include <MD5Builder.h>
+#include "FS.h"
 #include "WiFiClientSecure.h"
+#include "SIConfig.hpp"
+
+#define SI_MD5_LEN 16 + 1 //One more for string termnator
+
+enum SIDownloadStatus
+{
+  SI_DOWNLOAD_RUNNING,
+  SI_DOWNLOAD_DONE,
+  SI_DOWNLOAD_FAILED
+};
+
 class SIFileDownloader
 {
   String m_host,m_url;
   uint16_t m_httpPort;
 
+  //Download in progress
+  WiFiClient *m_client;      //nullptr if no download in progress
+  File m_file;
+  String m_fileName;
+  bool m_forceMd5;
+  bool m_md5Present;
+  char m_serverMd5[SI_MD5_LEN];
+  bool m_headerRead;         //Response header parsed, data follows
+  uint32_t m_len;            //Content length
+  uint32_t m_downloadedBytes;
+  uint32_t m_lastDataT;      //Time data was last received
+  std::function<void(const uint8_t *,uint16_t)> m_onFirstChunk;
+#ifdef SI_DEBUG_BUILD
+  uint8_t m_percentage;      //Download percentage
+#endif
+
+  /**
+   * @brief Reads response code and header, opens file if data follows
+   * 
+   * @return true if data follows, false if not
+   */
+  bool readHeader();
+
+  /**
+   * @brief Closes client and file of download in progress
+   */
+  void closeDownload();
+
+  /**
+   * @brief Checks downloaded file against server md5
+   * 
+   * @return true if md5 matches (Or is missing and not forced)
+   */
+  bool checkMd5();
+
   /**
    * @brief Parses download url 
    * 
@@ -15,17 +64,48 @@ class SIFileDownloader
   WiFiClient* parseTarget(String target);
 
   public:
-    SIFileDownloader(){};
+    SIFileDownloader() : m_client(nullptr){};
 
     /**
      * @brief Downloads given files and saves it in SPIFFS
      * 
      * @param target[in] Complete url of the file
      * @param forcemd5Check[in] Forces check on md5 (Download fails if server does not provide md5)ù
+     * @param fileName[in] Path in SPIFFS where file is saved
+     * @param onIdle[in] Called while waiting data and between chunks, allows to keep streaming during download
+     * @param onFirstChunk[in] Called with first downloaded chunk, allows to read file header before download ends
      * 
      * @return true if download succeeds, false if not
      */
-    bool download(String target,bool forcemd5Check=true);
+    bool download(String target,bool forcemd5Check=true,String fileName=SI_TEMPORARY_GCODE_PATH,std::function<void()> onIdle=nullptr,
+                  std::function<void(const uint8_t *,uint16_t)> onFirstChunk=nullptr);
+
+    /**
+     * @brief Connects and requests file, downloadStep() then downloads it without blocking
+     * 
+     * @param target[in] Complete url of the file
+     * @param forcemd5Check[in] Forces check on md5 (Download fails if server does not provide md5)
+     * @param fileName[in] Path in SPIFFS where file is saved
+     * @param onFirstChunk[in] Called with first downloaded chunk, allows to read file header before download ends
+     * 
+     * @return true if request sent, false if not
+     */
+    bool startDownload(String target,bool forcemd5Check=true,String fileName=SI_TEMPORARY_GCODE_PATH,
+                       std::function<void(const uint8_t *,uint16_t)> onFirstChunk=nullptr);
+
+    /**
+     * @brief Saves received data, at most one chunk, call it until download ends
+     * 
+     * @return SI_DOWNLOAD_RUNNING until file is complete and verified (SI_DOWNLOAD_DONE) or download fails
+     */
+    SIDownloadStatus downloadStep();
+
+    /**
+     * @brief Drops download in progress, if any
+     */
+    void abortDownload();
+
+    bool isDownloading() { return m_client != nullptr; }
     
     /**
      * @brief Given inetial data sent to CDN wait a given time and retrieve the response
@@ -0,0 +1,685 @@
+#include "SIJobEstimator.hpp"
+#include "SPIFFS.h"
+#include "SIMQTT.hpp"
+
+#define SI_EST_M777_WAIT_S 0.5 //Wait before inertial data read
+
+#define SI_EST_MAX_LINE_LEN 128
+#define SI_EST_SCAN_SLICE_MS 5 //File scan time for each stream loop
+#define SI_EST_Z_AXIS 2
+
+#define TAG "JobEstimator"
+
+//SIMotionModel--------------------------------------------------------------------------------------------------
+
+void SIMotionModel::reset()
+{
+    for (uint8_t i = 0; i < SI_EST_AXES; i++)
+    {
+        m_stepsPerMm[i] = SI_EST_DEFAULT_STEPS_PER_MM[i];
+        m_maxFeedrate[i] = SI_EST_DEFAULT_MAX_FEEDRATE[i];
+        m_maxAcceleration[i] = SI_EST_DEFAULT_MAX_ACCELERATION[i];
+        m_position[i] = 0;
+#ifdef SI_EST_JUNCTION_DEVIATION
+        m_prevUnitVec[i] = 0;
+#else
+        m_maxJerk[i] = SI_EST_DEFAULT_JERK[i];
+        m_prevSpeed[i] = 0;
+#endif
+    }
+    m_travelAcceleration = SI_EST_DEFAULT_TRAVEL_ACCELERATION;
+#ifdef SI_EST_JUNCTION_DEVIATION
+    m_junctionDeviation = SI_EST_DEFAULT_JUNCTION_DEVIATION;
+#else
+    m_prevSafeSpeed = 0;
+#endif
+    m_feedrate = SI_EST_DEFAULT_FEEDRATE;
+    m_relative = false;
+    m_carouselHomed = false;
+
+    m_tail = 0;
+    m_count = 0;
+    m_prevNominalSpeedSqr = 0;
+    m_time = 0;
+}
+
+bool SIMotionModel::addLine(const char *line)
+{
+    float l_target[SI_EST_AXES];
+    bool l_hasAxis[SI_EST_AXES] = {false, false, false};
+    float l_axisValue[SI_EST_AXES] = {0, 0, 0};
+    char l_command = 0; //'G' or 'M'
+    int16_t l_code = -1;
+    bool l_hasF = false, l_hasP = false, l_hasS = false, l_hasV = false;
+    float l_f = 0, l_p = 0, l_s = 0, l_v = 0;
+#ifdef SI_EST_JUNCTION_DEVIATION
+    bool l_hasJ = false;
+    float l_j = 0;
+#endif
+
+    //Parse words--------------------------------------
+    const char *l_ptr = line;
+    while (*l_ptr != 0 && *l_ptr != '*' && *l_ptr != ';')
+    {
+        char l_letter = toupper(*l_ptr);
+        if (l_letter < 'A' || l_letter > 'Z')
+        {
+            l_ptr++;
+            continue;
+        }
+
+        char *l_end;
+        float l_value = strtof(l_ptr + 1, &l_end);
+        if (l_end == l_ptr + 1) //Letter without value
+        {
+            l_ptr++;
+            continue;
+        }
+        l_ptr = l_end;
+
+        switch (l_letter)
+        {
+        case 'G':
+        case 'M':
+            if (l_command == 0)
+            {
+                l_command = l_letter;
+                l_code = (int16_t)l_value;
+            }
+            break;
+        case 'X':
+        case 'Y':
+        case 'Z':
+            l_hasAxis[l_letter - 'X'] = true;
+            l_axisValue[l_letter - 'X'] = l_value;
+            break;
+        case 'F':
+            l_hasF = true;
+            l_f = l_value;
+            break;
+        case 'P':
+            l_hasP = true;
+            l_p = l_value;
+            break;
+        case 'S':
+            l_hasS = true;
+            l_s = l_value;
+            break;
+        case 'V':
+            l_hasV = true;
+            l_v = l_value;
+            break;
+#ifdef SI_EST_JUNCTION_DEVIATION
+        case 'J':
+            l_hasJ = true;
+            l_j = l_value;
+            break;
+#endif
+        default: //N and unused parameters
+            break;
+        }
+    }
+
+    if (l_command == 'G')
+    {
+        switch (l_code)
+        {
+        case 0:
+        case 1:
+            if (l_hasF && l_f > 0)
+                m_feedrate = l_f / 60.0;
+            for (uint8_t i = 0; i < SI_EST_AXES; i++)
+            {
+                l_target[i] = m_position[i];
+                if (l_hasAxis[i])
+                    l_target[i] = m_relative ? m_position[i] + l_axisValue[i] : l_axisValue[i];
+            }
+            addMove(l_target);
+            break;
+        case 4:
+            flush();
+            if (l_hasP)
+                m_time += l_p / 1000.0;
+            else if (l_hasS)
+                m_time += l_s;
+            return true;
+        case 90:
+            m_relative = false;
+            break;
+        case 91:
+            m_relative = true;
+            break;
+        case 92:
+            flush();
+            for (uint8_t i = 0; i < SI_EST_AXES; i++)
+            {
+                if (l_hasAxis[i])
+                    m_position[i] = l_axisValue[i];
+            }
+            break;
+        case 77:
+            //Carousel homed at Z 0
+            flush();
+            m_position[SI_EST_Z_AXIS] = 0;
+            m_carouselHomed = true;
+            return true;
+        case 28:
+        case 100:
+        case 101:
+            //Homing and Scribit moves synchronize the planner
+            flush();
+            return true;
+        default:
+            break;
+        }
+    }
+    else if (l_command == 'M')
+    {
+        switch (l_code)
+        {
+        case 92:
+            for (uint8_t i = 0; i < SI_EST_AXES; i++)
+            {
+                if (l_hasAxis[i] && l_axisValue[i] != 0)
+                    m_stepsPerMm[i] = l_axisValue[i];
+            }
+            break;
+        case 201:
+            for (uint8_t i = 0; i < SI_EST_AXES; i++)
+            {
+                if (l_hasAxis[i] && l_axisValue[i] > 0)
+                    m_maxAcceleration[i] = l_axisValue[i];
+            }
+            break;
+        case 203:
+            for (uint8_t i = 0; i < SI_EST_AXES; i++)
+            {
+                if (l_hasAxis[i] && l_axisValue[i] > 0)
+                    m_maxFeedrate[i] = l_axisValue[i];
+            }
+            break;
+        case 204:
+            //Scribit has no extruder: only travel acceleration is used (M204 P/T leave it unchanged)
+            if (l_hasS)
+                m_travelAcceleration = l_s;
+            if (l_hasV)
+                m_travelAcceleration = l_v;
+            break;
+        case 205:
+#ifdef SI_EST_JUNCTION_DEVIATION
+            //As MK4duo, out of range values are refused
+            if (l_hasJ && l_j >= 0.01 && l_j <= 0.3)
+                m_junctionDeviation = l_j;
+#else
+            for (uint8_t i = 0; i < SI_EST_AXES; i++)
+            {
+                if (l_hasAxis[i] && l_axisValue[i] >= 0)
+                    m_maxJerk[i] = l_axisValue[i];
+            }
+#endif
+            break;
+        case 109:
+            //Waits temperature, planner is not synchronized
+            flush();
+            break;
+        case 400:
+            flush();
+            return true;
+        case 777:
+            flush();
+            m_time += SI_EST_M777_WAIT_S;
+            return true;
+        default:
+            break;
+        }
+    }
+
+    return false;
+}
+
+void SIMotionModel::addMove(const float target[SI_EST_AXES])
+{
+    float l_delta[SI_EST_AXES];
+    float l_sqrSum = 0;
+    bool l_enoughSteps = false;
+
+    for (uint8_t i = 0; i < SI_EST_AXES; i++)
+    {
+        l_delta[i] = target[i] - m_position[i];
+        l_sqrSum += l_delta[i] * l_delta[i];
+        if (fabs(l_delta[i] * m_stepsPerMm[i]) >= SI_EST_MIN_STEPS_PER_SEGMENT)
+            l_enoughSteps = true;
+    }
+
+    //As MK4duo, moves too short are dropped and merged with next one
+    if (!l_enoughSteps)
+        return;
+
+    //Window full: retire oldest block
+    if (m_count == SI_EST_LOOKAHEAD_BLOCKS)
+    {
+        plan();
+        retire();
+    }
+
+    Block &l_block = blockAt(m_count);
+    l_block.millimeters = sqrt(l_sqrSum);
+    const float l_inverseMm = 1.0 / l_block.millimeters;
+
+    //Limit speed by axis maximum feedrate
+    float l_speed = m_feedrate;
+    float l_unitVec[SI_EST_AXES];
+    for (uint8_t i = 0; i < SI_EST_AXES; i++)
+    {
+        l_unitVec[i] = l_delta[i] * l_inverseMm;
+        if (l_unitVec[i] != 0)
+            l_speed = min(l_speed, (float)fabs(m_maxFeedrate[i] / l_unitVec[i]));
+    }
+    l_block.nominalSpeedSqr = l_speed * l_speed;
+
+    //Limit acceleration by axis maximum acceleration
+    l_block.acceleration = m_travelAcceleration;
+    for (uint8_t i = 0; i < SI_EST_AXES; i++)
+    {
+        if (l_unitVec[i] != 0)
+            l_block.acceleration = min(l_block.acceleration, (float)fabs(m_maxAcceleration[i] / l_unitVec[i]));
+    }
+
+    float l_vmaxJunctionSqr = 0;
+#ifdef SI_EST_JUNCTION_DEVIATION
+    //Junction deviation
+    if (m_count > 0 && m_prevNominalSpeedSqr > 0)
+    {
+        float l_cosTheta = 0;
+        for (uint8_t i = 0; i < SI_EST_AXES; i++)
+            l_cosTheta -= m_prevUnitVec[i] * l_unitVec[i];
+
+        if (l_cosTheta > 0.999999)
+        {
+            l_vmaxJunctionSqr = SI_EST_MINIMUM_PLANNER_SPEED * SI_EST_MINIMUM_PLANNER_SPEED;
+        }
+        else
+        {
+            l_cosTheta = max(l_cosTheta, (float)-0.999999);
+
+            float l_junctionVec[SI_EST_AXES];
+            float l_magnitudeSqr = 0;
+            for (uint8_t i = 0; i < SI_EST_AXES; i++)
+            {
+                l_junctionVec[i] = l_unitVec[i] - m_prevUnitVec[i];
+                l_magnitudeSqr += l_junctionVec[i] * l_junctionVec[i];
+            }
+            float l_junctionAcc = l_block.acceleration;
+            for (uint8_t i = 0; i < SI_EST_AXES; i++)
+            {
+                const float l_component = l_junctionVec[i] / sqrt(l_magnitudeSqr);
+                if (l_component != 0)
+                    l_junctionAcc = min(l_junctionAcc, (float)fabs(m_maxAcceleration[i] / l_component));
+            }
+
+            const float l_sinThetaD2 = sqrt(0.5 * (1.0 - l_cosTheta));
+            l_vmaxJunctionSqr = (l_junctionAcc * m_junctionDeviation * l_sinThetaD2) / (1.0 - l_sinThetaD2);
+
+            if (l_block.millimeters < 1.0)
+            {
+                const float l_theta = (radians(-40) * l_cosTheta * l_cosTheta - radians(50)) * l_cosTheta + radians(90) - 0.18;
+                if (l_theta > radians(135))
+                    l_vmaxJunctionSqr = min(l_vmaxJunctionSqr, (float)(l_block.millimeters / (radians(180) - l_theta) * l_junctionAcc));
+            }
+        }
+        l_vmaxJunctionSqr = min(l_vmaxJunctionSqr, min(l_block.nominalSpeedSqr, m_prevNominalSpeedSqr));
+    }
+#else
+    //Classic jerk: safe speed is the speed the move can start from (or stop to) without exceeding any axis jerk
+    float l_speedVec[SI_EST_AXES];
+    float l_safeSpeed = l_speed;
+    uint8_t l_limited = 0;
+    for (uint8_t i = 0; i < SI_EST_AXES; i++)
+    {
+        l_speedVec[i] = l_unitVec[i] * l_speed;
+        const float l_jerk = fabs(l_speedVec[i]);
+        if (l_jerk > m_maxJerk[i])
+        {
+            if (l_limited)
+            {
+                const float l_maxJerk = m_maxJerk[i] * l_speed;
+                if (l_jerk * l_safeSpeed > l_maxJerk)
+                    l_safeSpeed = l_maxJerk / l_jerk;
+            }
+            else
+            {
+                l_safeSpeed *= m_maxJerk[i] / l_jerk;
+                l_limited++;
+            }
+        }
+    }
+
+    float l_vmaxJunction = l_safeSpeed;
+    if (m_count > 0 && m_prevNominalSpeedSqr > 0)
+    {
+        //Shared junction speed limited by the speed change of each axis (coasting or reversal)
+        const float l_prevNominalSpeed = sqrt(m_prevNominalSpeedSqr);
+        l_vmaxJunction = min(l_speed, l_prevNominalSpeed);
+        const float l_smallerSpeedFactor = l_vmaxJunction / l_prevNominalSpeed;
+        float l_vFactor = 1;
+        l_limited = 0;
+        for (uint8_t i = 0; i < SI_EST_AXES; i++)
+        {
+            float l_vExit = m_prevSpeed[i] * l_smallerSpeedFactor;
+            float l_vEntry = l_speedVec[i];
+            if (l_limited)
+            {
+                l_vExit *= l_vFactor;
+                l_vEntry *= l_vFactor;
+            }
+
+            const float l_jerk = (l_vExit > l_vEntry)
+                                     ? ((l_vEntry > 0 || l_vExit < 0) ? (l_vExit - l_vEntry) : max(l_vExit, -l_vEntry))
+                                     : ((l_vEntry < 0 || l_vExit > 0) ? (l_vEntry - l_vExit) : max(-l_vExit, l_vEntry));
+            if (l_jerk > m_maxJerk[i])
+            {
+                l_vFactor *= m_maxJerk[i] / l_jerk;
+                l_limited++;
+            }
+        }
+        if (l_limited)
+            l_vmaxJunction *= l_vFactor;
+
+        const float l_threshold = l_vmaxJunction * 0.99;
+        if (m_prevSafeSpeed > l_threshold && l_safeSpeed > l_threshold)
+            l_vmaxJunction = l_safeSpeed;
+    }
+    m_prevSafeSpeed = l_safeSpeed;
+    l_vmaxJunctionSqr = l_vmaxJunction * l_vmaxJunction;
+#endif
+
+    l_block.maxEntrySpeedSqr = l_vmaxJunctionSqr;
+    l_block.entrySpeedSqr = l_vmaxJunctionSqr;
+    m_count++;
+
+    for (uint8_t i = 0; i < SI_EST_AXES; i++)
+    {
+#ifdef SI_EST_JUNCTION_DEVIATION
+        m_prevUnitVec[i] = l_unitVec[i];
+#else
+        m_prevSpeed[i] = l_speedVec[i];
+#endif
+        m_position[i] = target[i];
+    }
+    m_prevNominalSpeedSqr = l_block.nominalSpeedSqr;
+}
+
+void SIMotionModel::plan()
+{
+    if (m_count == 0)
+        return;
+
+    //Reverse pass: every block must be able to stop at end of window
+    float l_nextEntrySqr = SI_EST_MINIMUM_PLANNER_SPEED * SI_EST_MINIMUM_PLANNER_SPEED;
+    for (int16_t i = m_count - 1; i >= 0; i--)
+    {
+        Block &l_block = blockAt(i);
+        l_block.entrySpeedSqr = min(l_block.maxEntrySpeedSqr, l_nextEntrySqr + 2 * l_block.acceleration * l_block.millimeters);
+        l_nextEntrySqr = l_block.entrySpeedSqr;
+    }
+
+    //Forward pass: entry speed must be reachable from previous block
+    for (uint8_t i = 1; i < m_count; i++)
+    {
+        Block &l_prev = blockAt(i - 1);
+        Block &l_block = blockAt(i);
+        const float l_reachableSqr = l_prev.entrySpeedSqr + 2 * l_prev.acceleration * l_prev.millimeters;
+        if (l_reachableSqr < l_block.entrySpeedSqr)
+            l_block.entrySpeedSqr = l_reachableSqr;
+    }
+}
+
+void SIMotionModel::retire()
+{
+    const float l_exitSqr = (m_count > 1) ? blockAt(1).entrySpeedSqr : SI_EST_MINIMUM_PLANNER_SPEED * SI_EST_MINIMUM_PLANNER_SPEED;
+    m_time += trapezoidTime(blockAt(0), l_exitSqr);
+    m_tail = (m_tail + 1) % SI_EST_LOOKAHEAD_BLOCKS;
+    m_count--;
+}
+
+void SIMotionModel::flush()
+{
+    plan();
+    while (m_count > 0)
+        retire();
+    //Planner empty: next block starts from rest
+    m_prevNominalSpeedSqr = 0;
+}
+
+float SIMotionModel::getTime()
+{
+    plan();
+    float l_time = m_time;
+    for (uint8_t i = 0; i < m_count; i++)
+    {
+        const float l_exitSqr = (i + 1 < m_count) ? blockAt(i + 1).entrySpeedSqr : SI_EST_MINIMUM_PLANNER_SPEED * SI_EST_MINIMUM_PLANNER_SPEED;
+        l_time += trapezoidTime(blockAt(i), l_exitSqr);
+    }
+    return l_time;
+}
+
+void SIMotionModel::getPosition(float position[SI_EST_AXES])
+{
+    for (uint8_t i = 0; i < SI_EST_AXES; i++)
+        position[i] = m_position[i];
+}
+
+float SIMotionModel::trapezoidTime(const Block &block, float exitSpeedSqr)
+{
+    const float l_entry = sqrt(block.entrySpeedSqr);
+    const float l_exit = sqrt(exitSpeedSqr);
+    const float l_twoAcc = 2 * block.acceleration;
+
+    //Distances to reach nominal speed from entry and to decelerate to exit
+    float l_accelDist = (block.nominalSpeedSqr - block.entrySpeedSqr) / l_twoAcc;
+    float l_decelDist = (block.nominalSpeedSqr - exitSpeedSqr) / l_twoAcc;
+    float l_peakSqr = block.nominalSpeedSqr;
+
+    if (l_accelDist + l_decelDist > block.millimeters)
+    {
+        //Triangle profile: nominal speed is never reached
+        l_peakSqr = (block.entrySpeedSqr + exitSpeedSqr) / 2 + block.acceleration * block.millimeters;
+        l_accelDist = max((float)0, (l_peakSqr - block.entrySpeedSqr) / l_twoAcc);
+        l_decelDist = max((float)0, block.millimeters - l_accelDist);
+    }
+    const float l_peak = sqrt(l_peakSqr);
+    const float l_cruiseDist = max((float)0, block.millimeters - l_accelDist - l_decelDist);
+
+    float l_time = (l_peak - l_entry) / block.acceleration + (l_peak - l_exit) / block.acceleration;
+    if (l_peak > 0)
+        l_time += l_cruiseDist / l_peak;
+
+    return max((float)0, l_time);
+}
+
+//SIJobEstimator-------------------------------------------------------------------------------------------------
+
+void SIJobEstimator::reset()
+{
+    if (m_scanModel != nullptr)
+    {
+        m_scanFile.close();
+        delete m_scanModel;
+        m_scanModel = nullptr;
+    }
+    m_startReached = true;
+
+    m_model.reset();
+    m_totalBytes = 0;
+    m_totalLines = 0;
+    m_totalTime = 0;
+    m_ackedBytes = 0;
+    m_ackedLines = 0;
+    m_baseTime = 0;
+    m_baseBytes = 0;
+    m_baseLines = 0;
+    m_syncPoint.sequence = 0;
+    m_startT = millis();
+    m_runningMs = 0;
+    m_isPaused = false;
+}
+
+bool SIJobEstimator::startScan(const String &fileName, uint32_t startOffset)
+{
+    reset();
+
+    m_scanFile = SPIFFS.open(fileName, FILE_READ);
+    if (!m_scanFile)
+        return false;
+
+    m_scanModel = new SIMotionModel();
+    m_totalBytes = m_scanFile.size();
+    m_scanStartOffset = startOffset;
+    m_scanLines = 0;
+    m_scanMs = 0;
+    m_startReached = (startOffset == 0);
+
+    return true;
+}
+
+void SIJobEstimator::scanLoop()
+{
+    if (m_scanModel == nullptr)
+        return;
+
+    uint32_t l_start = millis();
+    char l_buffer[SI_EST_MAX_LINE_LEN];
+
+    while (millis() - l_start < SI_EST_SCAN_SLICE_MS)
+    {
+        if (!m_scanFile.available())
+        {
+            m_scanMs += millis() - l_start;
+            endScan();
+            return;
+        }
+
+        uint16_t l_len = m_scanFile.readBytesUntil('\n', l_buffer, SI_EST_MAX_LINE_LEN - 1);
+        if (l_len > 0 && l_buffer[l_len - 1] == 0x0D)
+            l_len--;
+        l_buffer[l_len] = 0;
+        //Comments and blank lines are not streamed
+        if (l_buffer[0] == ';' || l_buffer[0] == 0)
+            continue;
+        m_scanLines++;
+        m_scanModel->addLine(l_buffer);
+
+        //Lines before start are already done
+        if (!m_startReached)
+        {
+            if (m_scanFile.position() <= m_scanStartOffset)
+                lineAcked(l_buffer, m_scanFile.position());
+            if (m_scanFile.position() >= m_scanStartOffset)
+            {
+                //Stream can start, measure from now
+                m_startReached = true;
+                m_baseTime = m_model.getTime();
+                m_baseBytes = m_ackedBytes;
+                m_baseLines = m_ackedLines;
+                m_startT = millis();
+                m_runningMs = 0;
+            }
+        }
+    }
+    m_scanMs += millis() - l_start;
+}
+
+void SIJobEstimator::endScan()
+{
+    m_scanFile.close();
+    m_totalTime = m_scanModel->getTime();
+    m_totalLines = m_scanLines;
+    delete m_scanModel;
+    m_scanModel = nullptr;
+
+    if (!m_startReached)
+    {
+        //Start offset at end of file
+        m_startReached = true;
+        m_baseTime = m_model.getTime();
+        m_baseBytes = m_ackedBytes;
+        m_baseLines = m_ackedLines;
+        m_startT = millis();
+        m_runningMs = 0;
+    }
+
+    SIMQTT.debug(TAG, String("Job scanned in ") + m_scanMs + "ms: " + m_totalLines + " lines, " + m_totalTime + "s modeled");
+}
+
+void SIJobEstimator::lineAcked(const char *line, uint32_t fileOffset, bool canSync)
+{
+    m_ackedLines++;
+    m_ackedBytes = fileOffset;
+
+    //Save known position
+    if (m_model.addLine(line) && canSync)
+    {
+        m_syncPoint.fileSize = m_totalBytes;
+        m_syncPoint.fileOffset = fileOffset;
+        m_syncPoint.lines = m_ackedLines;
+        m_model.getPosition(m_syncPoint.position);
+        m_syncPoint.homedCarousel = m_model.isCarouselHomed();
+        m_syncPoint.sequence++;
+    }
+}
+
+bool SIJobEstimator::getSyncPoint(SISyncPoint &syncPoint)
+{
+    syncPoint = m_syncPoint;
+    return m_syncPoint.sequence > 0;
+}
+
+void SIJobEstimator::setPause(bool state)
+{
+    if (state == m_isPaused)
+        return;
+
+    if (state)
+        m_runningMs += millis() - m_startT;
+    else
+        m_startT = millis();
+    m_isPaused = state;
+}
+
+SIJobProgress SIJobEstimator::getProgress()
+{
+    SIJobProgress l_progress;
+
+    uint32_t l_elapsedMs = m_runningMs;
+    if (!m_isPaused)
+        l_elapsedMs += millis() - m_startT;
+    const float l_elapsedS = l_elapsedMs / 1000.0;
+
+    l_progress.ackedLines = m_ackedLines;
+    l_progress.totalLines = m_totalLines;
+    l_progress.percent = m_totalBytes > 0 ? min((uint32_t)100, (uint32_t)((uint64_t)m_ackedBytes * 100 / m_totalBytes)) : 0;
+    l_progress.linesPerS = l_elapsedS > 0 ? (float)(m_ackedLines - m_baseLines) / l_elapsedS : 0;
+    l_progress.bytesPerS = l_elapsedS > 0 ? (float)(m_ackedBytes - m_baseBytes) / l_elapsedS : 0;
+
+    if (m_totalLines == 0)
+    {
+        l_progress.remainingS = -1;
+        return l_progress;
+    }
+
+    //Acked lines are still in SAMD planner buffer: remaining time is slightly underestimated while streaming
+    const float l_modelTime = m_model.getTime();
+    const float l_remainingModel = max((float)0, m_totalTime - l_modelTime);
+    const float l_doneTime = l_modelTime - m_baseTime; //Modeled time of lines run in this stream
+
+    //Blend model with measured speed ratio, trusting measure more as job proceeds
+    float l_ratio = 1.0;
+    if (l_doneTime > 0 && l_elapsedS > 0)
+    {
+        const float l_weight = l_doneTime / (l_doneTime + SI_EST_SETTLE_TIME_S);
+        l_ratio = (1.0 - l_weight) + l_weight * (l_elapsedS / l_doneTime);
+    }
+    l_progress.remainingS = (int32_t)(l_remainingModel * l_ratio);
+
+    return l_progress;
+}
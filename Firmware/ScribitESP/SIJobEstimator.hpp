@@ -0,0 +1,253 @@
+#pragma once
+
+#include <Arduino.h>
+#include "FS.h"
+#include "SIConfig.hpp"
+
+#define SI_EST_AXES 3 //X (L string), Y (R string) and Z (carousel)
+
+/**
+ * @brief Job progress snapshot sent with printing/erasing status
+ */
+struct SIJobProgress
+{
+    uint8_t percent;     //Acknowledged bytes over file size (0-100)
+    uint32_t ackedLines; //Lines acknowledged by SAMD21
+    uint32_t totalLines; //Lines to be streamed (comments excluded)
+    int32_t remainingS;  //Estimated remaining time in seconds, -1 if unknown
+    float linesPerS;     //Measured line throughput
+    float bytesPerS;     //Measured byte throughput
+};
+
+/**
+ * @brief Last acknowledged line after which SAMD21 planner was empty (Known machine position)
+ */
+struct SISyncPoint
+{
+    uint32_t fileSize;           //Size of the streamed file
+    uint32_t fileOffset;         //File offset after the line
+    uint32_t lines;              //File lines acknowledged up to the line
+    float position[SI_EST_AXES]; //L, R and carousel position
+    bool homedCarousel;          //True if job already homed carousel (G77)
+    uint32_t sequence;           //Incremented at each new sync point, 0 if none yet
+};
+
+/**
+ * @brief Lightweight replica of the MK4duo planner used to estimate motion time
+ *
+ * Moves are planned on a short look-ahead window using the same rules of Planner::fill_block():
+ * per axis feedrate and acceleration limits, travel acceleration, classic jerk (Junction deviation if
+ * SI_EST_JUNCTION_DEVIATION is defined, as MK4duo JUNCTION_DEVIATION) and MIN_STEPS_PER_SEGMENT merging.
+ * Commands that make MK4duo synchronize (G4, M400, ...) empty the window.
+ */
+class SIMotionModel
+{
+    struct Block
+    {
+        float millimeters;      //Length of the move
+        float acceleration;     //Limited acceleration mm/s^2
+        float nominalSpeedSqr;  //Limited feedrate (mm/s)^2
+        float maxEntrySpeedSqr; //Junction limit (mm/s)^2
+        float entrySpeedSqr;    //Planned entry speed (mm/s)^2
+    };
+
+    Block m_blocks[SI_EST_LOOKAHEAD_BLOCKS];
+    uint8_t m_tail;  //Index of the oldest block in window
+    uint8_t m_count; //Number of blocks in window
+
+    float m_position[SI_EST_AXES];   //Position of last accepted move
+#ifdef SI_EST_JUNCTION_DEVIATION
+    float m_prevUnitVec[SI_EST_AXES]; //Unit vector of last accepted move
+#else
+    float m_prevSpeed[SI_EST_AXES];   //Axis speeds of last accepted move mm/s
+    float m_prevSafeSpeed;            //Safe speed of last accepted move mm/s
+#endif
+    float m_prevNominalSpeedSqr;      //Nominal speed of last accepted move, 0 after a sync
+    float m_time;                     //Seconds of retired blocks and dwells
+
+    //Motion settings (M92/M201/M203/M204/M205 and G1 F)
+    float m_stepsPerMm[SI_EST_AXES];
+    float m_maxFeedrate[SI_EST_AXES];
+    float m_maxAcceleration[SI_EST_AXES];
+    float m_travelAcceleration;
+#ifdef SI_EST_JUNCTION_DEVIATION
+    float m_junctionDeviation;
+#else
+    float m_maxJerk[SI_EST_AXES];
+#endif
+    float m_feedrate;
+    bool m_relative;
+    bool m_carouselHomed;
+
+    Block &blockAt(uint8_t index) { return m_blocks[(m_tail + index) % SI_EST_LOOKAHEAD_BLOCKS]; }
+
+    /**
+     * @brief Add a linear move to the window
+     *
+     * @param target[in] Target position, axes not present in the line keep current position
+     */
+    void addMove(const float target[SI_EST_AXES]);
+
+    /**
+     * @brief Runs the reverse and forward passes over the blocks in the window
+     */
+    void plan();
+
+    /**
+     * @brief Removes the oldest block from the window adding its time
+     */
+    void retire();
+
+    /**
+     * @brief Time needed to run a trapezoid
+     *
+     * @param block[in] The block
+     * @param exitSpeedSqr[in] Exit speed (mm/s)^2
+     *
+     * @return seconds
+     */
+    static float trapezoidTime(const Block &block, float exitSpeedSqr);
+
+public:
+    SIMotionModel() { reset(); }
+
+    /**
+     * @brief Restores MK4duo default settings and clears estimated time
+     */
+    void reset();
+
+    /**
+     * @brief Parses a GCODE line and adds it to the model
+     *
+     * @param line[in] GCODE line, optionally with line number and checksum (N12 G1 X1*34)
+     *
+     * @return true if MK4duo synchronizes on this line (Planner empty when acknowledged)
+     */
+    bool addLine(const char *line);
+
+    /**
+     * @brief Plans all blocks as if the SAMD21 synchronized (Exit speed 0)
+     */
+    void flush();
+
+    /**
+     * @brief Get modeled time including the blocks still in window
+     *
+     * @return seconds
+     */
+    float getTime();
+
+    /**
+     * @brief Get position after last accepted move
+     *
+     * @param position[out] L, R and carousel position
+     */
+    void getPosition(float position[SI_EST_AXES]);
+    bool isCarouselHomed() { return m_carouselHomed; }
+};
+
+/**
+ * @brief Tracks streamed job progress and estimates remaining time
+ *
+ * The whole file is modeled a slice at a time while the stream runs, then acknowledged lines are fed
+ * to a second model. Remaining time is the modeled remaining motion corrected by the ratio between
+ * measured and modeled time, weighted more as the job proceeds. Time is measured per streamed file,
+ * pauses excluded.
+ */
+class SIJobEstimator
+{
+    SIMotionModel m_model; //Model of acknowledged lines
+
+    uint32_t m_totalBytes;
+    uint32_t m_totalLines;
+    float m_totalTime; //Modeled time of the whole file (s), 0 until scanned
+
+    //File scan
+    File m_scanFile;
+    SIMotionModel *m_scanModel; //Model of the whole file, nullptr when not scanning
+    uint32_t m_scanStartOffset; //Lines before are done (Resume)
+    uint32_t m_scanLines;       //Lines scanned so far
+    uint32_t m_scanMs;          //Time spent scanning
+    bool m_startReached;        //Lines before m_scanStartOffset are all scanned
+
+    /**
+     * @brief Stop scanning, totals become valid
+     */
+    void endScan();
+
+    uint32_t m_ackedBytes;
+    uint32_t m_ackedLines;
+
+    //Values already done when stream started (Resume)
+    float m_baseTime;
+    uint32_t m_baseBytes;
+    uint32_t m_baseLines;
+
+    SISyncPoint m_syncPoint;
+
+    uint32_t m_startT;    //Stream start time (Or restart from last pause)
+    uint32_t m_runningMs; //Saved running time
+    bool m_isPaused;
+
+public:
+    SIJobEstimator() : m_scanModel(nullptr) { reset(); }
+
+    /**
+     * @brief Forget current job
+     */
+    void reset();
+
+    /**
+     * @brief Starts reading a local file to evaluate job totals, scanLoop() reads it
+     *
+     * @param fileName[in] Path to GCODE file in SPIFFS
+     * @param startOffset[in] Offset where stream starts, previous lines are considered done
+     *
+     * @return true scan started, false if cannot open file
+     */
+    bool startScan(const String &fileName, uint32_t startOffset = 0);
+
+    /**
+     * @brief Reads the file for SI_EST_SCAN_SLICE_MS at most, call it from the stream loop
+     */
+    void scanLoop();
+
+    /**
+     * @brief Lines before the start offset are done, acknowledged lines can be fed
+     *
+     * @return true if file lines can be streamed
+     */
+    bool isStartReached() { return m_startReached; }
+
+    /**
+     * @brief Signals a file line has been acknowledged by SAMD21
+     *
+     * @param line[in] The line as read from file
+     * @param fileOffset[in] Offset in file after this line
+     * @param canSync[in] All lines sent so far are accepted, a sync point can be saved
+     */
+    void lineAcked(const char *line, uint32_t fileOffset, bool canSync = true);
+
+    /**
+     * @brief Get last known machine position in file
+     *
+     * @param syncPoint[out] last sync point
+     *
+     * @return true if a sync point has been reached in current stream
+     */
+    bool getSyncPoint(SISyncPoint &syncPoint);
+
+    /**
+     * @brief Stops or restarts running time measure
+     *
+     * @param state[in] true if stream paused
+     */
+    void setPause(bool state);
+
+    /**
+     * @brief Get job progress
+     *
+     * @return progress snapshot
+     */
+    SIJobProgress getProgress();
+};
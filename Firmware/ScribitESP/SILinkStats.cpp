@@ -0,0 +1,70 @@
+#include "SILinkStats.hpp"
+
+void SILinkStats::reset()
+{
+    m_startT = millis();
+    m_lastUpdateT = m_startT;
+    m_lines = 0;
+    m_bytes = 0;
+    m_acks = 0;
+    m_rttMaxMs = 0;
+    m_rttSumMs = 0;
+    m_sendT = m_startT;
+    m_pendingCause = SI_RESEND_OTHER;
+    m_noLineMs = 0;
+
+    for (uint8_t i = 0; i < SI_LINK_RTT_BUCKETS; i++)
+        m_rttHistogram[i] = 0;
+    for (uint8_t i = 0; i < SI_RESEND_CAUSES; i++)
+        m_resends[i] = 0;
+    for (uint8_t i = 0; i < SI_LINK_TIMES; i++)
+        m_timeMs[i] = 0;
+}
+
+void SILinkStats::update(bool inFlight, SILinkTime state)
+{
+    uint32_t l_now = millis();
+    uint32_t l_dt = l_now - m_lastUpdateT;
+    m_lastUpdateT = l_now;
+
+    m_timeMs[state] += l_dt;
+    if (!inFlight)
+        m_noLineMs += l_dt;
+}
+
+void SILinkStats::lineSent(uint16_t bytes)
+{
+    m_lines++;
+    m_bytes += bytes;
+    m_sendT = millis();
+}
+
+void SILinkStats::lineAcked()
+{
+    uint32_t l_rtt = millis() - m_sendT;
+
+    m_acks++;
+    m_rttSumMs += l_rtt;
+    if (l_rtt > m_rttMaxMs)
+        m_rttMaxMs = l_rtt;
+
+    //Log2 bucket
+    uint8_t l_bucket = (l_rtt == 0) ? 0 : 32 - __builtin_clz(l_rtt);
+    if (l_bucket >= SI_LINK_RTT_BUCKETS)
+        l_bucket = SI_LINK_RTT_BUCKETS - 1;
+    m_rttHistogram[l_bucket]++;
+}
+
+void SILinkStats::resend()
+{
+    m_resends[m_pendingCause]++;
+    m_pendingCause = SI_RESEND_OTHER;
+}
+
+uint32_t SILinkStats::getTotalResends()
+{
+    uint32_t l_total = 0;
+    for (uint8_t i = 0; i < SI_RESEND_CAUSES; i++)
+        l_total += m_resends[i];
+    return l_total;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <Arduino.h>
+
+#define SI_LINK_RTT_BUCKETS 12 //Bucket i counts RTT in [2^(i-1), 2^i) ms, last one everything above
+
+enum SIResendCause
+{
+    SI_RESEND_CHECKSUM = 0,    //SAMD21 reported checksum mismatch or missing
+    SI_RESEND_LINE_NUMBER = 1, //SAMD21 reported unexpected line number
+    SI_RESEND_TIMEOUT = 2,     //No ACK within timeout
+    SI_RESEND_OTHER = 3,       //Resend without reported error
+    SI_RESEND_CAUSES
+};
+
+enum SILinkTime
+{
+    SI_LINK_TIME_WORKING = 0, //Last reply was ok
+    SI_LINK_TIME_BUSY = 1,    //SAMD21 reported busy
+    SI_LINK_TIME_HEATING = 2, //SAMD21 reported busy heating
+    SI_LINK_TIME_WAIT = 3,    //SAMD21 reported wait (Command queue empty)
+    SI_LINK_TIMES
+};
+
+/**
+ * @brief Always-on counters of ESP32-SAMD21 serial stream
+ *
+ * Counters are updated from SISerialManager with a few integer operations per line and reset at every stream start.
+ */
+class SILinkStats
+{
+    uint32_t m_startT;      //Stream start time
+    uint32_t m_lastUpdateT; //Last time accounting update
+
+    uint32_t m_lines; //Lines written
+    uint32_t m_bytes; //Bytes written (Line terminator included)
+    uint32_t m_acks;  //Lines acknowledged
+
+    uint32_t m_rttHistogram[SI_LINK_RTT_BUCKETS];
+    uint32_t m_rttMaxMs;
+    uint32_t m_rttSumMs;
+    uint32_t m_sendT; //Time last line was written
+
+    uint32_t m_resends[SI_RESEND_CAUSES];
+    SIResendCause m_pendingCause; //Cause of error reported before next Resend
+
+    uint32_t m_timeMs[SI_LINK_TIMES]; //Time spent in each SAMD21 reported state
+    uint32_t m_noLineMs;              //Time with no line in flight
+
+public:
+    SILinkStats() { reset(); }
+
+    /**
+     * @brief Resets all counters
+     */
+    void reset();
+
+    /**
+     * @brief Accounts time elapsed since last update, to be called every serial manager loop
+     *
+     * @param inFlight[in] True if a line is waiting for ACK
+     * @param state[in] Last state reported by SAMD21
+     */
+    void update(bool inFlight, SILinkTime state);
+
+    /**
+     * @brief Signals a line has been written
+     *
+     * @param bytes[in] written bytes
+     */
+    void lineSent(uint16_t bytes);
+
+    /**
+     * @brief Signals ACK of last written line
+     */
+    void lineAcked();
+
+    /**
+     * @brief Signals the error reported by SAMD21 that will cause next resend
+     *
+     * @param cause[in] error cause
+     */
+    void setResendCause(SIResendCause cause) { m_pendingCause = cause; }
+
+    /**
+     * @brief Signals a resend, counted with the last reported cause
+     */
+    void resend();
+
+    /**
+     * @brief Signals a resend due to ACK timeout
+     */
+    void timeoutResend() { m_resends[SI_RESEND_TIMEOUT]++; }
+
+    uint32_t getElapsedMs() { return millis() - m_startT; }
+    uint32_t getLines() { return m_lines; }
+    uint32_t getBytes() { return m_bytes; }
+    uint32_t getRttMaxMs() { return m_rttMaxMs; }
+    uint32_t getRttMeanMs() { return m_acks > 0 ? m_rttSumMs / m_acks : 0; }
+    uint32_t getRttBucket(uint8_t bucket) { return m_rttHistogram[bucket]; }
+    uint32_t getResends(SIResendCause cause) { return m_resends[cause]; }
+    uint32_t getTotalResends();
+    uint32_t getTimeMs(SILinkTime state) { return m_timeMs[state]; }
+    uint32_t getNoLineMs() { return m_noLineMs; }
+};
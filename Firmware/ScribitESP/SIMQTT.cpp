@@ -123,13 +123,54 @@ void SIMQTTClass::debug(String tag, String message, int level)
     }
 }
 
-void SIMQTTClass::statusPrintErase(uint32_t elapsedTimeSec, bool isErase, char isPaused)
+void SIMQTTClass::statusPrintErase(uint32_t elapsedTimeSec, bool isErase, char isPaused, const SIJobProgress &progress, uint8_t queuedJobs, uint8_t readyJobs)
 {
     //Create payload
-    String payload = String("{\"ET\":") + elapsedTimeSec + ", \"Paused\":\"" + (isPaused) + "\"}";
+    String payload = String("{\"ET\":") + elapsedTimeSec + ", \"Paused\":\"" + (isPaused) + "\"" +
+                     ", \"Progress\":" + progress.percent +
+                     ", \"RT\":" + progress.remainingS +
+                     ", \"Lines\":" + progress.ackedLines +
+                     ", \"TotLines\":" + progress.totalLines +
+                     ", \"LPS\":" + String(progress.linesPerS, 1) +
+                     ", \"BPS\":" + String(progress.bytesPerS, 0) +
+                     ", \"Queue\":" + queuedJobs +
+                     ", \"QReady\":" + readyJobs + "}";
     publish((isErase) ? "erasing" : "printing", payload);
 }
 
+void SIMQTTClass::linkMetrics(SILinkStats &stats)
+{
+    uint32_t elapsedMs = stats.getElapsedMs();
+    float elapsedS = (elapsedMs > 0) ? elapsedMs / 1000.0 : 1;
+
+    //RTT histogram
+    String rtt = "[";
+    for (uint8_t i = 0; i < SI_LINK_RTT_BUCKETS; i++)
+    {
+        rtt += stats.getRttBucket(i);
+        if (i < SI_LINK_RTT_BUCKETS - 1)
+            rtt += ",";
+    }
+    rtt += "]";
+
+    String payload = String("{\"T\":") + elapsedMs +
+                     ", \"Lines\":" + stats.getLines() +
+                     ", \"LPS\":" + String(stats.getLines() / elapsedS, 1) +
+                     ", \"BPS\":" + String(stats.getBytes() / elapsedS, 0) +
+                     ", \"RTTMean\":" + stats.getRttMeanMs() +
+                     ", \"RTTMax\":" + stats.getRttMaxMs() +
+                     ", \"RTT\":" + rtt +
+                     ", \"Busy\":" + stats.getTimeMs(SI_LINK_TIME_BUSY) +
+                     ", \"Heating\":" + stats.getTimeMs(SI_LINK_TIME_HEATING) +
+                     ", \"Wait\":" + stats.getTimeMs(SI_LINK_TIME_WAIT) +
+                     ", \"Idle\":" + String((float)stats.getNoLineMs() / (elapsedMs > 0 ? elapsedMs : 1), 3) +
+                     ", \"Resend\":{\"CS\":" + stats.getResends(SI_RESEND_CHECKSUM) +
+                     ", \"LN\":" + stats.getResends(SI_RESEND_LINE_NUMBER) +
+                     ", \"TO\":" + stats.getResends(SI_RESEND_TIMEOUT) +
+                     ", \"Other\":" + stats.getResends(SI_RESEND_OTHER) + "}}";
+    publish("metrics", payload);
+}
+
 void SIMQTTClass::statusIdle(int8_t RSSI, float temp)
 {
     //Publish message
@@ -296,6 +337,12 @@ void SIMQTTClass::messageReceived(String &topic, String &payload)
         SIMQTT.debug(TAG, "Received calibration: " + payload);
         msg.type = SIMQTTMessage::CALIBRATION;
     }
+    //Resume----------------------------------------------------------------
+    else if (topic.endsWith(SI_MQTT_TOPIC_IN_RESUME))
+    {
+        SIMQTT.debug(TAG, "Received resume: " + payload);
+        msg.type = SIMQTTMessage::RESUME;
+    }
     //Unknown------------------------------------------------------------
     else
     {
@@ -10,6 +10,8 @@
 #include "SIConfig.hpp"
 #include "AxxxLib/CircBuf.h"
 #include "SIMQTTMessage.hpp"
+#include "SIJobEstimator.hpp"
+#include "SILinkStats.hpp"
 
 #define SI_MQTT_TOPIC_IN_PRINT "print"
 #define SI_MQTT_TOPIC_IN_STATUS "status"
@@ -21,6 +23,7 @@
 #define SI_MQTT_TOPIC_IN_SETCONFIG "wifiConfig"
 #define SI_MQTT_TOPIC_IN_MANUALMOVE "manualMove"
 #define SI_MQTT_TOPIC_IN_CALIBRATION "calibration"
+#define SI_MQTT_TOPIC_IN_RESUME "resume"
 
 #define SI_MQTT_RESET_WIFI_TIMEOUT_MS 30000
 #define SI_MQTT_MAX_SAVED_MESSAGES 3
@@ -48,7 +51,8 @@ enum SIMQTT_ERRORS
   SIMQTT_ERROR_PIN26 = 0x26,
   SIMQTT_ERROR_MESSAGE_BUFFER_FULL = 0x13,
   SIMQTT_ERROR_CANNOT_CALIBRATE = 0x14,
-  SIMQTT_ERROR_BAD_CALIBRATION_PAYLOAD = 0x15
+  SIMQTT_ERROR_BAD_CALIBRATION_PAYLOAD = 0x15,
+  SIMQTT_ERROR_QUEUE_FULL = 0x16
 
 };
 
@@ -140,8 +144,25 @@ public:
    * @param level[in] log level
    */
   void debug(String tag, String message, int level = 0);
-  void statusPrintErase(uint32_t elapsedTimeSec, bool isErase, char isPaused);
+  /**
+   * @brief Sends printing/erasing status
+   * 
+   * @param elapsedTimeSec[in] job running time
+   * @param isErase[in] true if erasing
+   * @param isPaused[in] pause state
+   * @param progress[in] progress of current streamed file
+   * @param queuedJobs[in] jobs waiting in queue
+   * @param readyJobs[in] queued jobs already downloaded and verified
+   */
+  void statusPrintErase(uint32_t elapsedTimeSec, bool isErase, char isPaused, const SIJobProgress &progress, uint8_t queuedJobs, uint8_t readyJobs);
   void statusIdle(int8_t RSSI, float temp);
+
+  /**
+   * @brief Sends serial link metrics of last stream on metrics topic
+   * 
+   * @param stats[in] link counters
+   */
+  void linkMetrics(SILinkStats &stats);
   void statusManual();
   
   /**
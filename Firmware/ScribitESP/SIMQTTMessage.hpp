@@ -18,7 +18,8 @@ struct SIMQTTMessage
         SETCONFIG,
         MANUALMOVE,
         GCODE,
-        CALIBRATION
+        CALIBRATION,
+        RESUME
     };
     //Payload content
     char payload[SIMQTTMESSAGE_MAX_LEN];
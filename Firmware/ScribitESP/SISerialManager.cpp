@@ -4,6 +4,9 @@
 
 #define SI_SM_MAX_REPLY_LEN 128
 #define SI_SM_ACK_TIMEOUT_MS 5000
+#define SI_LINK_TEST_PREFIX "LINKTEST:"
+#define SI_LINK_TEST_LEN 64 //Pattern characters of each test line
+#define SI_LINK_RATES_COUNT (sizeof(SI_LINK_BAUDRATES) / sizeof(SI_LINK_BAUDRATES[0]))
 
 #define TAG "SerialManager"
 
@@ -14,7 +17,20 @@ SISerialManager::SISerialManager() :
     m_newIMUDataAvailable(false), 
     m_startingPositionLine(""),
     m_smartCylinder(true),
-    m_penSensitivity(true)    
+    m_penSensitivity(true),
+    m_sentNumber(-1),
+    m_inFlightFromFile(false),
+    m_inFlightNumber(-1),
+    m_inFlightOffset(0),
+    m_lastCreditedNumber(-1),
+    m_startOffset(0),
+    m_preambleLines(0),
+    m_linkRateIndex(0),
+    m_fallbackLines(0),
+    m_fallbackResends(0),
+    m_fallbackPending(false),
+    m_lastReplyT(0),
+    m_garbageReplies(0)
 {};
 
 int SISerialManager::begin()
@@ -39,7 +55,7 @@ int SISerialManager::begin()
     return 0;
 }
 
-bool SISerialManager::streamLocalFile(String fileName)
+bool SISerialManager::streamLocalFile(String fileName, uint32_t startOffset, String preamble)
 {
     if (!m_streamEnded)
     {
@@ -47,19 +63,30 @@ bool SISerialManager::streamLocalFile(String fileName)
         return false;
     }
 
+    //Drop link rate before numbering restarts if last job asked for it
+    if (!m_waitingForAck)
+        applyLinkFallback();
+
     //Empty sent buffer------------
     String s;
     while (!sentLines.empty())
     {
         sentLines.remove(&s);
     }
-#ifdef SI_DEBUG_BUILD
-    //Reset resends number
-    md_resends = 0;
-#endif
+    //Reset link counters
+    m_linkStats.reset();
+    m_fallbackLines = 0;
+    m_fallbackResends = 0;
+    m_garbageReplies = 0;
+    m_lastReplyT = millis();
     //Reset pause flag
     m_isPaused = false;
 
+    //Evaluate job totals for progress and remaining time (Read by loop)
+    m_jobEstimator.startScan(fileName, startOffset);
+    m_inFlightFromFile = false;
+    m_lastCreditedNumber = -1;
+
     //Open file
     m_inFile = SPIFFS.open(fileName, FILE_READ);
     if (!m_inFile)
@@ -67,6 +94,28 @@ bool SISerialManager::streamLocalFile(String fileName)
         SIMQTT.error(String("Unable to open gcode ") + fileName + "file in read mode", SIMQTT_ERROR_DOWNLOAD_FILE_IO_ERROR);
         return false;
     }
+    //Resume from offset
+    if (startOffset > 0 && !m_inFile.seek(startOffset))
+    {
+        SIMQTT.error(String("Unable to seek gcode ") + fileName + " to " + startOffset, SIMQTT_ERROR_DOWNLOAD_FILE_IO_ERROR);
+        m_inFile.close();
+        return false;
+    }
+    m_fileName = fileName;
+    m_startOffset = startOffset;
+
+    //Lines sent before file ones
+    m_preamble = preamble;
+    m_preambleLines = 0;
+    if (m_preamble.length() > 0)
+    {
+        m_preambleLines = 1;
+        for (uint16_t i = 0; i < m_preamble.length(); i++)
+        {
+            if (m_preamble[i] == '\n')
+                m_preambleLines++;
+        }
+    }
 
     //Reset line number
     addLineToStream("N-1 M110*15");
@@ -86,12 +135,17 @@ bool SISerialManager::streamLocalFile(String fileName)
     //Reset needpause flag
     m_needsPause = false;
 #endif
+
+    return true;
 }
 
 void SISerialManager::writeLine()
 {
     //Write line to serial
     Serial.println(currLine);
+    m_linkStats.lineSent(strlen(currLine) + 2); //println adds CR LF
+    //Save number to match ack (Raw extra lines and N-1 are not numbered)
+    m_sentNumber = (currLine[0] == 'N') ? atol(currLine + 1) : -1;
     //Signal waiting for ack
     m_waitingForAck = true;
     //Save the time
@@ -106,6 +160,7 @@ void SISerialManager::writeLine()
 bool SISerialManager::loadNextLine()
 {
     char buffer[SI_SM_MAX_REPLY_LEN];
+
     //Check for resend-----------------------
     if (m_resend > 0)
     {
@@ -144,6 +199,23 @@ bool SISerialManager::loadNextLine()
             return false;
         }
 
+        //Send resume preamble before file lines
+        if (m_preamble.length() > 0)
+        {
+            int l_end = m_preamble.indexOf('\n');
+            String l_line = (l_end < 0) ? m_preamble : m_preamble.substring(0, l_end);
+            m_preamble = (l_end < 0) ? String("") : m_preamble.substring(l_end + 1);
+
+            encapsulate(l_line.c_str());
+            return true;
+        }
+
+        //Wait for estimator to model lines before resume offset
+        if (!m_jobEstimator.isStartReached())
+        {
+            return false;
+        }
+
 //If calibration is not in debug mode send starting position command
 #ifndef SI_CALIBRATION_DEBUG
         if (m_startingPositionLine.length() > 0)
@@ -164,14 +236,14 @@ bool SISerialManager::loadNextLine()
                 m_streamEnded = true;
                 m_inFile.close(); //Close file
 #ifdef SI_DEBUG_BUILD
-                SIMQTT.debug(TAG, String("Print ended: ") + md_resends + " resends");
+                SIMQTT.debug(TAG, String("Print ended: ") + m_linkStats.getTotalResends() + " resends");
 #endif
                 return false;
             }
             uint16_t len = m_inFile.readBytesUntil('\n', buffer, SI_SM_MAX_REPLY_LEN);
 
             //Add string terminator
-            if (buffer[len - 1] == 0x0D) //Remove 0x0D if present
+            if (len > 0 && buffer[len - 1] == 0x0D) //Remove 0x0D if present
             {
                 buffer[len - 1] = 0;
             }
@@ -179,12 +251,18 @@ bool SISerialManager::loadNextLine()
             {
                 buffer[len] = 0;
             }
-        } while (buffer[0] == ';'); // read until first line is not comment
+        } while (buffer[0] == ';' || buffer[0] == 0); // read until first line is not comment or blank
 #ifdef PAUSE_AFTER_Z
         if (strstr(buffer, "Z"))
             m_needsPause = true;
 #endif
 
+        //Save line and position for job progress, credited when its number is acknowledged
+        m_inFlightFromFile = true;
+        m_inFlightNumber = m_lineNumber;
+        m_inFlightOffset = m_inFile.position();
+        strcpy(m_inFlightLine, buffer);
+
         //Encapsulate and save buffer
         encapsulate(buffer);
     }
@@ -194,9 +272,33 @@ bool SISerialManager::loadNextLine()
 
 SIMKOperation SISerialManager::loop()
 {
+    //Account link time since last loop
+    SILinkTime l_linkTime = SI_LINK_TIME_WORKING;
+    switch (m_mkStatus)
+    {
+    case SIMK_IDLE:
+        l_linkTime = SI_LINK_TIME_WAIT;
+        break;
+    case SIMK_BUSY:
+        l_linkTime = SI_LINK_TIME_BUSY;
+        break;
+    case SIMK_HEATING:
+        l_linkTime = SI_LINK_TIME_HEATING;
+        break;
+    default:
+        break;
+    }
+    m_linkStats.update(m_waitingForAck, l_linkTime);
+
+    //Go on with job scan
+    m_jobEstimator.scanLoop();
+
     //Check if received ACK
     if (!m_waitingForAck)
     {
+        //Count resends, link rate drops between jobs (Nothing in flight now)
+        checkLinkFallback();
+
         //Load next line if present
         if (loadNextLine())
         {
@@ -227,9 +329,36 @@ SIMKOperation SISerialManager::loop()
 #ifdef SI_ECHO_GCODE
             SIMQTT.debug(TAG, String("R: \"") + samdSerialBuffer + "\"", 9);
 #endif
+            //Unprintable bytes come from a SAMD at another rate
+            bool l_garbage = false;
+            for (int i = 0; samdSerialBuffer[i] != 0 && !l_garbage; i++)
+                l_garbage = (uint8_t)samdSerialBuffer[i] < 0x20 || (uint8_t)samdSerialBuffer[i] > 0x7E;
+            if (l_garbage)
+            {
+                m_garbageReplies++;
+                continue;
+            }
+            m_garbageReplies = 0;
+            m_lastReplyT = millis();
+
             //OK-----------------------------------------------------
             if (strstr(samdSerialBuffer, "ok") != nullptr) //Printer ready for line
             {
+                if (m_waitingForAck)
+                    m_linkStats.lineAcked();
+
+                //Update job progress with acknowledged file line (Lines read again after a rewind are already credited)
+                if (m_waitingForAck && m_inFlightFromFile && m_sentNumber == m_inFlightNumber)
+                {
+                    if (m_inFlightNumber > m_lastCreditedNumber)
+                    {
+                        //Resume point only when no resend is pending and this is the last line sent
+                        bool l_canSync = (m_resend == 0 && m_inFlightNumber == (int32_t)m_lineNumber - 1);
+                        m_jobEstimator.lineAcked(m_inFlightLine, m_inFlightOffset, l_canSync);
+                        m_lastCreditedNumber = m_inFlightNumber;
+                    }
+                    m_inFlightFromFile = false;
+                }
 
                 m_waitingForAck = false;   //Reset ACK
                 m_mkStatus = SIMK_WORKING; //Set MK4Duo as working
@@ -245,9 +374,10 @@ SIMKOperation SISerialManager::loop()
             //RESEND-------------------------------------------------
             else if (strstr(samdSerialBuffer, "Resend") != nullptr) //Printer requested resend
             {
-#ifdef SI_DEBUG_BUILD
-                md_resends++; //Incremend resends number
-#endif
+                //Count resend with cause reported before
+                m_linkStats.resend();
+                //Following ok is for the rejected line, do not credit it
+                m_sentNumber = -1;
 
                 //Parse line number
                 char *p = strstr(samdSerialBuffer, ":");
@@ -281,6 +411,16 @@ SIMKOperation SISerialManager::loop()
                 {
                     SIMQTT.error(samdSerialBuffer, SIMQTT_ERROR_HARDWARE_FAIL);
                 }
+                else if (strstr(samdSerialBuffer, "checksum") != nullptr || strstr(samdSerialBuffer, "No Checksum") != nullptr)
+                {
+                    //Resend will follow
+                    m_linkStats.setResendCause(SI_RESEND_CHECKSUM);
+                }
+                else if (strstr(samdSerialBuffer, "Line Number is not") != nullptr)
+                {
+                    //Resend will follow
+                    m_linkStats.setResendCause(SI_RESEND_LINE_NUMBER);
+                }
                 else
                     SIMQTT.debug(TAG, String("Printer reported unhandled error: ") + samdSerialBuffer);
             }
@@ -294,8 +434,11 @@ SIMKOperation SISerialManager::loop()
                 {
                     //If stream is not ended
                     if (!m_streamEnded)
+                    {
                         //Resend last line
                         restartFromLine(m_lineNumber - 1);
+                        m_linkStats.timeoutResend();
+                    }
                     //Clear wait for ack
                     m_waitingForAck = false;
                     SIMQTT.debug(TAG, "Timeout waiting for ACK, resending");
@@ -320,6 +463,8 @@ SIMKOperation SISerialManager::loop()
         }
     }
 
+    checkLinkLost();
+
     //Return mk4duo status
     return m_mkStatus;
 }
@@ -357,17 +502,23 @@ bool SISerialManager::restartFromLine(int64_t line)
     {
         SIMQTT.debug(TAG, String("Requested too many lines ago: ") + linesToResend);
 
-        //Go back to file start
+        //Go back to stream start
         m_inFile.close();
 
-        m_inFile = SPIFFS.open(SI_TEMPORARY_GCODE_PATH, FILE_READ);
-        if (!m_inFile)
+        m_inFile = SPIFFS.open(m_fileName, FILE_READ);
+        if (!m_inFile || !m_inFile.seek(m_startOffset))
         {
-            SIMQTT.error("Unable to reopen temporary gcode file in read mode", SIMQTT_ERROR_DOWNLOAD_FILE_IO_ERROR);
+            SIMQTT.error("Unable to reopen gcode file in read mode", SIMQTT_ERROR_DOWNLOAD_FILE_IO_ERROR);
+            return false;
+        }
+        //Preamble lines are not in file
+        if (line < m_preambleLines)
+        {
+            SIMQTT.error("Unable to resume print, requested line is in resume preamble", SIMQTT_ERROR_DOWNLOAD_FILE_IO_ERROR);
             return false;
         }
 
-        for (uint32_t nLine = 0; nLine < line; nLine++)
+        for (uint32_t nLine = 0; nLine < line - m_preambleLines; nLine++)
         {
             do
             {
@@ -378,9 +529,12 @@ bool SISerialManager::restartFromLine(int64_t line)
                     SIMQTT.error("Unable to resume print, eof reached before line", SIMQTT_ERROR_DOWNLOAD_FILE_IO_ERROR);
                     return false;
                 }
-                uint16_t len = m_inFile.readBytesUntil('\n', buffer, SI_SM_MAX_REPLY_LEN);
+                uint16_t len = m_inFile.readBytesUntil('\n', buffer, SI_SM_MAX_REPLY_LEN - 1);
+                if (len > 0 && buffer[len - 1] == 0x0D)
+                    len--;
+                buffer[len] = 0;
 
-            } while (buffer[0] == ';'); // read until first line is not comment
+            } while (buffer[0] == ';' || buffer[0] == 0); // read until first line is not comment or blank
         }
 
         //Signal next line as requested
@@ -423,6 +577,8 @@ void SISerialManager::setPause(bool state)
     {
         //Set pause flag
         m_isPaused = state;
+        //Pause time is not counted in job throughput
+        m_jobEstimator.setPause(state);
         //Send pause command
         addLineToStream("G4 P1");
     }
@@ -527,3 +683,230 @@ bool SISerialManager::getIMUData(int16_t &data)
     m_newIMUDataAvailable = false;
     return true;
 }
+
+uint32_t SISerialManager::getLinkBaudrate()
+{
+    return (m_linkRateIndex == 0) ? SAMD_SERIAL_BAUDRATE : SI_LINK_BAUDRATES[m_linkRateIndex - 1];
+}
+
+void SISerialManager::resetLinkRate()
+{
+    m_linkRateIndex = 0;
+    m_fallbackPending = false;
+    Serial.flush();
+    Serial.updateBaudRate(SAMD_SERIAL_BAUDRATE);
+}
+
+uint32_t SISerialManager::negotiateLinkRate()
+{
+    //Step up until a rate fails
+    while (m_linkRateIndex < SI_LINK_RATES_COUNT && changeLinkRate(m_linkRateIndex + 1))
+        ;
+
+    SIMQTT.debug(TAG, String("Link rate: ") + getLinkBaudrate());
+    return getLinkBaudrate();
+}
+
+bool SISerialManager::readLinkLine(char *buffer, uint16_t size, uint32_t deadline)
+{
+    uint16_t l_len = 0;
+
+    while ((int32_t)(deadline - millis()) > 0)
+    {
+        if (!Serial.available())
+        {
+            delay(1);
+            continue;
+        }
+        char l_c = Serial.read();
+        if (l_c == '\n' || l_c == '\r')
+        {
+            //Skip empty lines (CR LF)
+            if (l_len == 0)
+                continue;
+            buffer[l_len] = 0;
+            return true;
+        }
+        if (l_len < size - 1)
+            buffer[l_len++] = l_c;
+    }
+    return false;
+}
+
+bool SISerialManager::changeLinkRate(uint8_t index)
+{
+    char l_reply[SI_SM_MAX_REPLY_LEN], l_test[SI_SM_MAX_REPLY_LEN];
+    uint8_t l_oldIndex = m_linkRateIndex;
+    uint32_t l_rate = (index == 0) ? SAMD_SERIAL_BAUDRATE : SI_LINK_BAUDRATES[index - 1];
+    bool l_accepted = false;
+
+    //Drop pending input
+    while (Serial.available())
+        Serial.read();
+
+    //Wait for SAMD queue to empty, so M575 runs right away
+    Serial.println("M400");
+    uint32_t l_deadline = millis() + SI_LINK_DRAIN_TIMEOUT_MS;
+    bool l_drained = false;
+    while (!l_drained && readLinkLine(l_reply, sizeof(l_reply), l_deadline))
+    {
+        if (strstr(l_reply, "ok") != nullptr)
+            l_drained = true;
+        else if (strstr(l_reply, "busy") != nullptr) //Still moving
+            l_deadline = millis() + SI_LINK_DRAIN_TIMEOUT_MS;
+    }
+    if (!l_drained)
+    {
+        SIMQTT.debug(TAG, String("SAMD not idle, link rate ") + l_rate + " not requested");
+        return false;
+    }
+
+    //Request, SAMD announces the switch at current rate
+    Serial.print("M575 B");
+    Serial.println(l_rate);
+    l_deadline = millis() + SI_LINK_TEST_TIMEOUT_MS;
+    while (!l_accepted && readLinkLine(l_reply, sizeof(l_reply), l_deadline))
+    {
+        if (strncmp(l_reply, "LINK:", 5) == 0)
+            l_accepted = true;
+        else if (strstr(l_reply, "ok") != nullptr) //Refused, command already acknowledged
+            break;
+    }
+    if (!l_accepted)
+    {
+        SIMQTT.debug(TAG, String("SAMD refused link rate ") + l_rate);
+        return false;
+    }
+
+    //Switch and check the echo of test lines
+    Serial.flush();
+    Serial.updateBaudRate(l_rate);
+    m_linkRateIndex = index;
+
+    bool l_verified = true;
+    for (uint8_t l_round = 0; l_round < SI_LINK_TEST_ROUNDS && l_verified; l_round++)
+    {
+        //Printable pattern, different at each round
+        strcpy(l_test, SI_LINK_TEST_PREFIX);
+        uint8_t l_len = strlen(l_test);
+        for (uint8_t i = 0; i < SI_LINK_TEST_LEN; i++)
+            l_test[l_len++] = '!' + (i * 7 + l_round * 13) % 94;
+        l_test[l_len] = 0;
+
+        Serial.println(l_test);
+        l_verified = readLinkLine(l_reply, sizeof(l_reply), millis() + SI_LINK_TEST_TIMEOUT_MS) &&
+                     strcmp(l_reply, l_test) == 0;
+    }
+
+    //Confirm, the ok arrives at new rate
+    if (l_verified)
+    {
+        Serial.println("LINKOK");
+        l_deadline = millis() + SI_LINK_TEST_TIMEOUT_MS;
+        l_verified = false;
+        while (!l_verified && readLinkLine(l_reply, sizeof(l_reply), l_deadline))
+            l_verified = strstr(l_reply, "ok") != nullptr;
+        if (l_verified)
+            return true;
+    }
+
+    SIMQTT.debug(TAG, String("Link test failed at ") + l_rate);
+    resyncLink(index, l_oldIndex);
+    return false;
+}
+
+bool SISerialManager::resyncLink(uint8_t index, uint8_t oldIndex)
+{
+    char l_reply[SI_SM_MAX_REPLY_LEN];
+    uint32_t l_deadline = millis() + SI_LINK_RESYNC_TIMEOUT_MS;
+
+    //SAMD goes back to old rate if it did not get the confirm, try it first
+    for (uint8_t l_try = 0; (int32_t)(l_deadline - millis()) > 0; l_try++)
+    {
+        uint8_t l_index = (l_try % 2 == 0) ? oldIndex : index;
+        m_linkRateIndex = l_index;
+        Serial.flush();
+        Serial.updateBaudRate(getLinkBaudrate());
+        while (Serial.available())
+            Serial.read();
+
+        //Any command not touching line numbers (Job may be running)
+        Serial.println("M105");
+        uint32_t l_tryDeadline = millis() + 2 * SI_LINK_TEST_TIMEOUT_MS;
+        while (readLinkLine(l_reply, sizeof(l_reply), l_tryDeadline))
+        {
+            if (strstr(l_reply, "ok") != nullptr)
+            {
+                //Drop other acks
+                delay(50);
+                while (Serial.available())
+                    Serial.read();
+                return true;
+            }
+        }
+    }
+
+    SIMQTT.error("Unable to find SAMD on serial link", SIMQTT_ERROR_CANNOT_SYNC_MK4DUO);
+    return false;
+}
+
+void SISerialManager::checkLinkFallback()
+{
+    //Between jobs nothing is numbered, rate can change
+    if (m_streamEnded)
+    {
+        applyLinkFallback();
+        return;
+    }
+
+    if (m_linkRateIndex == 0 || m_fallbackPending)
+        return;
+
+    if (m_linkStats.getLines() - m_fallbackLines < SI_LINK_FALLBACK_WINDOW)
+        return;
+
+    uint32_t l_resends = m_linkStats.getTotalResends() - m_fallbackResends;
+    m_fallbackLines = m_linkStats.getLines();
+    m_fallbackResends = m_linkStats.getTotalResends();
+
+    if (l_resends < SI_LINK_FALLBACK_RESENDS)
+        return;
+
+    SIMQTT.debug(TAG, String(l_resends) + " resends in " + SI_LINK_FALLBACK_WINDOW + " lines, dropping link rate after job");
+    m_fallbackPending = true;
+}
+
+void SISerialManager::checkLinkLost()
+{
+    //Boot rate has nothing to fall back to
+    if (m_linkRateIndex == 0)
+        return;
+
+    bool l_silent = m_waitingForAck && millis() - m_lastReplyT > SI_LINK_SILENCE_MS && millis() - m_lastSend > SI_LINK_SILENCE_MS;
+    if (!l_silent && m_garbageReplies < SI_LINK_GARBAGE_REPLIES)
+        return;
+
+    SIMQTT.debug(TAG, String(l_silent ? "SAMD silent" : "Unreadable SAMD replies") + " at " + getLinkBaudrate() + ", resyncing link");
+    m_garbageReplies = 0;
+    m_fallbackPending = false;
+
+    //Boot rate first, then the negotiated one
+    if (resyncLink(m_linkRateIndex, 0))
+    {
+        //Send again line in flight
+        if (m_waitingForAck && !m_streamEnded)
+            restartFromLine(m_lineNumber - 1);
+        m_waitingForAck = false;
+    }
+    m_lastReplyT = millis();
+}
+
+void SISerialManager::applyLinkFallback()
+{
+    if (!m_fallbackPending)
+        return;
+
+    m_fallbackPending = false;
+    if (m_linkRateIndex > 0)
+        changeLinkRate(m_linkRateIndex - 1);
+}
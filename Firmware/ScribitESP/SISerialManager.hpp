@@ -4,6 +4,8 @@
 
 #include "AxxxLib/CircBufInfinite.h"
 #include "SIConfig.hpp"
+#include "SIJobEstimator.hpp"
+#include "SILinkStats.hpp"
 
 #define SM_PRINTER_ENDLINE 0x0A
 //#define PAUSE_AFTER_Z
@@ -46,9 +48,24 @@ private:
     bool m_isIMUWorking;
     bool m_penSensitivity;
     bool m_smartCylinder;
-#ifdef SI_DEBUG_BUILD
-    uint32_t md_resends;
-#endif
+    SIJobEstimator m_jobEstimator;      //Progress and remaining time of current stream
+    int32_t m_sentNumber;               //Line number of last written line, -1 if not numbered
+    bool m_inFlightFromFile;            //True if last file line read is still to be credited
+    int32_t m_inFlightNumber;           //Line number of last file line read
+    uint32_t m_inFlightOffset;          //File offset after last file line read
+    char m_inFlightLine[SI_MAX_GCODE_LINE_LEN]; //Last file line as read from file
+    int32_t m_lastCreditedNumber;       //Last line number credited to job progress
+    String m_fileName;                  //Streamed file
+    uint32_t m_startOffset;             //File offset where stream started
+    String m_preamble;                  //Lines to send before file ones, '\n' separated
+    uint32_t m_preambleLines;           //Number of preamble lines
+    SILinkStats m_linkStats;            //Serial link counters of current stream
+    uint8_t m_linkRateIndex;            //0 SAMD_SERIAL_BAUDRATE, i SI_LINK_BAUDRATES[i-1]
+    uint32_t m_fallbackLines;           //Lines written when current fallback window started
+    uint32_t m_fallbackResends;         //Resends when current fallback window started
+    bool m_fallbackPending;             //Link rate to be dropped once current job ends
+    uint32_t m_lastReplyT;              //Last readable reply from SAMD
+    uint8_t m_garbageReplies;           //Consecutive unreadable replies (SAMD at another rate)
 #ifdef PAUSE_AFTER_Z
     bool m_needsPause;
 #endif
@@ -149,6 +166,52 @@ private:
      */
     void parseVerticalStatus(const char *samdSerialBuffer);
 
+    /**
+     * @brief Reads a line from SAMD21 without waiting serial timeout
+     * 
+     * @param buffer[out] line read, CR LF removed
+     * @param size[in] buffer size
+     * @param deadline[in] millis() after which reading gives up
+     * 
+     * @return true line read, false deadline expired
+     */
+    bool readLinkLine(char *buffer, uint16_t size, uint32_t deadline);
+
+    /**
+     * @brief Moves the link to another rate with M575 handshake, sent after an M400 ok
+     * 
+     * @param index[in] rate index (0 SAMD_SERIAL_BAUDRATE, i SI_LINK_BAUDRATES[i-1])
+     * 
+     * @return true new rate verified, false link still (Or again) at previous rate
+     */
+    bool changeLinkRate(uint8_t index);
+
+    /**
+     * @brief Finds again the SAMD21 after a failed handshake trying both rates
+     * 
+     * @param index[in] rate index tried in handshake
+     * @param oldIndex[in] rate index before handshake
+     * 
+     * @return true SAMD21 answered, m_linkRateIndex is its rate
+     */
+    bool resyncLink(uint8_t index, uint8_t oldIndex);
+
+    /**
+     * @brief During a job counts resends, if last window crosses SI_LINK_FALLBACK_RESENDS the link drops
+     * to previous rate once the job ends (M575 handshake is outside line numbering)
+     */
+    void checkLinkFallback();
+
+    /**
+     * @brief Drops link to previous rate if requested by checkLinkFallback(), nothing must be in flight
+     */
+    void applyLinkFallback();
+
+    /**
+     * @brief At a negotiated rate, finds again the SAMD if it went silent or unreadable (SAMD reset comes back at boot rate)
+     */
+    void checkLinkLost();
+
 public:
     SISerialManager();
 
@@ -163,10 +226,12 @@ public:
      * @brief Streams local saved file
      * 
      * @param fileName[in] The path to the file that needs to be streamed in SPIFFS, default path is the one where GOCDE in normally stored
+     * @param startOffset[in] File offset where stream starts (Resume)
+     * @param preamble[in] '\n' separated lines to be sent before file ones
      * 
      * @return true if stream starts correctly, false if there is a stream altready on or cannot open file in SPIFFS
      */
-    bool streamLocalFile(String fileName = SI_TEMPORARY_GCODE_PATH);
+    bool streamLocalFile(String fileName = SI_TEMPORARY_GCODE_PATH, uint32_t startOffset = 0, String preamble = "");
     bool isStreamEnded() { return m_streamEnded; };
 
     /**
@@ -229,4 +294,33 @@ public:
     bool isIMUWorking(){return m_isIMUWorking;}
     inline void setPenSensitivity(bool p_status){m_penSensitivity = p_status;}
     inline void setSmartCylinder(bool p_status){m_smartCylinder = p_status;} 
+
+    /**
+     * @brief Get progress of current streamed file
+     * 
+     * @return progress snapshot
+     */
+    SIJobProgress getJobProgress() { return m_jobEstimator.getProgress(); }
+
+    /**
+     * @brief Get last line of current stream after which machine position is known
+     * 
+     * @param syncPoint[out] last sync point
+     * 
+     * @return true if a sync point has been reached
+     */
+    bool getSyncPoint(SISyncPoint &syncPoint) { return m_jobEstimator.getSyncPoint(syncPoint); }
+    SILinkStats &getLinkStats() { return m_linkStats; }
+
+    /**
+     * @brief Steps the link up through SI_LINK_BAUDRATES, stops at the first rate failing the test
+     * 
+     * @return reached baudrate
+     */
+    uint32_t negotiateLinkRate();
+    /**
+     * @brief Restores SAMD_SERIAL_BAUDRATE, to be called when SAMD21 is reset
+     */
+    void resetLinkRate();
+    uint32_t getLinkBaudrate();
 };
@@ -169,6 +169,8 @@ void ScribIt::begin()
         }
         else if (!m_testMode)
         {
+            //Raise link rate as far as it is reliable
+            sm.negotiateLinkRate();
             SIMQTT.boot(SI_ESP_FIRMWARE_VERSION, m_samdVer, m_spiffsVer);
             //Set state to boot
             setState(SI_BOOT);
@@ -261,6 +263,10 @@ void ScribIt::loop()
         //Check for end of streaming
         if (sm.isStreamEnded())
         {
+            //Publish serial link metrics of ended stream
+            if (m_state != SI_MANUAL)
+                SIMQTT.linkMetrics(sm.getLinkStats());
+
             if(hasNexLink())
             {
                 m_target = m_nextTarget;
@@ -268,11 +274,36 @@ void ScribIt::loop()
 
                 downloadAndStart(false);
             }
+            else if (!m_jobQueue.empty())
+            {
+                //Start next queued job, failed ones are dropped
+                bool l_started = false;
+                while (!l_started && !m_jobQueue.empty())
+                    l_started = startQueuedJob();
+
+                //None started, go to idle with nothing left in queue
+                if (!l_started)
+                {
+                    clearJobQueue();
+                    publishQueueStatus();
+                    setState(SI_IDLE);
+                }
+            }
             else
             {
                 setState(SI_IDLE); //Go to idle   
             }
         }
+        else
+        {
+            //Save job position to resume after reboot
+            if (m_state != SI_MANUAL)
+                updateCheckpoint();
+
+            //Prepare next job while current one is running
+            if (m_readyJobs < m_jobQueue.length())
+                prepareQueuedJob();
+        }
     }
     else if (m_state == SI_CALIBRATING)
     {
@@ -311,6 +342,9 @@ void ScribIt::loop()
     //Execute serial manager and get current status
     mkstatus = sm.loop();
 
+    //Eraser pre-heated for a job not yet heating by itself
+    checkPreheat();
+
     //Check Heating/Erasing
     if (m_state == SI_ERASING && mkstatus == SIMK_HEATING)
     {
@@ -363,12 +397,17 @@ void ScribIt::setState(const SI_State newState)
     //Send success if going back IDLE from printing/erasing
     else if (newState == SI_IDLE)
     {
+        //Job ended, nothing to resume
+        if (m_state == SI_PRINTING || m_state == SI_ERASING || m_state == SI_HEATING)
+            clearCheckpoint();
+
         switch (m_state)
         {
         case SI_PRINTING:
             SIMQTT.success("printing");
             break;
         case SI_ERASING:
+        case SI_HEATING:
             SIMQTT.success("erasing");
             break;
         case SI_MANUAL:
@@ -437,7 +476,7 @@ void ScribIt::sendStatus()
         //If not paused add timer time
         if (sm.getPausedState() == SIPS_RUNNING)
             et += (millis() - m_startPrintingT);
-        SIMQTT.statusPrintErase(et / 1000, (m_state == SI_ERASING || m_state == SI_HEATING), SIPS_TO_PKT(sm.getPausedState()));
+        SIMQTT.statusPrintErase(et / 1000, (m_state == SI_ERASING || m_state == SI_HEATING), SIPS_TO_PKT(sm.getPausedState()), sm.getJobProgress(), m_jobQueue.length(), m_readyJobs);
     }
     else if (m_state == SI_IDLE)
         SIMQTT.statusIdle(WiFi.RSSI(), sm.getTemperature());
@@ -520,6 +559,8 @@ void ScribIt::resetSamd()
     digitalWrite(COMPANION_RESET, HIGH);
     //Deinit Pin
     pinMode(COMPANION_RESET, INPUT);
+    //SAMD restarts at default rate
+    sm.resetLinkRate();
 }
 
 void ScribIt::setStepperStepPin()
@@ -629,6 +670,12 @@ bool ScribIt::parseAndSaveGcodeString(char *gcode)
 
 bool ScribIt::downloadAndStart(bool p_showDownloadLeds)
 {
+    //Downloader is needed for this job
+    stopPreparingJob();
+
+    //Temporary gcode is going to be replaced
+    clearCheckpoint();
+
     //Send download start message
     SIMQTT.publish("download", String("{\"Status\":\"Start\"}"));
 
@@ -651,8 +698,15 @@ bool ScribIt::downloadAndStart(bool p_showDownloadLeds)
 #ifdef SI_DEBUG_BUILD
     uint32_t downloadStartT = millis();
 #endif
+    //Erase jobs start heating as soon as header is downloaded
+    std::function<void(const uint8_t *, uint16_t)> l_onHeader = nullptr;
+    if (m_isErase)
+        l_onHeader = [this](const uint8_t *data, uint16_t len) { preheatFromHeader(data, len); };
+
     //Download file
-    bool status = downloader.download(m_target, false);
+    bool status = downloader.download(m_target, false, SI_TEMPORARY_GCODE_PATH, [this]() { serviceStream(); }, l_onHeader);
+    if (!status)
+        cancelPreheat();
 #ifdef SI_DEBUG_BUILD
     SIMQTT.debug(TAG, String("Download took ") + ((millis() - downloadStartT) / 1000) + " sec");
 #endif
@@ -832,3 +886,427 @@ bool ScribIt::hasNexLink()
 
     return l_retVal;
 }
+
+bool ScribIt::queueJob(SIJob job)
+{
+    if (m_jobQueue.full())
+        return false;
+
+    //Queued jobs use consecutive slots, so files of jobs in queue never overlap
+    job.slot = m_nextJobSlot;
+    m_nextJobSlot = (m_nextJobSlot + 1) % SI_JOB_QUEUE_LEN;
+    m_jobQueue.add(job);
+
+    SIMQTT.debug(TAG, String("Queued ") + (job.isErase ? "erase" : "print") + " job: " + job.target);
+    publishQueueStatus();
+
+    return true;
+}
+
+void ScribIt::prepareQueuedJob()
+{
+    SIJob l_job;
+    char l_path[32];
+
+    //Skip if nothing to prepare
+    if (!m_jobQueue.peek(&l_job, m_readyJobs))
+        return;
+
+    sprintf(l_path, SI_JOB_QUEUE_PATH_FORMAT, l_job.slot);
+
+    //Start download, next loops go on with it
+    SIDownloadStatus l_status = SI_DOWNLOAD_FAILED;
+    if (!m_isPreparingJob)
+    {
+        if (downloader.startDownload(l_job.target, false, l_path))
+        {
+            m_isPreparingJob = true;
+            return;
+        }
+    }
+    else
+    {
+        l_status = downloader.downloadStep();
+        if (l_status == SI_DOWNLOAD_RUNNING)
+            return;
+        m_isPreparingJob = false;
+    }
+
+    if (l_status == SI_DOWNLOAD_DONE)
+    {
+        m_readyJobs++;
+    }
+    else
+    {
+        //Drop failed job, keeping order of following ones
+        SIMQTT.error(String("Unable to prepare queued job: ") + l_job.target, SIMQTT_ERROR_CANNOT_PRINT);
+        SPIFFS.remove(l_path);
+
+        uint8_t l_len = m_jobQueue.length();
+        for (uint8_t i = 0; i < l_len; i++)
+        {
+            SIJob l_tmp;
+            m_jobQueue.remove(&l_tmp);
+            if (i != m_readyJobs)
+                m_jobQueue.add(l_tmp);
+        }
+    }
+
+    publishQueueStatus();
+}
+
+bool ScribIt::startQueuedJob()
+{
+    SIJob l_job;
+    char l_path[32];
+    SI_State l_prevState = m_state;
+
+    if (!m_jobQueue.remove(&l_job))
+        return false;
+
+    bool l_isReady = m_readyJobs > 0;
+    if (l_isReady)
+        m_readyJobs--;
+
+    m_target = l_job.target;
+    m_sendOnStop = l_job.sendOnStop;
+    m_isErase = l_job.isErase;
+
+    bool l_started = false;
+    if (l_isReady)
+    {
+        //Move prepared file in place of temporary gcode
+        clearCheckpoint();
+        sprintf(l_path, SI_JOB_QUEUE_PATH_FORMAT, l_job.slot);
+        SPIFFS.remove(SI_TEMPORARY_GCODE_PATH);
+        if (!SPIFFS.rename(l_path, SI_TEMPORARY_GCODE_PATH))
+        {
+            SIMQTT.error(String("Unable to move queued job file ") + l_path, SIMQTT_ERROR_DOWNLOAD_FILE_IO_ERROR);
+            SPIFFS.remove(l_path);
+        }
+        else if (sm.streamLocalFile())
+        {
+            setState(m_isErase ? SI_ERASING : SI_PRINTING);
+            l_started = true;
+        }
+    }
+    else
+    {
+        l_started = downloadAndStart(false);
+    }
+
+    publishQueueStatus();
+
+    if (!l_started)
+        return false;
+
+    //Previous job ended: signal it and restart printing timer
+    SIMQTT.success((l_prevState == SI_ERASING || l_prevState == SI_HEATING) ? "erasing" : "printing");
+    m_startPrintingT = millis();
+    m_printingTime = 0;
+
+    return true;
+}
+
+void ScribIt::stopPreparingJob()
+{
+    if (!m_isPreparingJob)
+        return;
+
+    downloader.abortDownload();
+    m_isPreparingJob = false;
+}
+
+void ScribIt::clearJobQueue()
+{
+    SIJob l_job;
+    char l_path[32];
+
+    stopPreparingJob();
+    while (m_jobQueue.remove(&l_job))
+    {
+        sprintf(l_path, SI_JOB_QUEUE_PATH_FORMAT, l_job.slot);
+        SPIFFS.remove(l_path);
+    }
+    m_readyJobs = 0;
+}
+
+void ScribIt::serviceStream()
+{
+    SIMQTT.loop();
+    sm.loop();
+    checkPreheat();
+}
+
+void ScribIt::publishQueueStatus()
+{
+    SIMQTT.publish("queue", String("{\"Len\":") + m_jobQueue.length() + ", \"Ready\":" + m_readyJobs + "}");
+}
+
+void ScribIt::preheatFromHeader(const uint8_t *data, uint16_t len)
+{
+    char l_line[SI_MAX_GCODE_LINE_LEN];
+    uint16_t l_start = 0;
+    uint32_t l_lines = 0;
+
+    for (uint16_t i = 0; i <= len; i++)
+    {
+        //Evaluate each complete line (Last one may be truncated)
+        if (i == len || data[i] != '\n')
+            continue;
+
+        uint16_t l_lineLen = min((uint16_t)(i - l_start), (uint16_t)(SI_MAX_GCODE_LINE_LEN - 1));
+        memcpy(l_line, &data[l_start], l_lineLen);
+        if (l_lineLen > 0 && l_line[l_lineLen - 1] == 0x0D)
+            l_lineLen--;
+        l_line[l_lineLen] = 0;
+        l_start = i + 1;
+
+        //Count lines as streamed (Comments and blank lines are skipped)
+        if (l_line[0] == ';' || l_line[0] == 0)
+            continue;
+        l_lines++;
+
+        //Skip indentation and line number (N12 M109 S200)
+        const char *l_code = l_line;
+        while (*l_code == ' ' || *l_code == '\t')
+            l_code++;
+        if (*l_code == 'N')
+        {
+            do
+                l_code++;
+            while (isdigit(*l_code));
+            while (*l_code == ' ' || *l_code == '\t')
+                l_code++;
+        }
+
+        //First motion ends header
+        if ((strncmp(l_code, "G0", 2) == 0 || strncmp(l_code, "G1", 2) == 0) && !isdigit(l_code[2]))
+            return;
+        if ((strncmp(l_code, "M104", 4) != 0 && strncmp(l_code, "M109", 4) != 0) || isdigit(l_code[4]))
+            continue;
+
+        const char *l_s = strchr(l_code, 'S');
+        if (l_s == nullptr)
+            continue;
+        int16_t l_temp = atoi(l_s + 1);
+        if (l_temp <= 0)
+            continue;
+
+        //Set temperature without waiting, job M109 will wait for it
+        SIMQTT.debug(TAG, String("Pre-heating eraser to ") + l_temp);
+        sm.addLineToStream((String("M104 S") + l_temp).c_str());
+        m_preheatT = millis();
+        m_preheatLine = l_lines;
+        return;
+    }
+}
+
+void ScribIt::checkPreheat()
+{
+    //Job GCODE takes over heater control once its temperature line is acknowledged (Or its M109 is waiting)
+    if (m_preheatT != 0 && (m_state == SI_HEATING || (m_state == SI_ERASING && sm.getJobProgress().ackedLines >= m_preheatLine)))
+        m_preheatT = 0;
+
+    //Safety timeout if job does not get there
+    if (m_preheatT != 0 && millis() - m_preheatT > SI_PREHEAT_TIMEOUT_MS)
+    {
+        SIMQTT.debug(TAG, "Pre-heat timeout, turning eraser off");
+        cancelPreheat();
+    }
+}
+
+void ScribIt::cancelPreheat()
+{
+    if (m_preheatT == 0)
+        return;
+
+    sm.addLineToStream("M104 S0");
+    m_preheatT = 0;
+}
+
+void ScribIt::updateCheckpoint()
+{
+    SICheckpoint l_checkpoint;
+
+    //Bound flash write rate
+    if (millis() - m_lastCheckpointT < SI_CHECKPOINT_INTERVAL_MS)
+        return;
+    //Only if a new known position has been reached
+    if (!sm.getSyncPoint(l_checkpoint.syncPoint) || l_checkpoint.syncPoint.sequence == m_lastCheckpointSeq)
+        return;
+
+    l_checkpoint.magic = SI_CHECKPOINT_MAGIC;
+    l_checkpoint.isErase = m_isErase;
+    strncpy(l_checkpoint.target, m_target.c_str(), SI_CHECKPOINT_TARGET_LEN - 1);
+    l_checkpoint.target[SI_CHECKPOINT_TARGET_LEN - 1] = 0;
+    strncpy(l_checkpoint.sendOnStop, m_sendOnStop.c_str(), SI_CHECKPOINT_TARGET_LEN - 1);
+    l_checkpoint.sendOnStop[SI_CHECKPOINT_TARGET_LEN - 1] = 0;
+
+    File l_file = SPIFFS.open(SI_CHECKPOINT_PATH, FILE_WRITE);
+    if (!l_file)
+    {
+        SIMQTT.debug(TAG, "Unable to write checkpoint");
+        return;
+    }
+    l_file.write((const uint8_t *)&l_checkpoint, sizeof(l_checkpoint));
+    l_file.close();
+
+    m_lastCheckpointT = millis();
+    m_lastCheckpointSeq = l_checkpoint.syncPoint.sequence;
+}
+
+void ScribIt::clearCheckpoint()
+{
+    if (SPIFFS.exists(SI_CHECKPOINT_PATH))
+        SPIFFS.remove(SI_CHECKPOINT_PATH);
+    m_lastCheckpointSeq = 0;
+}
+
+bool ScribIt::loadCheckpoint(SICheckpoint &checkpoint)
+{
+    if (!SPIFFS.exists(SI_CHECKPOINT_PATH))
+        return false;
+
+    File l_file = SPIFFS.open(SI_CHECKPOINT_PATH, FILE_READ);
+    if (!l_file)
+        return false;
+    size_t l_len = l_file.read((uint8_t *)&checkpoint, sizeof(checkpoint));
+    l_file.close();
+
+    if (l_len != sizeof(checkpoint) || checkpoint.magic != SI_CHECKPOINT_MAGIC)
+    {
+        SIMQTT.debug(TAG, "Invalid checkpoint, discarding");
+        clearCheckpoint();
+        return false;
+    }
+
+    //Check gcode is still the one of checkpoint
+    File l_gcode = SPIFFS.open(SI_TEMPORARY_GCODE_PATH, FILE_READ);
+    bool l_valid = l_gcode && l_gcode.size() == checkpoint.syncPoint.fileSize;
+    if (l_gcode)
+        l_gcode.close();
+    if (!l_valid)
+    {
+        SIMQTT.debug(TAG, "Checkpoint gcode missing or changed, discarding");
+        clearCheckpoint();
+    }
+
+    return l_valid;
+}
+
+void ScribIt::offerResume()
+{
+    SICheckpoint l_checkpoint;
+    if (!loadCheckpoint(l_checkpoint))
+        return;
+
+    if (SI_CHECKPOINT_AUTO_RESUME)
+    {
+        if (!resumeFromCheckpoint())
+            SIMQTT.error("Unable to resume interrupted job", SIMQTT_ERROR_CANNOT_PRINT);
+        return;
+    }
+
+    //Let server decide
+    uint8_t l_progress = (uint64_t)l_checkpoint.syncPoint.fileOffset * 100 / l_checkpoint.syncPoint.fileSize;
+    SIMQTT.publish("resume", String("{\"Target\":\"") + l_checkpoint.target + "\", \"Erase\":" + (l_checkpoint.isErase ? 1 : 0) +
+                                 ", \"Lines\":" + l_checkpoint.syncPoint.lines + ", \"Progress\":" + l_progress + "}");
+}
+
+bool ScribIt::resumeFromCheckpoint()
+{
+    //Header lines that set machine state
+    static const char *l_settingCodes[] = {"M17", "M92", "M201", "M203", "M204", "M205", "G90", "G91"};
+    SICheckpoint l_checkpoint;
+    char l_buffer[SI_MAX_GCODE_LINE_LEN];
+    String l_preamble;
+    String l_temperature; //Last M104/M109, each M109 sent again would wait
+    float l_feedrate = 0; //Last F of a motion line, 0 if none
+
+    if (!loadCheckpoint(l_checkpoint))
+        return false;
+
+    //Collect settings sent before checkpoint---------------------------
+    File l_file = SPIFFS.open(SI_TEMPORARY_GCODE_PATH, FILE_READ);
+    if (!l_file)
+        return false;
+    while (l_file.available() && l_file.position() < l_checkpoint.syncPoint.fileOffset)
+    {
+        uint16_t l_len = l_file.readBytesUntil('\n', l_buffer, SI_MAX_GCODE_LINE_LEN - 1);
+        if (l_len > 0 && l_buffer[l_len - 1] == 0x0D)
+            l_len--;
+        l_buffer[l_len] = 0;
+
+        //Modal feedrate is set by G0-G3 lines
+        if (l_buffer[0] == 'G' && l_buffer[1] >= '0' && l_buffer[1] <= '3' && !isdigit(l_buffer[2]))
+        {
+            char *l_comment = strchr(l_buffer, ';');
+            if (l_comment != nullptr)
+                *l_comment = 0;
+            char *l_f = strchr(l_buffer, 'F');
+            if (l_f != nullptr)
+            {
+                const float l_value = atof(l_f + 1);
+                if (l_value > 0)
+                    l_feedrate = l_value;
+            }
+            continue;
+        }
+
+        if ((strncmp(l_buffer, "M104", 4) == 0 || strncmp(l_buffer, "M109", 4) == 0) && !isdigit(l_buffer[4]))
+        {
+            l_temperature = String(l_buffer) + "\n";
+            continue;
+        }
+
+        for (uint8_t i = 0; i < sizeof(l_settingCodes) / sizeof(l_settingCodes[0]); i++)
+        {
+            uint8_t l_codeLen = strlen(l_settingCodes[i]);
+            if (strncmp(l_buffer, l_settingCodes[i], l_codeLen) == 0 && !isdigit(l_buffer[l_codeLen]))
+            {
+                l_preamble += String(l_buffer) + "\n";
+                break;
+            }
+        }
+    }
+    l_file.close();
+    l_preamble += l_temperature;
+
+    //Restore position---------------------------------------------------
+    const float *l_position = l_checkpoint.syncPoint.position;
+    if (l_checkpoint.syncPoint.homedCarousel)
+    {
+        //Carousel may have moved: home it and go back to saved pen position (G0 avoids pen sensitivity substitution)
+        sprintf(l_buffer, "G92 X%.4f Y%.4f Z0\nG77\nG0 Z%.4f", l_position[0], l_position[1], l_position[2]);
+    }
+    else
+    {
+        //Job assumed carousel in place since start
+        sprintf(l_buffer, "G92 X%.4f Y%.4f Z%.4f", l_position[0], l_position[1], l_position[2]);
+    }
+    l_preamble += l_buffer;
+
+    //Restore modal feedrate for next file moves
+    if (l_feedrate > 0)
+    {
+        sprintf(l_buffer, "\nG0 F%.2f", l_feedrate);
+        l_preamble += l_buffer;
+    }
+
+    //Restart stream------------------------------------------------------
+    m_target = String(l_checkpoint.target);
+    m_sendOnStop = String(l_checkpoint.sendOnStop);
+    m_isErase = l_checkpoint.isErase;
+
+    if (!sm.streamLocalFile(SI_TEMPORARY_GCODE_PATH, l_checkpoint.syncPoint.fileOffset, l_preamble))
+        return false;
+
+    SIMQTT.debug(TAG, String("Resuming job from line ") + l_checkpoint.syncPoint.lines);
+    m_startPrintingT = millis();
+    m_printingTime = 0;
+    m_lastCheckpointT = millis();
+    setState(m_isErase ? SI_ERASING : SI_PRINTING);
+
+    return true;
+}
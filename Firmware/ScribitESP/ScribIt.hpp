@@ -3,11 +3,36 @@
 #include "SISerialManager.hpp"
 #include "SIFileDownloader.hpp"
 #include "ScribitVersion.hpp"
+#include "AxxxLib/CircBuf.h"
 #include "AxxxLib/CircBufInfinite.h"
 #include "ArduinoJson.h"
 
 #define SI_CALIBRATION_GCODE_FILE "/calib.gcode"
 #define CALIBRATION_ATTEMPTS_LIMIT 2
+#define SI_CHECKPOINT_MAGIC 0x53434B01 //Changes if SICheckpoint layout changes
+
+/**
+ * @brief Print/erase job waiting in queue
+ */
+struct SIJob
+{
+  String target;     //Download target
+  String sendOnStop; //GCODE to be sent in case of job stopped
+  bool isErase;      //True if is erase false if is printing
+  uint8_t slot;      //Index of SPIFFS file where job is prepared
+};
+
+/**
+ * @brief Job state saved in flash to resume after a reboot
+ */
+struct SICheckpoint
+{
+  uint32_t magic;                                  //SI_CHECKPOINT_MAGIC if valid
+  SISyncPoint syncPoint;                           //Last line with known machine position
+  bool isErase;                                    //True if is erase false if is printing
+  char target[SI_CHECKPOINT_TARGET_LEN];           //Download target (Needed for splitted gcode)
+  char sendOnStop[SI_CHECKPOINT_TARGET_LEN];       //GCODE to be sent in case of print stopped
+};
 
 enum SI_State
 {
@@ -43,6 +68,20 @@ class ScribIt
   String m_sendOnStop; //GCODE to be sent in case of print stopped
   uint8_t m_wallID; //Wall ID (1-9)
 
+  //Job queue
+  CircBuf<SIJob> m_jobQueue; //Jobs accepted while printing/erasing
+  uint8_t m_readyJobs;       //Number of jobs at queue head already downloaded and verified
+  uint8_t m_nextJobSlot;     //File slot for next queued job
+  bool m_isPreparingJob;     //True while a queued job is being downloaded
+
+  //Eraser pre-heat
+  uint32_t m_preheatT;    //Time eraser pre-heat was requested, 0 if not pre-heating
+  uint32_t m_preheatLine; //Job line (Comments excluded) setting eraser temperature
+
+  //Checkpoint
+  uint32_t m_lastCheckpointT;   //Time last checkpoint was written
+  uint32_t m_lastCheckpointSeq; //Sync point sequence of last checkpoint
+
   //Firmware versions
   uint16_t m_samdVer;
   uint16_t m_spiffsVer;
@@ -135,11 +174,13 @@ class ScribIt
    * @brief Parse Print and Erase target
    * 
    * @param payload[in] string payload
+   * @param target[out] download target
+   * @param sendOnStop[out] GCODE to be sent in case of print stopped
    * 
    * @return true target parsed
    * @return false target parse error
    */
-  bool parsePETarget(char *payload);
+  bool parsePETarget(char *payload, String &target, String &sendOnStop);
 
   /**
    * @brief It parses payload coming from mqtt calibration topic to store data used for calibration
@@ -206,9 +247,107 @@ class ScribIt
    */
   bool hasNexLink();
 
+  /**
+   * @brief Adds a print/erase job to queue, to be started when current job ends
+   * 
+   * @param job[in] the job
+   * 
+   * @return true job queued, false if queue is full
+   */
+  bool queueJob(SIJob job);
+
+  /**
+   * @brief Downloads first queued job not yet prepared a chunk at a time, call it from the main loop
+   *
+   * The job is ready once downloaded and verified
+   */
+  void prepareQueuedJob();
+
+  /**
+   * @brief Drops download of queued job in progress, job is prepared again later
+   */
+  void stopPreparingJob();
+
+  /**
+   * @brief Starts first queued job, downloading it if not already prepared
+   * 
+   * @return true job started, false if queue empty or job failed (Failed job is removed from queue)
+   */
+  bool startQueuedJob();
+
+  /**
+   * @brief Removes all queued jobs
+   */
+  void clearJobQueue();
+
+  /**
+   * @brief Keeps serial stream and MQTT alive during blocking operations
+   */
+  void serviceStream();
+
+  /**
+   * @brief Publishes queue state on queue topic
+   */
+  void publishQueueStatus();
+
+  /**
+   * @brief Looks for eraser temperature (M104/M109, also indented or numbered) in job header and starts heating
+   * before download ends
+   * 
+   * @param data[in] first chunk of job file
+   * @param len[in] chunk length
+   */
+  void preheatFromHeader(const uint8_t *data, uint16_t len);
+
+  /**
+   * @brief Turns eraser off if pre-heated for a job that did not start
+   */
+  void cancelPreheat();
+
+  /**
+   * @brief Ends pre-heat once job reaches its own temperature line, turns eraser off if it does not within SI_PREHEAT_TIMEOUT_MS
+   *
+   * Called by main loop and by serviceStream() during blocking downloads
+   */
+  void checkPreheat();
+
+  /**
+   * @brief Saves last sync point of current job in flash, at most once every SI_CHECKPOINT_INTERVAL_MS
+   */
+  void updateCheckpoint();
+
+  /**
+   * @brief Deletes saved checkpoint
+   */
+  void clearCheckpoint();
+
+  /**
+   * @brief Reads saved checkpoint
+   * 
+   * @param checkpoint[out] saved checkpoint
+   * 
+   * @return true if a valid checkpoint for the temporary gcode file is present
+   */
+  bool loadCheckpoint(SICheckpoint &checkpoint);
+
+  /**
+   * @brief At boot offers resume of interrupted job, or resumes it if SI_CHECKPOINT_AUTO_RESUME
+   */
+  void offerResume();
+
+  /**
+   * @brief Restarts interrupted job from saved checkpoint
+   * 
+   * Settings in job header are sent again (Only the last M104/M109), L/R position is restored, carousel is homed and
+   * moved back to saved position, then the last feedrate of the job moves is set again
+   * 
+   * @return true job resumed, false if no valid checkpoint or stream error
+   */
+  bool resumeFromCheckpoint();
+
 public:
   RGBLEDs leds; //RGBLed
-  ScribIt() : m_imuData(SI_CALIBRATION_POINT_NUMBER)
+  ScribIt() : m_imuData(SI_CALIBRATION_POINT_NUMBER), m_jobQueue(SI_JOB_QUEUE_LEN)
   {
     m_state = SI_RESET;
     m_samdVer = 0;
@@ -217,6 +356,13 @@ public:
     m_isErase = false;
     m_printingTime = 0;
     m_wallID=0;
+    m_readyJobs = 0;
+    m_nextJobSlot = 0;
+    m_isPreparingJob = false;
+    m_preheatT = 0;
+    m_preheatLine = 0;
+    m_lastCheckpointT = 0;
+    m_lastCheckpointSeq = 0;
   };
 
   /**
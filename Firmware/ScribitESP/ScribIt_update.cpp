@@ -151,6 +151,9 @@ bool ScribIt::updateFW(int device, String target)
     // check contentLength and content type
     if (contentLength && isValidContentType)
     {
+        //Companion is flashed over the SAMD serial link, back to default rate
+        if (device == U_COMPANION)
+            sm.resetLinkRate();
         // Check if there is enough to OTA Update
         bool canBegin = Update.begin(contentLength, device);
 
@@ -15,15 +15,30 @@ void ScribIt::evaluateMQTTIn()
     //Print/Erase===============================================================================================
     case SIMQTTMessage::PRINT:
     case SIMQTTMessage::ERASE:
+        //If running a job add to queue
+        if (m_state == SI_PRINTING || m_state == SI_ERASING || m_state == SI_HEATING)
+        {
+            SIJob l_job;
+            //Parse print parameters
+            if (!parsePETarget(msg.payload, l_job.target, l_job.sendOnStop))
+            {
+                SIMQTT.error(String("Unable to parse print target: ") + msg.payload, SIMQTT_ERROR_MQTT);
+                return;
+            }
+            l_job.isErase = (msg.type == SIMQTTMessage::ERASE);
+
+            if (!queueJob(l_job))
+                SIMQTT.error("Unable to queue job, queue full", SIMQTT_ERROR_QUEUE_FULL);
+        }
         //If not idle send error
-        if (m_state != SI_IDLE)
+        else if (m_state != SI_IDLE)
         {
             SIMQTT.error(String("Unable to print, printer in status: ") + m_state, SIMQTT_ERROR_CANNOT_PRINT);
         }
         else
         {
             //Parse print parameters
-            if (!parsePETarget(msg.payload))
+            if (!parsePETarget(msg.payload, m_target, m_sendOnStop))
             {
                 SIMQTT.error(String("Unable to parse print target: ") + msg.payload, SIMQTT_ERROR_MQTT);
                 return;
@@ -42,6 +57,8 @@ void ScribIt::evaluateMQTTIn()
         { 
             setState(SI_IDLE);
             setSmartConfig(msg.payload);
+            //Check for job interrupted by reboot
+            offerResume();
         }
         else
             sendStatus();
@@ -96,10 +113,13 @@ void ScribIt::evaluateMQTTIn()
             //Just stop stream
             sm.stopStream();
             m_target = "";
+            //Stop discards also queued jobs
+            clearJobQueue();
 
             if(m_isErase)
             {
                 sm.addLineToStream("M104 S0");
+                m_preheatT = 0;
             }
 
             //Send stop string if present
@@ -263,6 +283,24 @@ void ScribIt::evaluateMQTTIn()
         }
 
         break;
+        //==================================================================================================
+        //Resume interrupted job ==========================================================================
+    case SIMQTTMessage::RESUME:
+        if (m_state != SI_IDLE)
+        {
+            SIMQTT.error("Cannot resume when not IDLE", SIMQTT_ERROR_STATUS_INCORRECT);
+        }
+        else if (msg.payload[0] == 'Y')
+        {
+            if (!resumeFromCheckpoint())
+                SIMQTT.error("No interrupted job to resume", SIMQTT_ERROR_CANNOT_PRINT);
+        }
+        else
+        {
+            //Discard interrupted job
+            clearCheckpoint();
+        }
+        break;
     default:
         SIMQTT.error("Unimplemented MQTT message", SIMQTT_ERROR_MQTT);
         break;
@@ -326,7 +364,7 @@ bool ScribIt::setSmartConfig(const char *p_payload)
     return l_retVal;
 }
 
-bool ScribIt::parsePETarget(char *payload)
+bool ScribIt::parsePETarget(char *payload, String &target, String &sendOnStop)
 {
     uint8_t wallID;
     char *p = strtok(payload, ";"), *eon;
@@ -337,7 +375,7 @@ bool ScribIt::parsePETarget(char *payload)
         return false;
     }
 
-    m_target = String(p);
+    target = String(p);
     
     //Send on stop command--------------------
     p = strtok(NULL, ";");
@@ -346,7 +384,7 @@ bool ScribIt::parsePETarget(char *payload)
          return false; //No parameter
     }   
 
-    m_sendOnStop = String(p);
+    sendOnStop = String(p);
 
     return true;
 }
@@ -0,0 +1,145 @@
+/**
+ * trapezoid_check.cpp
+ *
+ * Runs random blocks through the float and the FIXED_POINT_PLANNER
+ * calculate_trapezoid_for_block() of MK4duo and reports how far the
+ * integer trapezoid is from the float one.
+ *
+ * Both functions are compiled from planner.cpp as they are (see Makefile),
+ * with the SAMD21 timer rate and COMPACT_BLOCK_BUFFER, as the Scribit build.
+ * The rest of the planner is replaced by the few definitions below.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+
+#define ENABLED defined
+#define DISABLED !defined
+#define FORCE_INLINE inline
+#define COMPACT_BLOCK_BUFFER
+#define F_CPU                 48000000
+#define HAL_TIMER_RATE        ((F_CPU)/2) // HAL_SAMD/HAL_timers.h
+#define HAL_ACCELERATION_RATE (4096.0 * 4096.0 * 128.0 / (HAL_TIMER_RATE))
+#define MINIMAL_STEP_RATE     120         // planner.cpp
+#define SPEED_SQR_BITS        8           // planner.h
+#define sq(x)                 ((x)*(x))
+#define NOLESS(v,n)           do{ if ((v) < (n)) (v) = (n); }while(0)
+#define NOMORE(v,n)           do{ if ((v) > (n)) (v) = (n); }while(0)
+#define MIN(a,b)              ((a)<(b)?(a):(b))
+#define MAX(a,b)              ((a)>(b)?(a):(b))
+#define CEIL(x)               ceilf(x)
+#define FLOOR(x)              floorf(x)
+#define LROUND(x)             lroundf(x)
+
+// Trapezoid fields of the COMPACT_BLOCK_BUFFER block_t
+struct block_t {
+  uint16_t step_event_count, nominal_rate, final_rate, accelerate_until, decelerate_after, initial_rate;
+  uint32_t acceleration_rate, rate_sqr_factor;
+};
+
+namespace fixed_planner {
+
+  typedef uint32_t speed_sqr_t;
+
+  struct Planner {
+    static void calculate_trapezoid_for_block(block_t* const block, const speed_sqr_t entry_speed_sqr, const speed_sqr_t exit_speed_sqr);
+  };
+
+  // Planner::to_speed_sqr()
+  static speed_sqr_t to_speed_sqr(const float v_sqr) {
+    return v_sqr < float(0x7FFFFFFFUL >> (SPEED_SQR_BITS)) ? speed_sqr_t(v_sqr * float(1UL << (SPEED_SQR_BITS)) + 0.5f) : 0x7FFFFFFFUL;
+  }
+
+  #define FIXED_POINT_PLANNER
+  #include "trapezoid.inc"
+  #undef FIXED_POINT_PLANNER
+
+}
+
+namespace float_planner {
+
+  struct Planner {
+    static void calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor);
+
+    // planner.h
+    static float estimate_acceleration_distance(const float &initial_rate, const float &target_rate, const float &accel) {
+      if (accel == 0) return 0;
+      return (sq(target_rate) - sq(initial_rate)) / (accel * 2.0);
+    }
+    static float intersection_distance(const float &initial_rate, const float &final_rate, const float &accel, const float &distance) {
+      if (accel == 0) return 0;
+      return (accel * 2 * distance - sq(initial_rate) + sq(final_rate)) / (accel * 4.0);
+    }
+  };
+
+  #include "trapezoid.inc"
+
+}
+
+int main() {
+
+  long blocks = 0, rate_diff_max = 0, until_diff_max = 0, after_diff_max = 0, over_one_step = 0;
+  double rate_rel_max = 0;
+
+  srand(1);
+  for (long it = 0; it < 2000000; it++) {
+
+    // Random block, kept in the COMPACT_BLOCK_BUFFER 16 bit ranges
+    const float steps_per_mm = 1 + rand() % 4000 / 10.0f,
+                mm = 0.01f + rand() % 100000 / 100.0f;
+    if (mm * steps_per_mm > 65535 || mm * steps_per_mm < 1) continue;
+    const uint16_t step_event_count = uint16_t(mm * steps_per_mm + 0.5f);
+    const float speed = 1 + rand() % 3000 / 10.0f;
+    if (speed * step_event_count / mm > 65534) continue;
+
+    // As fill_block()
+    const float inverse_secs = speed / mm,
+                nominal_speed_sqr = sq(mm * inverse_secs);
+    const uint32_t nominal_rate = CEIL(step_event_count * inverse_secs);
+    if (nominal_rate < MINIMAL_STEP_RATE) continue;
+    const float acceleration = 50 + rand() % 5000;
+    const uint32_t accel = CEIL(acceleration * step_event_count / mm);
+
+    block_t flt = {}, fix = {};
+    flt.step_event_count = fix.step_event_count = step_event_count;
+    flt.nominal_rate = fix.nominal_rate = nominal_rate;
+    flt.acceleration_rate = fix.acceleration_rate = uint32_t(accel * (HAL_ACCELERATION_RATE));
+    float rate_sqr_factor = sq(float(nominal_rate)) / nominal_speed_sqr * float(1UL << (SPEED_SQR_BITS));
+    NOMORE(rate_sqr_factor, float(0xFFFFFF00UL));
+    fix.rate_sqr_factor = rate_sqr_factor;
+
+    // Random entry and exit speeds, passed as recalculate_trapezoids() does
+    const float entry_speed = speed * (rand() % 1001) / 1000.0f,
+                exit_speed = speed * (rand() % 1001) / 1000.0f,
+                nomr = 1.0f / sqrtf(nominal_speed_sqr);
+    float_planner::Planner::calculate_trapezoid_for_block(&flt, sqrtf(sq(entry_speed)) * nomr, sqrtf(sq(exit_speed)) * nomr);
+    fixed_planner::Planner::calculate_trapezoid_for_block(&fix, fixed_planner::to_speed_sqr(sq(entry_speed)), fixed_planner::to_speed_sqr(sq(exit_speed)));
+
+    if (fix.accelerate_until > fix.decelerate_after || fix.decelerate_after > step_event_count) {
+      printf("Bad fixed point trapezoid: count %u accelerate_until %u decelerate_after %u\n", step_event_count, fix.accelerate_until, fix.decelerate_after);
+      return 1;
+    }
+
+    const long initial_diff = labs(long(flt.initial_rate) - fix.initial_rate),
+               final_diff = labs(long(flt.final_rate) - fix.final_rate),
+               until_diff = labs(long(flt.accelerate_until) - fix.accelerate_until),
+               after_diff = labs(long(flt.decelerate_after) - fix.decelerate_after);
+
+    rate_diff_max = std::max(rate_diff_max, std::max(initial_diff, final_diff));
+    rate_rel_max = std::max(rate_rel_max, std::max(initial_diff / double(flt.initial_rate), final_diff / double(flt.final_rate)));
+    until_diff_max = std::max(until_diff_max, until_diff);
+    after_diff_max = std::max(after_diff_max, after_diff);
+    if (until_diff > 1 || after_diff > 1) over_one_step++;
+    blocks++;
+  }
+
+  printf("Blocks: %ld\n", blocks);
+  printf("Max step rate difference: %ld steps/s (relative %.5f)\n", rate_diff_max, rate_rel_max);
+  printf("Max accelerate_until difference: %ld steps, decelerate_after: %ld steps\n", until_diff_max, after_diff_max);
+  printf("Blocks more than 1 step apart: %ld\n", over_one_step);
+
+  return 0;
+}